@@ -0,0 +1,89 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+    // buffer sizes in bytes: half of L1d, half of L2, half of the last level cache and twice the last level cache,
+    // read from the machine running the benchmarks
+    inline const std::vector<std::int64_t>& cache_sizes()
+    {
+        static const std::vector<std::int64_t> sizes = [] {
+            std::int64_t l1 = 32 << 10, l2 = 1 << 20, llc = 32 << 20;
+            int llc_level = 0;
+            for (const auto& cache : benchmark::CPUInfo::Get().caches) {
+                if (cache.type == "Instruction") {
+                    continue;
+                }
+                if (cache.level == 1) {
+                    l1 = cache.size;
+                }
+                else if (cache.level == 2) {
+                    l2 = cache.size;
+                }
+                if (cache.level >= llc_level) {
+                    llc_level = cache.level;
+                    llc = cache.size;
+                }
+            }
+            return std::vector<std::int64_t>{ l1 / 2, l2 / 2, llc / 2, llc * 2 };
+        }();
+        return sizes;
+    }
+
+    // one argument per cache size: the number of T fitting in it
+    template<typename T>
+    void element_counts(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : cache_sizes()) {
+            b->Arg(std::max<std::int64_t>(bytes / static_cast<std::int64_t>(sizeof(T)), 1));
+        }
+    }
+
+    // 1, 2, 4, ... up to the number of hardware threads (always including it)
+    inline void thread_counts(benchmark::internal::Benchmark* b)
+    {
+        const std::int64_t hardware = std::max<std::int64_t>(std::thread::hardware_concurrency(), 1);
+        for (std::int64_t threads = 1; threads < hardware; threads *= 2) {
+            b->Arg(threads);
+        }
+        b->Arg(hardware);
+    }
+
+    // runs f(0), ..., f(n - 1) on n threads and waits for all of them
+    template<typename F>
+    void run_threads(size_t n, F&& f)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            threads.emplace_back([&f, i] { f(i); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // a trivially copyable element filling a cache line
+    struct Line
+    {
+        std::uint64_t value;
+        std::uint64_t padding[7];
+    };
+
+    template<typename T>
+    constexpr std::int64_t bytes(std::int64_t n) { return n * static_cast<std::int64_t>(sizeof(T)); }
+}
+
+// registers f<T> for the element types measured everywhere, one run per cache size
+#define CONTAINERS2_BENCHMARK_ELEMENTS(f)                                                   \
+    BENCHMARK_TEMPLATE(f, std::uint8_t)->Apply(bench::element_counts<std::uint8_t>);       \
+    BENCHMARK_TEMPLATE(f, std::int32_t)->Apply(bench::element_counts<std::int32_t>);       \
+    BENCHMARK_TEMPLATE(f, double)->Apply(bench::element_counts<double>);                   \
+    BENCHMARK_TEMPLATE(f, bench::Line)->Apply(bench::element_counts<bench::Line>)
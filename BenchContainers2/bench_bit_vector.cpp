@@ -0,0 +1,228 @@
+#include "bench.hpp"
+
+#include <Containers2/bit_vector.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace containers2;
+
+// flags as a BitVector, a std::vector<bool> and a byte per flag Vector<bool>; the first argument is the number of
+// flags, sized so that the packed bits fill each cache size (the bytes of Vector<bool> for its own runs)
+
+namespace {
+    void bit_counts(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            b->Arg(bytes * 8);
+        }
+    }
+
+    // second argument: the instruction set, runs above the detected one are skipped
+    void isa_bit_counts(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            for (int isa = 0; isa <= static_cast<int>(simd::Isa::avx512); ++isa) {
+                b->Args({ bytes * 8, isa });
+            }
+        }
+    }
+
+    bool set_isa(benchmark::State& state, simd::Isa& isa)
+    {
+        const char* names[]{ "scalar", "sse2", "avx2", "avx512" };
+        isa = static_cast<simd::Isa>(state.range(1));
+        if (isa > simd::detected_isa()) {
+            state.SkipWithError("instruction set not supported by this CPU");
+            return false;
+        }
+        state.SetLabel(names[state.range(1)]);
+        return true;
+    }
+
+    // set with probability 1 / 2^sparsity
+    BitVector<> random_bits(size_t n, int sparsity, std::uint64_t seed)
+    {
+        std::mt19937_64 random{ seed };
+        BitVector<> result(n, uninitialized_tag);
+        for (BitWord& word : result.words()) {
+            word = ~BitWord{ 0 };
+            for (int i = 0; i < sparsity; ++i) {
+                word &= random();
+            }
+        }
+        result.resize(n); // clears the bits past n
+        return result;
+    }
+
+    std::vector<bool> std_flags(size_t n, int sparsity, std::uint64_t seed)
+    {
+        const BitVector<> b = random_bits(n, sparsity, seed);
+        std::vector<bool> flags(n);
+        for_each_set(b, [&](size_t i) { flags[i] = true; });
+        return flags;
+    }
+
+    Vector<bool> byte_flags(size_t n, int sparsity, std::uint64_t seed)
+    {
+        const BitVector<> b = random_bits(n, sparsity, seed);
+        Vector<bool> flags(n, false);
+        for_each_set(b, [&](size_t i) { flags[i] = true; });
+        return flags;
+    }
+}
+
+// and of two sets
+
+void BM_BitVectorAnd(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    const size_t n = static_cast<size_t>(state.range(0));
+    const BitVector<> a = random_bits(n, 1, 1);
+    const BitVector<> b = random_bits(n, 1, 2);
+    BitVector<> out(n);
+    for (auto _ : state) {
+        bit_and(out, a, b, isa);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BitVectorAnd)->Apply(isa_bit_counts);
+
+void BM_StdVectorBoolAnd(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::vector<bool> a = std_flags(n, 1, 1);
+    const std::vector<bool> b = std_flags(n, 1, 2);
+    std::vector<bool> out(n);
+    for (auto _ : state) {
+        std::transform(a.begin(), a.end(), b.begin(), out.begin(), [](bool x, bool y) { return x && y; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdVectorBoolAnd)->Apply(bit_counts);
+
+void BM_VectorBoolAnd(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const Vector<bool> a = byte_flags(n, 1, 1);
+    const Vector<bool> b = byte_flags(n, 1, 2);
+    Vector<bool> out(n, uninitialized_tag);
+    for (auto _ : state) {
+        std::transform(a.begin(), a.end(), b.begin(), out.begin(), [](bool x, bool y) { return x && y; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VectorBoolAnd)->Apply(bench::element_counts<bool>);
+
+// count of set flags
+
+void BM_BitVectorPopcount(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    const BitVector<> b = random_bits(static_cast<size_t>(state.range(0)), 1, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(popcount(b, isa));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BitVectorPopcount)->Apply(isa_bit_counts);
+
+void BM_StdVectorBoolCount(benchmark::State& state)
+{
+    const std::vector<bool> flags = std_flags(static_cast<size_t>(state.range(0)), 1, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(flags.begin(), flags.end(), true));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdVectorBoolCount)->Apply(bit_counts);
+
+void BM_VectorBoolCount(benchmark::State& state)
+{
+    const Vector<bool> flags = byte_flags(static_cast<size_t>(state.range(0)), 1, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(flags.begin(), flags.end(), true));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VectorBoolCount)->Apply(bench::element_counts<bool>);
+
+// visiting the set flags of a sparse set (1 in 64)
+
+void BM_BitVectorForEachSet(benchmark::State& state)
+{
+    const BitVector<> b = random_bits(static_cast<size_t>(state.range(0)), 6, 1);
+    for (auto _ : state) {
+        size_t sum = 0;
+        for_each_set(b, [&](size_t i) { sum += i; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BitVectorForEachSet)->Apply(bit_counts);
+
+void BM_StdVectorBoolForEachSet(benchmark::State& state)
+{
+    const std::vector<bool> flags = std_flags(static_cast<size_t>(state.range(0)), 6, 1);
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t i = 0; i < flags.size(); ++i) {
+            if (flags[i]) {
+                sum += i;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdVectorBoolForEachSet)->Apply(bit_counts);
+
+// random rank and select queries, against counting from the start of a std::vector<bool> (on a few sizes only)
+
+void BM_RankSelectRank(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const BitVector<> b = random_bits(n, 1, 1);
+    const RankSelect index{ b };
+    std::mt19937_64 random{ 3 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.rank(random() % (n + 1)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RankSelectRank)->Apply(bit_counts);
+
+void BM_RankSelectSelect(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const BitVector<> b = random_bits(n, 1, 1);
+    const RankSelect index{ b };
+    std::mt19937_64 random{ 3 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.select(random() % index.ones()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RankSelectSelect)->Apply(bit_counts);
+
+void BM_StdVectorBoolRank(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::vector<bool> flags = std_flags(n, 1, 1);
+    std::mt19937_64 random{ 3 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(flags.begin(), flags.begin() + static_cast<std::ptrdiff_t>(random() % (n + 1)), true));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdVectorBoolRank)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
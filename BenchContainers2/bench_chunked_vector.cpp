@@ -0,0 +1,76 @@
+#include "bench.hpp"
+
+#include <Containers2/chunked_vector.hpp>
+
+#include <mutex>
+#include <vector>
+
+using namespace containers2;
+
+// multi-producer append throughput: every thread appends its share of the items into a fresh container per iteration
+
+namespace {
+    constexpr std::uint64_t items = 1 << 22;
+}
+
+void BM_ChunkedVectorPushBack(benchmark::State& state)
+{
+    const size_t threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        ChunkedVector<std::uint64_t> v;
+        bench::run_threads(threads, [&](size_t) {
+            for (std::uint64_t k = 0; k < items / threads; ++k) {
+                v.push_back(k);
+            }
+        });
+        benchmark::DoNotOptimize(v.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(items));
+}
+BENCHMARK(BM_ChunkedVectorPushBack)->Apply(bench::thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_ChunkedVectorGrowBy(benchmark::State& state)
+{
+    const size_t threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        ChunkedVector<std::uint64_t> v;
+        bench::run_threads(threads, [&](size_t) {
+            for (std::uint64_t k = 0; k < items / threads; k += 64) {
+                v.grow_by(64, k);
+            }
+        });
+        benchmark::DoNotOptimize(v.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(items));
+}
+BENCHMARK(BM_ChunkedVectorGrowBy)->Apply(bench::thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// what it replaces: a std::vector behind a mutex
+void BM_MutexStdVectorPushBack(benchmark::State& state)
+{
+    const size_t threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<std::uint64_t> v;
+        std::mutex mutex;
+        bench::run_threads(threads, [&](size_t) {
+            for (std::uint64_t k = 0; k < items / threads; ++k) {
+                std::lock_guard lock{ mutex };
+                v.push_back(k);
+            }
+        });
+        benchmark::DoNotOptimize(v.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(items));
+}
+BENCHMARK(BM_MutexStdVectorPushBack)->Apply(bench::thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_ChunkedVectorConsolidate(benchmark::State& state)
+{
+    ChunkedVector<std::uint64_t> v;
+    v.grow_by(items, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.consolidate().data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<std::uint64_t>(static_cast<std::int64_t>(items)));
+}
+BENCHMARK(BM_ChunkedVectorConsolidate)->Unit(benchmark::kMillisecond);
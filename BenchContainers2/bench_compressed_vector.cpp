@@ -0,0 +1,161 @@
+#include "bench.hpp"
+
+#include <Containers2/compressed_vector.hpp>
+
+#include <numeric>
+#include <random>
+
+using namespace containers2;
+
+// CompressedVector against a raw Vector of the same values, whose bytes fill each cache size. Values: sorted ids with
+// gaps of 0 to 15 (pattern 0) or unsorted values below 4096 (pattern 1). The compression_ratio counter is raw bytes
+// over compressed bytes.
+
+namespace {
+    // second argument: the pattern
+    template<typename T>
+    void counts_and_patterns(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            for (int pattern = 0; pattern < 2; ++pattern) {
+                b->Args({ bytes / static_cast<std::int64_t>(sizeof(T)), pattern });
+            }
+        }
+    }
+
+    // third argument: the instruction set, runs above the detected one are skipped
+    template<typename T>
+    void counts_patterns_and_isas(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            for (int pattern = 0; pattern < 2; ++pattern) {
+                for (int isa = 0; isa <= static_cast<int>(simd::Isa::avx512); ++isa) {
+                    b->Args({ bytes / static_cast<std::int64_t>(sizeof(T)), pattern, isa });
+                }
+            }
+        }
+    }
+
+    bool set_isa(benchmark::State& state, simd::Isa& isa)
+    {
+        const char* names[]{ "scalar", "sse2", "avx2", "avx512" };
+        isa = static_cast<simd::Isa>(state.range(2));
+        if (isa > simd::detected_isa()) {
+            state.SkipWithError("instruction set not supported by this CPU");
+            return false;
+        }
+        state.SetLabel(names[state.range(2)]);
+        return true;
+    }
+
+    template<typename T>
+    Vector<T> values(const benchmark::State& state)
+    {
+        std::mt19937_64 random{ 1 };
+        Vector<T> result(static_cast<size_t>(state.range(0)), uninitialized_tag);
+        T id = 0;
+        for (T& value : result) {
+            const std::uint64_t r = random();
+            if (state.range(1) == 0) {
+                id += static_cast<T>(r & 15);
+                value = id;
+            }
+            else {
+                value = static_cast<T>(r & 4095);
+            }
+        }
+        return result;
+    }
+
+    template<typename T>
+    void set_ratio(benchmark::State& state, const CompressedVector<T>& compressed)
+    {
+        state.counters["compression_ratio"] = static_cast<double>(compressed.size() * sizeof(T)) / static_cast<double>(compressed.compressed_bytes());
+    }
+}
+
+// sum of all the values: a raw scan against a streaming decode through a buffer of 16 blocks
+
+template<typename T>
+void BM_VectorSum(benchmark::State& state)
+{
+    const Vector<T> raw = values<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(raw.begin(), raw.end(), T{ 0 }));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(T)));
+}
+BENCHMARK(BM_VectorSum<std::uint32_t>)->Apply(counts_and_patterns<std::uint32_t>);
+BENCHMARK(BM_VectorSum<std::uint64_t>)->Apply(counts_and_patterns<std::uint64_t>);
+
+template<typename T>
+void BM_CompressedVectorStreamingSum(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    const CompressedVector<T> compressed{ values<T>(state) };
+    T buffer[16 * compressed_block_size];
+    for (auto _ : state) {
+        T sum = 0;
+        for (size_t first = 0; first < compressed.size(); first += std::size(buffer)) {
+            const size_t n = std::min(std::size(buffer), compressed.size() - first);
+            compressed.decode(first, VectorView<T>{ buffer, buffer + n }, isa);
+            sum = std::accumulate(buffer, buffer + n, sum);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_ratio(state, compressed);
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(T)));
+}
+BENCHMARK(BM_CompressedVectorStreamingSum<std::uint32_t>)->Apply(counts_patterns_and_isas<std::uint32_t>);
+BENCHMARK(BM_CompressedVectorStreamingSum<std::uint64_t>)->Apply(counts_patterns_and_isas<std::uint64_t>);
+
+// decode throughput alone, into a buffer as large as the values
+
+template<typename T>
+void BM_CompressedVectorDecode(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    const CompressedVector<T> compressed{ values<T>(state) };
+    Vector<T> out(compressed.size(), uninitialized_tag);
+    for (auto _ : state) {
+        compressed.decode(out, isa);
+        benchmark::ClobberMemory();
+    }
+    set_ratio(state, compressed);
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(T)));
+}
+BENCHMARK(BM_CompressedVectorDecode<std::uint32_t>)->Apply(counts_patterns_and_isas<std::uint32_t>);
+BENCHMARK(BM_CompressedVectorDecode<std::uint64_t>)->Apply(counts_patterns_and_isas<std::uint64_t>);
+
+// random element access
+
+template<typename T>
+void BM_VectorRandomAccess(benchmark::State& state)
+{
+    const Vector<T> raw = values<T>(state);
+    std::mt19937_64 random{ 2 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(raw[random() % raw.size()]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VectorRandomAccess<std::uint32_t>)->Apply(counts_and_patterns<std::uint32_t>);
+
+template<typename T>
+void BM_CompressedVectorRandomAccess(benchmark::State& state)
+{
+    const CompressedVector<T> compressed{ values<T>(state) };
+    std::mt19937_64 random{ 2 };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compressed[random() % compressed.size()]);
+    }
+    set_ratio(state, compressed);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CompressedVectorRandomAccess<std::uint32_t>)->Apply(counts_and_patterns<std::uint32_t>);
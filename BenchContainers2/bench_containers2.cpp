@@ -0,0 +1,341 @@
+#include "bench.hpp"
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+using namespace containers2;
+
+namespace {
+    template<typename T>
+    std::uint64_t value(const T& x) { return static_cast<std::uint64_t>(x); }
+
+    std::uint64_t value(const bench::Line& x) { return x.value; }
+
+    template<typename T>
+    T make(std::uint64_t x)
+    {
+        if constexpr (std::is_same_v<T, bench::Line>) {
+            return { x, {} };
+        }
+        else {
+            return static_cast<T>(x);
+        }
+    }
+}
+
+// construction
+
+template<typename T>
+void BM_VectorUninitialized(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector<T> v(n, uninitialized_tag);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_VectorUninitialized);
+
+template<typename T>
+void BM_VectorInitialized(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector<T> v(n, make<T>(1), initialized_tag);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_VectorInitialized);
+
+template<typename T>
+void BM_StdVectorDefault(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<T> v(n);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_StdVectorDefault);
+
+template<typename T>
+void BM_StdVectorValue(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<T> v(n, make<T>(1));
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_StdVectorValue);
+
+// resize from n / 2 to n elements, allocation of the first half included
+
+template<typename T, typename Tag>
+void BM_VectorResize(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector<T> v(n / 2, uninitialized_tag);
+        if constexpr (std::is_same_v<Tag, initialized_tag_t> || std::is_same_v<Tag, non_preserving_initialized_tag_t>) {
+            v.resize(n, make<T>(1), Tag{});
+        }
+        else {
+            v.resize(n, Tag{});
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+
+#define CONTAINERS2_BENCHMARK_RESIZE(T)                                                                           \
+    BENCHMARK_TEMPLATE(BM_VectorResize, T, uninitialized_tag_t)->Apply(bench::element_counts<T>);                \
+    BENCHMARK_TEMPLATE(BM_VectorResize, T, initialized_tag_t)->Apply(bench::element_counts<T>);                  \
+    BENCHMARK_TEMPLATE(BM_VectorResize, T, non_preserving_uninitialized_tag_t)->Apply(bench::element_counts<T>); \
+    BENCHMARK_TEMPLATE(BM_VectorResize, T, non_preserving_initialized_tag_t)->Apply(bench::element_counts<T>)
+
+CONTAINERS2_BENCHMARK_RESIZE(std::uint8_t);
+CONTAINERS2_BENCHMARK_RESIZE(std::int32_t);
+CONTAINERS2_BENCHMARK_RESIZE(double);
+CONTAINERS2_BENCHMARK_RESIZE(bench::Line);
+
+// same growth through new[] and an element-wise move instead of realloc
+template<typename T>
+void BM_VectorResizeNewDelete(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector<T> v(n / 2, uninitialized_tag, nullptr);
+        v.resize(n, uninitialized_tag);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_VectorResizeNewDelete);
+
+template<typename T>
+void BM_StdVectorResize(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<T> v(n / 2);
+        v.resize(n);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_StdVectorResize);
+
+// fill
+
+template<typename T>
+void BM_VectorViewFill(benchmark::State& state)
+{
+    Vector<T> v(static_cast<size_t>(state.range(0)), make<T>(0), initialized_tag);
+    const VectorView<T> view = v;
+    for (auto _ : state) {
+        std::fill(view.begin(), view.end(), make<T>(7));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_VectorViewFill);
+
+template<typename T>
+void BM_StdVectorFill(benchmark::State& state)
+{
+    std::vector<T> v(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::fill(v.begin(), v.end(), make<T>(7));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_StdVectorFill);
+
+// copy of a double buffer of each cache size into a Vector of the same size: element by element, and copy_from with
+// each CopyMode (automatic streams past the last level cache); bytes processed count the bytes copied
+
+namespace {
+    void copy_modes(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            for (int mode = 0; mode <= static_cast<int>(CopyMode::streaming); ++mode) {
+                b->Args({ bytes / static_cast<std::int64_t>(sizeof(double)), mode });
+            }
+        }
+    }
+}
+
+void BM_VectorCopyLoop(benchmark::State& state)
+{
+    const Vector<double> source(static_cast<size_t>(state.range(0)), 1.0, initialized_tag);
+    Vector<double> destination(source.size(), uninitialized_tag);
+    for (auto _ : state) {
+        for (size_t i = 0; i < source.size(); ++i) {
+            destination[i] = source[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(state.range(0)));
+}
+BENCHMARK(BM_VectorCopyLoop)->Apply(bench::element_counts<double>);
+
+void BM_VectorCopyFrom(benchmark::State& state)
+{
+    const char* names[]{ "automatic", "cached", "streaming" };
+    const CopyMode mode = static_cast<CopyMode>(state.range(1));
+    state.SetLabel(names[state.range(1)]);
+    const Vector<double> source(static_cast<size_t>(state.range(0)), 1.0, initialized_tag);
+    Vector<double> destination(source.size(), uninitialized_tag);
+    for (auto _ : state) {
+        destination.copy_from(source, mode);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(state.range(0)));
+}
+BENCHMARK(BM_VectorCopyFrom)->Apply(copy_modes);
+
+// allocation included
+void BM_VectorClone(benchmark::State& state)
+{
+    const Vector<double> source(static_cast<size_t>(state.range(0)), 1.0, initialized_tag);
+    for (auto _ : state) {
+        const Vector<double> copy = source.clone();
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(state.range(0)));
+}
+BENCHMARK(BM_VectorClone)->Apply(bench::element_counts<double>);
+
+// iteration
+
+template<typename T>
+void BM_VectorViewIterate(benchmark::State& state)
+{
+    Vector<T> v(static_cast<size_t>(state.range(0)), make<T>(1), initialized_tag);
+    const VectorView<const T> view = v;
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const T& x : view) {
+            sum += value(x);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_VectorViewIterate);
+
+template<typename T>
+void BM_SpanIterate(benchmark::State& state)
+{
+    std::vector<T> v(static_cast<size_t>(state.range(0)), make<T>(1));
+    const std::span<const T> view = v;
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const T& x : view) {
+            sum += value(x);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_SpanIterate);
+
+template<typename T>
+void BM_StdVectorIterate(benchmark::State& state)
+{
+    const std::vector<T> v(static_cast<size_t>(state.range(0)), make<T>(1));
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const T& x : v) {
+            sum += value(x);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+CONTAINERS2_BENCHMARK_ELEMENTS(BM_StdVectorIterate);
+
+// move: a pair of buffer hand-overs per iteration, independent of the size
+
+template<typename T>
+void BM_VectorMove(benchmark::State& state)
+{
+    Vector<T> a(static_cast<size_t>(state.range(0)), uninitialized_tag);
+    Vector<T> b;
+    for (auto _ : state) {
+        b = std::move(a);
+        a = std::move(b);
+        benchmark::DoNotOptimize(a.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_VectorMove, std::int32_t)->Arg(1 << 10);
+
+template<typename T>
+void BM_StdVectorMove(benchmark::State& state)
+{
+    std::vector<T> a(static_cast<size_t>(state.range(0)));
+    std::vector<T> b;
+    for (auto _ : state) {
+        b = std::move(a);
+        a = std::move(b);
+        benchmark::DoNotOptimize(a.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_StdVectorMove, std::int32_t)->Arg(1 << 10);
+
+// allocation throughput of the memory resources, on small buffers where the allocator dominates
+
+enum class Resource { new_delete, malloc, aligned, thread_local_pool };
+
+std::pmr::memory_resource* resource(Resource r)
+{
+    switch (r) {
+    case Resource::new_delete: return nullptr;
+    case Resource::malloc: return malloc_memory_resource();
+    case Resource::aligned: return aligned_memory_resource<cache_line_size>();
+    default: return thread_local_memory_resource();
+    }
+}
+
+void BM_VectorAllocate(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::pmr::memory_resource* r = resource(static_cast<Resource>(state.range(1)));
+    const char* names[]{ "new[]", "malloc", "aligned", "thread_local_pool" };
+    state.SetLabel(names[state.range(1)]);
+    for (auto _ : state) {
+        Vector<std::int32_t> v(n, uninitialized_tag, r);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VectorAllocate)->ArgsProduct({ { 16, 1024 }, { 0, 1, 2, 3 } });
+
+// growth one element at a time (amortized geometric resize), realloc against new[] + move
+void BM_VectorGrow(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::pmr::memory_resource* r = resource(static_cast<Resource>(state.range(1)));
+    const char* names[]{ "new[]", "malloc", "aligned", "thread_local_pool" };
+    state.SetLabel(names[state.range(1)]);
+    for (auto _ : state) {
+        Vector<std::int32_t> v(0, uninitialized_tag, r);
+        for (size_t i = 0; i < n; ++i) {
+            v.resize(i + 1, uninitialized_tag);
+            v[i] = static_cast<std::int32_t>(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VectorGrow)->ArgsProduct({ { 1 << 16, 1 << 22 }, { 0, 1, 2 } });
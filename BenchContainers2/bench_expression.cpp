@@ -0,0 +1,151 @@
+#include "bench.hpp"
+
+#include <Containers2/expression.hpp>
+
+using namespace containers2;
+
+// out = a + b * c and out = select(a > b, a * 2 + c, b - c) over float Vectors of each cache size: one loop and a
+// temporary Vector per operator, one hand-written loop, and the fused expression. Bytes processed count the operands
+// read once and the result written once; the temporaries add a write and a read of every intermediate.
+
+namespace {
+    // second argument: the instruction set of the fused expression, runs above the detected one are skipped
+    void isa_counts(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            for (int isa = 0; isa <= static_cast<int>(simd::Isa::avx512); ++isa) {
+                b->Args({ bytes / static_cast<std::int64_t>(sizeof(float)), isa });
+            }
+        }
+    }
+
+    bool set_isa(benchmark::State& state, simd::Isa& isa)
+    {
+        const char* names[]{ "scalar", "sse2", "avx2", "avx512" };
+        isa = static_cast<simd::Isa>(state.range(1));
+        if (isa > simd::detected_isa()) {
+            state.SkipWithError("instruction set not supported by this CPU");
+            return false;
+        }
+        state.SetLabel(names[state.range(1)]);
+        return true;
+    }
+
+    struct Operands
+    {
+        Vector<float> a;
+        Vector<float> b;
+        Vector<float> c;
+        Vector<float> out;
+
+        explicit Operands(const benchmark::State& state) :
+            a(static_cast<size_t>(state.range(0)), 1.0f, initialized_tag),
+            b(static_cast<size_t>(state.range(0)), 2.0f, initialized_tag),
+            c(static_cast<size_t>(state.range(0)), 3.0f, initialized_tag),
+            out(static_cast<size_t>(state.range(0)), uninitialized_tag) {}
+    };
+
+    // one operator: a loop into a new Vector
+    template<typename F>
+    Vector<float> apply(VectorView<const float> x, VectorView<const float> y, F f)
+    {
+        Vector<float> result(x.size(), uninitialized_tag);
+        for (size_t i = 0; i < x.size(); ++i) {
+            result[i] = f(x[i], y[i]);
+        }
+        return result;
+    }
+}
+
+void BM_MultiplyAddTemporaries(benchmark::State& state)
+{
+    Operands v{ state };
+    for (auto _ : state) {
+        const Vector<float> product = apply(v.b, v.c, std::multiplies<>{});
+        v.out = apply(v.a, product, std::plus<>{});
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 4 * bench::bytes<float>(state.range(0)));
+}
+BENCHMARK(BM_MultiplyAddTemporaries)->Apply(bench::element_counts<float>);
+
+void BM_MultiplyAddLoop(benchmark::State& state)
+{
+    Operands v{ state };
+    for (auto _ : state) {
+        for (size_t i = 0; i < v.out.size(); ++i) {
+            v.out[i] = v.a[i] + v.b[i] * v.c[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 4 * bench::bytes<float>(state.range(0)));
+}
+BENCHMARK(BM_MultiplyAddLoop)->Apply(bench::element_counts<float>);
+
+void BM_MultiplyAddExpression(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    Operands v{ state };
+    const auto a = expr::lazy(v.a);
+    const auto b = expr::lazy(v.b);
+    const auto c = expr::lazy(v.c);
+    for (auto _ : state) {
+        expr::assign(v.out, a + b * c, isa);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 4 * bench::bytes<float>(state.range(0)));
+}
+BENCHMARK(BM_MultiplyAddExpression)->Apply(isa_counts);
+
+void BM_SelectTemporaries(benchmark::State& state)
+{
+    Operands v{ state };
+    for (auto _ : state) {
+        const Vector<float> greater = apply(v.a, v.b, [](float x, float y) { return x > y ? 1.0f : 0.0f; });
+        const Vector<float> doubled = apply(v.a, v.a, [](float x, float) { return x * 2; });
+        const Vector<float> sum = apply(doubled, v.c, std::plus<>{});
+        const Vector<float> difference = apply(v.b, v.c, std::minus<>{});
+        Vector<float> result(v.out.size(), uninitialized_tag);
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = greater[i] != 0 ? sum[i] : difference[i];
+        }
+        v.out = std::move(result);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 4 * bench::bytes<float>(state.range(0)));
+}
+BENCHMARK(BM_SelectTemporaries)->Apply(bench::element_counts<float>);
+
+void BM_SelectLoop(benchmark::State& state)
+{
+    Operands v{ state };
+    for (auto _ : state) {
+        for (size_t i = 0; i < v.out.size(); ++i) {
+            v.out[i] = v.a[i] > v.b[i] ? v.a[i] * 2 + v.c[i] : v.b[i] - v.c[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 4 * bench::bytes<float>(state.range(0)));
+}
+BENCHMARK(BM_SelectLoop)->Apply(bench::element_counts<float>);
+
+void BM_SelectExpression(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    Operands v{ state };
+    const auto a = expr::lazy(v.a);
+    const auto b = expr::lazy(v.b);
+    const auto c = expr::lazy(v.c);
+    for (auto _ : state) {
+        expr::assign(v.out, expr::select(a > b, a * 2 + c, b - c), isa);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 4 * bench::bytes<float>(state.range(0)));
+}
+BENCHMARK(BM_SelectExpression)->Apply(isa_counts);
@@ -0,0 +1,208 @@
+#include "bench.hpp"
+
+#include <Containers2/flat_hash_map.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <unordered_map>
+
+using namespace containers2;
+
+// FlatHashMap against std::unordered_map with 64-bit keys and values; the first argument is the capacity of the
+// FlatHashMap (the largest power of two whose slots fit in each cache size), the second the load factor in percent,
+// the std::unordered_map runs hold the same number of elements
+
+namespace {
+    using Map = FlatHashMap<std::uint64_t, std::uint64_t>;
+    using StdMap = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+    constexpr std::int64_t load_factors[]{ 25, 50, 75, 87 };
+
+    void capacities_and_loads(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            const std::int64_t capacity = static_cast<std::int64_t>(std::bit_floor(static_cast<std::uint64_t>(bytes) / sizeof(Map::Slot)));
+            for (std::int64_t load : load_factors) {
+                b->Args({ std::max(capacity, static_cast<std::int64_t>(Map::min_capacity)), load });
+            }
+        }
+    }
+
+    size_t element_count(const benchmark::State& state)
+    {
+        return static_cast<size_t>(state.range(0) * state.range(1) / 100);
+    }
+
+    // distinct random keys: the odd ones are in the maps, the even ones are the misses
+    Vector<std::uint64_t> random_keys(size_t n, bool odd, std::uint64_t seed)
+    {
+        std::mt19937_64 random{ seed };
+        Vector<std::uint64_t> keys(n, uninitialized_tag);
+        for (auto& key : keys) {
+            key = odd ? random() | 1 : random() & ~std::uint64_t{ 1 };
+        }
+        return keys;
+    }
+
+    // the map at the requested load factor, without growing on the way
+    Map filled_map(const benchmark::State& state, VectorView<const std::uint64_t> keys)
+    {
+        Map map;
+        map.reserve(static_cast<size_t>(state.range(0)) / 8 * 7);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            map.insert(keys[i], i);
+        }
+        return map;
+    }
+
+    StdMap filled_std_map(VectorView<const std::uint64_t> keys)
+    {
+        StdMap map;
+        map.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            map.emplace(keys[i], i);
+        }
+        return map;
+    }
+
+    // the keys of the lookups, in an order unrelated to the insertions
+    Vector<std::uint64_t> lookups(VectorView<const std::uint64_t> keys)
+    {
+        Vector<std::uint64_t> result(keys.size(), uninitialized_tag);
+        std::copy(keys.begin(), keys.end(), result.begin());
+        std::shuffle(result.begin(), result.end(), std::mt19937_64{ 3 });
+        return result;
+    }
+
+    void set_memory(benchmark::State& state, size_t bytes, size_t n)
+    {
+        state.counters["bytes_per_element"] = static_cast<double>(bytes) / static_cast<double>(std::max<size_t>(n, 1));
+    }
+}
+
+// n insertions into a map reserved up front (the cost of the allocation included)
+
+void BM_FlatHashMapInsert(benchmark::State& state)
+{
+    const size_t n = element_count(state);
+    const Vector<std::uint64_t> keys = random_keys(n, true, 1);
+    for (auto _ : state) {
+        Map map = filled_map(state, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+    set_memory(state, static_cast<size_t>(state.range(0)) * (sizeof(Map::Slot) + 1), n);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_FlatHashMapInsert)->Apply(capacities_and_loads);
+
+void BM_FlatHashMapBulkInsert(benchmark::State& state)
+{
+    const size_t n = element_count(state);
+    const Vector<std::uint64_t> keys = random_keys(n, true, 1);
+    Vector<std::uint64_t> values(n, uninitialized_tag);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = i;
+    }
+    for (auto _ : state) {
+        Map map;
+        map.reserve(static_cast<size_t>(state.range(0)) / 8 * 7);
+        map.insert(keys, values);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_FlatHashMapBulkInsert)->Apply(capacities_and_loads);
+
+void BM_StdUnorderedMapInsert(benchmark::State& state)
+{
+    const size_t n = element_count(state);
+    const Vector<std::uint64_t> keys = random_keys(n, true, 1);
+    for (auto _ : state) {
+        StdMap map = filled_std_map(keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+    // nodes (key, value and next pointer, rounded by malloc) and one bucket pointer per element
+    set_memory(state, n * (32 + sizeof(void*)), n);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_StdUnorderedMapInsert)->Apply(capacities_and_loads);
+
+// random lookups of keys present in the map
+
+void BM_FlatHashMapFindHit(benchmark::State& state)
+{
+    const Vector<std::uint64_t> keys = random_keys(element_count(state), true, 1);
+    const Map map = filled_map(state, keys);
+    const FlatHashMapView<std::uint64_t, std::uint64_t> view = map;
+    const Vector<std::uint64_t> queries = lookups(keys);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.find(queries[i]));
+        i = i + 1 == queries.size() ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FlatHashMapFindHit)->Apply(capacities_and_loads);
+
+void BM_StdUnorderedMapFindHit(benchmark::State& state)
+{
+    const Vector<std::uint64_t> keys = random_keys(element_count(state), true, 1);
+    const StdMap map = filled_std_map(keys);
+    const Vector<std::uint64_t> queries = lookups(keys);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(queries[i]));
+        i = i + 1 == queries.size() ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdUnorderedMapFindHit)->Apply(capacities_and_loads);
+
+// random lookups of keys absent from the map: the probe runs until a group with an empty byte
+
+void BM_FlatHashMapFindMiss(benchmark::State& state)
+{
+    const size_t n = element_count(state);
+    const Vector<std::uint64_t> keys = random_keys(n, true, 1);
+    const Map map = filled_map(state, keys);
+    const Vector<std::uint64_t> queries = random_keys(n, false, 2);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(queries[i]));
+        i = i + 1 == queries.size() ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FlatHashMapFindMiss)->Apply(capacities_and_loads);
+
+void BM_StdUnorderedMapFindMiss(benchmark::State& state)
+{
+    const size_t n = element_count(state);
+    const Vector<std::uint64_t> keys = random_keys(n, true, 1);
+    const StdMap map = filled_std_map(keys);
+    const Vector<std::uint64_t> queries = random_keys(n, false, 2);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(queries[i]));
+        i = i + 1 == queries.size() ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdUnorderedMapFindMiss)->Apply(capacities_and_loads);
+
+// all the hits at once through the batched lookup, which prefetches the groups ahead of the probes
+
+void BM_FlatHashMapBatchedFind(benchmark::State& state)
+{
+    const Vector<std::uint64_t> keys = random_keys(element_count(state), true, 1);
+    const Map map = filled_map(state, keys);
+    const Vector<std::uint64_t> queries = lookups(keys);
+    Vector<const std::uint64_t*> found(queries.size(), uninitialized_tag);
+    for (auto _ : state) {
+        map.find(queries, found);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+}
+BENCHMARK(BM_FlatHashMapBatchedFind)->Apply(capacities_and_loads);
@@ -0,0 +1,83 @@
+#include "bench.hpp"
+
+#include <Containers2/large_memory.hpp>
+
+#include <map>
+#include <memory>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+using namespace containers2;
+
+// constructing and destroying a Vector<double> of 1.0 twice the size of the last level cache: the constructor
+// (malloc, then std::fill on the calling thread) against parallel::make_vector() by thread count, from malloc and from
+// huge pages. Bytes processed count the elements written; page_faults counts the minor faults of an iteration.
+
+namespace {
+    ThreadPool& pool(std::int64_t concurrency)
+    {
+        static std::map<std::int64_t, std::unique_ptr<ThreadPool>> pools;
+        auto& p = pools[concurrency];
+        if (!p) {
+            p = std::make_unique<ThreadPool>(static_cast<size_t>(concurrency));
+        }
+        return *p;
+    }
+
+    size_t element_count()
+    {
+        return static_cast<size_t>(bench::cache_sizes().back()) / sizeof(double);
+    }
+
+    std::int64_t page_faults()
+    {
+#if defined(__linux__)
+        rusage usage{};
+        ::getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_minflt;
+#else
+        return 0;
+#endif
+    }
+
+    // first argument: threads, second: malloc (0) or huge pages (1)
+    void thread_and_resource_counts(benchmark::internal::Benchmark* b)
+    {
+        for (int resource = 0; resource < 2; ++resource) {
+            const std::int64_t hardware = std::max<std::int64_t>(std::thread::hardware_concurrency(), 1);
+            for (std::int64_t threads = 1; threads < hardware; threads *= 2) {
+                b->Args({ threads, resource });
+            }
+            b->Args({ hardware, resource });
+        }
+    }
+}
+
+void BM_VectorConstructLarge(benchmark::State& state)
+{
+    const std::int64_t faults = page_faults();
+    for (auto _ : state) {
+        const Vector<double> v(element_count(), 1.0, initialized_tag);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.counters["page_faults"] = benchmark::Counter(static_cast<double>(page_faults() - faults), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(static_cast<std::int64_t>(element_count())));
+}
+BENCHMARK(BM_VectorConstructLarge)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_ParallelMakeVector(benchmark::State& state)
+{
+    ThreadPool& p = pool(state.range(0));
+    std::pmr::memory_resource* resource = state.range(1) == 0 ? malloc_memory_resource() : large_page_memory_resource();
+    state.SetLabel(state.range(1) == 0 ? "malloc" : "huge pages");
+    const std::int64_t faults = page_faults();
+    for (auto _ : state) {
+        const Vector<double> v = parallel::make_vector(element_count(), 1.0, resource, p);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.counters["page_faults"] = benchmark::Counter(static_cast<double>(page_faults() - faults), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(static_cast<std::int64_t>(element_count())));
+}
+BENCHMARK(BM_ParallelMakeVector)->Apply(thread_and_resource_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
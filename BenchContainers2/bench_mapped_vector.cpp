@@ -0,0 +1,75 @@
+#include "bench.hpp"
+
+#include <Containers2/mapped_vector.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+using namespace containers2;
+
+namespace {
+    // one file of bytes bytes per size, written on first use and removed at exit; the page cache is warm after the
+    // first iteration, so these compare the cost of getting the data into the process, not disk throughput
+    const std::filesystem::path& data_file(std::int64_t bytes)
+    {
+        struct File
+        {
+            std::filesystem::path path;
+            ~File() { std::filesystem::remove(path); }
+        };
+        static std::vector<std::unique_ptr<File>> files;
+        for (const auto& file : files) {
+            if (static_cast<std::int64_t>(std::filesystem::file_size(file->path)) == bytes) {
+                return file->path;
+            }
+        }
+        auto file = std::make_unique<File>(File{ std::filesystem::temp_directory_path() / ("containers2_bench_" + std::to_string(bytes) + ".bin") });
+        Vector<std::uint32_t> data(static_cast<size_t>(bytes) / sizeof(std::uint32_t), uninitialized_tag);
+        std::iota(data.begin(), data.end(), 0u);
+        std::ofstream{ file->path, std::ios::binary | std::ios::trunc }.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(std::uint32_t)));
+        files.push_back(std::move(file));
+        return files.back()->path;
+    }
+
+    std::uint64_t sum(VectorView<const std::uint32_t> view)
+    {
+        return std::accumulate(view.begin(), view.end(), std::uint64_t{ 0 });
+    }
+}
+
+void BM_ReadFileSum(benchmark::State& state)
+{
+    const auto& path = data_file(state.range(0));
+    for (auto _ : state) {
+        Vector<std::uint32_t> data(static_cast<size_t>(state.range(0)) / sizeof(std::uint32_t), uninitialized_tag);
+        std::ifstream{ path, std::ios::binary }.read(reinterpret_cast<char*>(data.data()), state.range(0));
+        benchmark::DoNotOptimize(sum(data));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadFileSum)->Apply(bench::element_counts<std::uint8_t>);
+
+// second argument: 0 maps lazily, 1 populates, 2 advises sequential access
+void BM_MappedVectorSum(benchmark::State& state)
+{
+    const auto& path = data_file(state.range(0));
+    MapOptions options{};
+    options.populate = state.range(1) == 1;
+    options.advice = state.range(1) == 2 ? MapAdvice::sequential : MapAdvice::normal;
+    const char* names[]{ "lazy", "populate", "sequential" };
+    state.SetLabel(names[state.range(1)]);
+    for (auto _ : state) {
+        const MappedVector<const std::uint32_t> data{ path, MapMode::read_only, options };
+        benchmark::DoNotOptimize(sum(data));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MappedVectorSum)->Apply([](benchmark::internal::Benchmark* b) {
+    for (std::int64_t bytes : bench::cache_sizes()) {
+        for (std::int64_t mode = 0; mode < 3; ++mode) {
+            b->Args({ bytes, mode });
+        }
+    }
+});
@@ -0,0 +1,103 @@
+#include "bench.hpp"
+
+#include <Containers2/matrix_view.hpp>
+
+using namespace containers2;
+
+namespace {
+    void square_sizes(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t n : { 256, 1024, 4096 }) {
+            b->Arg(n);
+        }
+    }
+}
+
+void BM_TransposeNaive(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<float> a(n * n, 1.0f, initialized_tag);
+    Vector<float> b(n * n, uninitialized_tag);
+    const MatrixView<const float> src{ VectorView<const float>{ a }, n, n };
+    const MatrixView<float> dst{ VectorView<float>{ b }, n, n };
+    for (auto _ : state) {
+        for (size_t r = 0; r < n; ++r) {
+            for (size_t c = 0; c < n; ++c) {
+                dst(c, r) = src(r, c);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<float>(state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_TransposeNaive)->Apply(square_sizes);
+
+void BM_TransposeTiled(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<float> a(n * n, 1.0f, initialized_tag);
+    Vector<float> b(n * n, uninitialized_tag);
+    const MatrixView<const float> src{ VectorView<const float>{ a }, n, n };
+    const MatrixView<float> dst{ VectorView<float>{ b }, n, n };
+    for (auto _ : state) {
+        transpose(src, dst);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<float>(state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_TransposeTiled)->Apply(square_sizes);
+
+void BM_TransposeInPlace(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<float> a(n * n, 1.0f, initialized_tag);
+    const MatrixView<float> matrix{ VectorView<float>{ a }, n, n };
+    for (auto _ : state) {
+        transpose_in_place(matrix);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<float>(state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_TransposeInPlace)->Apply(square_sizes);
+
+// column sums through a StridedView against row-major accumulation
+void BM_ColumnSumsStrided(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<float> a(n * n, 1.0f, initialized_tag);
+    Vector<float> sums(n, uninitialized_tag);
+    const MatrixView<const float> matrix{ VectorView<const float>{ a }, n, n };
+    for (auto _ : state) {
+        for (size_t c = 0; c < n; ++c) {
+            const StridedView<const float> column = matrix.column(c);
+            float s = 0;
+            for (size_t r = 0; r < n; ++r) {
+                s += column[r];
+            }
+            sums[c] = s;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<float>(state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_ColumnSumsStrided)->Apply(square_sizes);
+
+void BM_ColumnSumsRows(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<float> a(n * n, 1.0f, initialized_tag);
+    Vector<float> sums(n, uninitialized_tag);
+    const MatrixView<const float> matrix{ VectorView<const float>{ a }, n, n };
+    for (auto _ : state) {
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        for (size_t r = 0; r < n; ++r) {
+            const VectorView<const float> row = matrix.row(r);
+            for (size_t c = 0; c < n; ++c) {
+                sums[c] += row[c];
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<float>(state.range(0) * state.range(0)));
+}
+BENCHMARK(BM_ColumnSumsRows)->Apply(square_sizes);
@@ -0,0 +1,122 @@
+#include "bench.hpp"
+
+#include <Containers2/parallel.hpp>
+
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace containers2;
+
+// scaling by thread count over a buffer twice the size of the last level cache
+
+namespace {
+    ThreadPool& pool(std::int64_t concurrency)
+    {
+        static std::map<std::int64_t, std::unique_ptr<ThreadPool>> pools;
+        auto& p = pools[concurrency];
+        if (!p) {
+            p = std::make_unique<ThreadPool>(static_cast<size_t>(concurrency));
+        }
+        return *p;
+    }
+
+    size_t element_count()
+    {
+        return static_cast<size_t>(bench::cache_sizes().back()) / sizeof(double);
+    }
+}
+
+void BM_ParallelForEach(benchmark::State& state)
+{
+    Vector<double> v(element_count(), 1.0, initialized_tag);
+    ThreadPool& p = pool(state.range(0));
+    for (auto _ : state) {
+        parallel::for_each(VectorView<double>{ v }, [](double& x) { x = x * 1.0000001 + 0.5; }, p);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(static_cast<std::int64_t>(v.size())));
+}
+BENCHMARK(BM_ParallelForEach)->Apply(bench::thread_counts)->UseRealTime();
+
+void BM_ParallelTransform(benchmark::State& state)
+{
+    Vector<double> in(element_count(), 1.0, initialized_tag);
+    Vector<double> out(element_count(), uninitialized_tag);
+    ThreadPool& p = pool(state.range(0));
+    for (auto _ : state) {
+        parallel::transform(VectorView<const double>{ in }, VectorView<double>{ out }, [](double x) { return x * 2.0; }, p);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * bench::bytes<double>(static_cast<std::int64_t>(in.size())));
+}
+BENCHMARK(BM_ParallelTransform)->Apply(bench::thread_counts)->UseRealTime();
+
+// automatic copy mode: non-temporal stores at this size
+void BM_ParallelCopy(benchmark::State& state)
+{
+    Vector<double> in(element_count(), 1.0, initialized_tag);
+    Vector<double> out(element_count(), uninitialized_tag);
+    ThreadPool& p = pool(state.range(0));
+    for (auto _ : state) {
+        parallel::copy(VectorView<const double>{ in }, VectorView<double>{ out }, CopyMode::automatic, p);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(static_cast<std::int64_t>(in.size())));
+}
+BENCHMARK(BM_ParallelCopy)->Apply(bench::thread_counts)->UseRealTime();
+
+void BM_ParallelReduce(benchmark::State& state)
+{
+    Vector<double> v(element_count(), 1.0, initialized_tag);
+    ThreadPool& p = pool(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel::reduce(VectorView<const double>{ v }, 0.0, std::plus<>{}, p));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(static_cast<std::int64_t>(v.size())));
+}
+BENCHMARK(BM_ParallelReduce)->Apply(bench::thread_counts)->UseRealTime();
+
+void BM_ParallelReduceDeterministic(benchmark::State& state)
+{
+    Vector<double> v(element_count(), 1.0, initialized_tag);
+    ThreadPool& p = pool(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel::reduce(VectorView<const double>{ v }, 0.0, std::plus<>{}, deterministic_tag, p));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<double>(static_cast<std::int64_t>(v.size())));
+}
+BENCHMARK(BM_ParallelReduceDeterministic)->Apply(bench::thread_counts)->UseRealTime();
+
+void BM_ParallelInclusiveScan(benchmark::State& state)
+{
+    Vector<double> in(element_count(), 1.0, initialized_tag);
+    Vector<double> out(element_count(), uninitialized_tag);
+    ThreadPool& p = pool(state.range(0));
+    for (auto _ : state) {
+        parallel::inclusive_scan(VectorView<const double>{ in }, VectorView<double>{ out }, std::plus<>{}, p);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * bench::bytes<double>(static_cast<std::int64_t>(in.size())));
+}
+BENCHMARK(BM_ParallelInclusiveScan)->Apply(bench::thread_counts)->UseRealTime();
+
+void BM_ParallelSort(benchmark::State& state)
+{
+    const size_t n = size_t{ 1 } << 24;
+    Vector<std::uint32_t> source(n, uninitialized_tag);
+    std::mt19937 random{ 1 };
+    for (auto& x : source) {
+        x = random();
+    }
+    Vector<std::uint32_t> v(n, uninitialized_tag);
+    ThreadPool& p = pool(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::copy(source.begin(), source.end(), v.begin());
+        state.ResumeTiming();
+        parallel::sort(VectorView<std::uint32_t>{ v }, std::less<>{}, p);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_ParallelSort)->Apply(bench::thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,180 @@
+#include "bench.hpp"
+
+#include <Containers2/ring_buffer.hpp>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+using namespace containers2;
+
+// throughput: transfers items through a 1024-slot queue between producer and consumer threads, started per iteration;
+// latency: round trips of one item through a pair of queues and an echo thread.
+// Waiting threads yield, so that the numbers stay meaningful with more threads than cores.
+
+namespace {
+    constexpr std::uint64_t items = 1 << 20;
+    constexpr size_t slots = 1024;
+
+    // what the queues replace
+    struct MutexDeque
+    {
+        std::mutex mutex;
+        std::deque<std::uint64_t> items;
+
+        explicit MutexDeque(size_t) {}
+
+        bool try_push(std::uint64_t value)
+        {
+            std::lock_guard lock{ mutex };
+            if (items.size() == slots) {
+                return false;
+            }
+            items.push_back(value);
+            return true;
+        }
+
+        std::optional<std::uint64_t> try_pop()
+        {
+            std::lock_guard lock{ mutex };
+            if (items.empty()) {
+                return std::nullopt;
+            }
+            const std::uint64_t value = items.front();
+            items.pop_front();
+            return value;
+        }
+    };
+
+    // pairs producer i with consumer i, every producer pushes items / pairs values
+    template<typename Queue>
+    void transfer(benchmark::State& state, size_t pairs)
+    {
+        for (auto _ : state) {
+            Queue q{ slots };
+            std::atomic<std::uint64_t> checksum{ 0 };
+            bench::run_threads(2 * pairs, [&](size_t i) {
+                const std::uint64_t count = items / pairs;
+                if (i < pairs) {
+                    for (std::uint64_t k = 0; k < count;) {
+                        if (q.try_push(k)) {
+                            ++k;
+                        }
+                        else {
+                            std::this_thread::yield();
+                        }
+                    }
+                    return;
+                }
+                std::uint64_t sum = 0;
+                for (std::uint64_t k = 0; k < count;) {
+                    if (auto value = q.try_pop()) {
+                        sum += *value;
+                        ++k;
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                }
+                checksum += sum;
+            });
+            benchmark::DoNotOptimize(checksum.load());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(items));
+    }
+
+    template<typename Queue>
+    void transfer_batched(benchmark::State& state, size_t batch)
+    {
+        for (auto _ : state) {
+            Queue q{ slots };
+            std::uint64_t checksum = 0;
+            bench::run_threads(2, [&](size_t i) {
+                for (std::uint64_t k = 0; k < items;) {
+                    if (i == 0) {
+                        auto reservation = q.reserve_push(std::min<std::uint64_t>(batch, items - k));
+                        for (auto* span : { &reservation.first, &reservation.second }) {
+                            for (auto& slot : *span) {
+                                slot = k++;
+                            }
+                        }
+                        q.commit_push(reservation);
+                        if (reservation.size() == 0) {
+                            std::this_thread::yield();
+                        }
+                    }
+                    else {
+                        auto reservation = q.reserve_pop(batch);
+                        for (auto* span : { &reservation.first, &reservation.second }) {
+                            for (auto value : *span) {
+                                checksum += value;
+                            }
+                        }
+                        q.commit_pop(reservation);
+                        k += reservation.size();
+                        if (reservation.size() == 0) {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+            });
+            benchmark::DoNotOptimize(checksum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(items));
+    }
+
+    template<typename Queue>
+    void round_trips(benchmark::State& state)
+    {
+        Queue ping{ slots };
+        Queue pong{ slots };
+        std::atomic<bool> done{ false };
+        std::thread echo{ [&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                if (auto value = ping.try_pop()) {
+                    while (!pong.try_push(*value)) {}
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        } };
+        std::uint64_t k = 0;
+        for (auto _ : state) {
+            while (!ping.try_push(k)) {}
+            std::optional<std::uint64_t> value;
+            while (!(value = pong.try_pop())) {
+                std::this_thread::yield();
+            }
+            ++k;
+        }
+        done = true;
+        echo.join();
+    }
+}
+
+void BM_SpscTransfer(benchmark::State& state) { transfer<SpscRingBuffer<std::uint64_t>>(state, 1); }
+BENCHMARK(BM_SpscTransfer)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_SpscTransferBatched(benchmark::State& state) { transfer_batched<SpscRingBuffer<std::uint64_t>>(state, static_cast<size_t>(state.range(0))); }
+BENCHMARK(BM_SpscTransferBatched)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_MpmcTransfer(benchmark::State& state) { transfer<MpmcRingBuffer<std::uint64_t>>(state, static_cast<size_t>(state.range(0))); }
+BENCHMARK(BM_MpmcTransfer)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_MpmcTransferBatched(benchmark::State& state) { transfer_batched<MpmcRingBuffer<std::uint64_t>>(state, static_cast<size_t>(state.range(0))); }
+BENCHMARK(BM_MpmcTransferBatched)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_MutexDequeTransfer(benchmark::State& state) { transfer<MutexDeque>(state, static_cast<size_t>(state.range(0))); }
+BENCHMARK(BM_MutexDequeTransfer)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_SpscRoundTrip(benchmark::State& state) { round_trips<SpscRingBuffer<std::uint64_t>>(state); }
+BENCHMARK(BM_SpscRoundTrip)->UseRealTime();
+
+void BM_MpmcRoundTrip(benchmark::State& state) { round_trips<MpmcRingBuffer<std::uint64_t>>(state); }
+BENCHMARK(BM_MpmcRoundTrip)->UseRealTime();
+
+void BM_MutexDequeRoundTrip(benchmark::State& state) { round_trips<MutexDeque>(state); }
+BENCHMARK(BM_MutexDequeRoundTrip)->UseRealTime();
@@ -0,0 +1,119 @@
+#include "bench.hpp"
+
+#include <Containers2/mapped_vector.hpp>
+#include <Containers2/serialization.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+using namespace containers2;
+
+// opening a serialized table, rows of 64 32-bit values filling each cache size, and summing the first value of every
+// row: in place with only the header checks (trusted), in place after validating every row offset, and by
+// deserializing into a Vector per row, as a format that must be parsed would
+
+namespace {
+    constexpr size_t row_size = 64;
+
+    void table_sizes(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            b->Arg(bytes);
+        }
+    }
+
+    size_t row_count(const benchmark::State& state)
+    {
+        return std::max<size_t>(static_cast<size_t>(state.range(0)) / (row_size * sizeof(std::uint32_t)), 1);
+    }
+
+    void write_table(std::ostream& out, size_t rows)
+    {
+        SerialWriter writer{ out };
+        Vector<std::uint32_t> row(row_size, uninitialized_tag);
+        Vector<SerialHandle<std::uint32_t>> handles(rows, uninitialized_tag);
+        for (size_t i = 0; i < rows; ++i) {
+            std::iota(row.begin(), row.end(), static_cast<std::uint32_t>(i));
+            handles[i] = writer.write<std::uint32_t>(row);
+        }
+        writer.finish(writer.write<std::uint32_t>(handles));
+    }
+
+    Vector<std::byte> table(const benchmark::State& state)
+    {
+        std::ostringstream out;
+        write_table(out, row_count(state));
+        const std::string s = out.str();
+        Vector<std::byte> buffer(s.size(), uninitialized_tag);
+        std::memcpy(buffer.data(), s.data(), s.size());
+        return buffer;
+    }
+
+    std::uint64_t first_values(const SerializedVector<SerializedVector<std::uint32_t>>& rows)
+    {
+        std::uint64_t sum = 0;
+        for (const auto& row : rows) {
+            sum += row[0];
+        }
+        return sum;
+    }
+}
+
+void BM_SerializedOpenTrusted(benchmark::State& state)
+{
+    const Vector<std::byte> buffer = table(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first_values(open_serialized_trusted<SerializedVector<std::uint32_t>>(buffer)));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(row_count(state)));
+}
+BENCHMARK(BM_SerializedOpenTrusted)->Apply(table_sizes);
+
+void BM_SerializedOpenValidated(benchmark::State& state)
+{
+    const Vector<std::byte> buffer = table(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first_values(open_serialized<SerializedVector<std::uint32_t>>(buffer)));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(row_count(state)));
+}
+BENCHMARK(BM_SerializedOpenValidated)->Apply(table_sizes);
+
+// copies every row out of the buffer
+void BM_DeserializeToVectors(benchmark::State& state)
+{
+    const Vector<std::byte> buffer = table(state);
+    for (auto _ : state) {
+        const auto& rows = open_serialized<SerializedVector<std::uint32_t>>(buffer);
+        Vector<Vector<std::uint32_t>> copy(rows.size());
+        std::uint64_t sum = 0;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            copy[i] = Vector<std::uint32_t>(rows[i].size(), uninitialized_tag);
+            std::copy(rows[i].begin(), rows[i].end(), copy[i].begin());
+            sum += copy[i][0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(row_count(state)));
+}
+BENCHMARK(BM_DeserializeToVectors)->Apply(table_sizes);
+
+// from a file: mapping, validation and the first touch of every row's page
+void BM_SerializedOpenMapped(benchmark::State& state)
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "containers2_bench_serialized.bin";
+    {
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        write_table(file, row_count(state));
+    }
+    for (auto _ : state) {
+        const MappedVector<const std::byte> mapped{ path };
+        benchmark::DoNotOptimize(first_values(open_serialized<SerializedVector<std::uint32_t>>(mapped)));
+    }
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(row_count(state)));
+}
+BENCHMARK(BM_SerializedOpenMapped)->Apply(table_sizes);
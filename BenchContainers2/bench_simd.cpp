@@ -0,0 +1,134 @@
+#include "bench.hpp"
+
+#include <Containers2/simd.hpp>
+
+#include <functional>
+
+using namespace containers2;
+
+namespace {
+    // second argument: the instruction set, runs above the detected one are skipped
+    template<typename T>
+    void isa_counts(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            for (int isa = 0; isa <= static_cast<int>(simd::Isa::avx512); ++isa) {
+                b->Args({ bytes / static_cast<std::int64_t>(sizeof(T)), isa });
+            }
+        }
+    }
+
+    bool set_isa(benchmark::State& state, simd::Isa& isa)
+    {
+        const char* names[]{ "scalar", "sse2", "avx2", "avx512" };
+        isa = static_cast<simd::Isa>(state.range(1));
+        if (isa > simd::detected_isa()) {
+            state.SkipWithError("instruction set not supported by this CPU");
+            return false;
+        }
+        state.SetLabel(names[state.range(1)]);
+        return true;
+    }
+}
+
+template<typename T>
+void BM_SimdFill(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    Vector<T> v(static_cast<size_t>(state.range(0)), uninitialized_tag);
+    for (auto _ : state) {
+        simd::fill(VectorView<T>{ v }, T{ 3 }, isa);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_SimdFill, float)->Apply(isa_counts<float>);
+BENCHMARK_TEMPLATE(BM_SimdFill, std::int32_t)->Apply(isa_counts<std::int32_t>);
+
+template<typename T>
+void BM_SimdSum(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    Vector<T> v(static_cast<size_t>(state.range(0)), T{ 1 }, initialized_tag);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::sum(VectorView<const T>{ v }, isa));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_SimdSum, float)->Apply(isa_counts<float>);
+BENCHMARK_TEMPLATE(BM_SimdSum, std::int32_t)->Apply(isa_counts<std::int32_t>);
+BENCHMARK_TEMPLATE(BM_SimdSum, std::uint8_t)->Apply(isa_counts<std::uint8_t>);
+
+template<typename T>
+void BM_SimdMin(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    Vector<T> v(static_cast<size_t>(state.range(0)), T{ 1 }, initialized_tag);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::min(VectorView<const T>{ v }, isa));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_SimdMin, float)->Apply(isa_counts<float>);
+BENCHMARK_TEMPLATE(BM_SimdMin, std::int32_t)->Apply(isa_counts<std::int32_t>);
+
+template<typename T>
+void BM_SimdDot(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    Vector<T> a(static_cast<size_t>(state.range(0)), T{ 1 }, initialized_tag);
+    Vector<T> b(static_cast<size_t>(state.range(0)), T{ 2 }, initialized_tag);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::dot(VectorView<const T>{ a }, VectorView<const T>{ b }, isa));
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * bench::bytes<T>(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_SimdDot, float)->Apply(isa_counts<float>);
+BENCHMARK_TEMPLATE(BM_SimdDot, double)->Apply(isa_counts<double>);
+
+template<typename T>
+void BM_SimdCount(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    Vector<T> v(static_cast<size_t>(state.range(0)), T{ 1 }, initialized_tag);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::count(VectorView<const T>{ v }, T{ 1 }, isa));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::bytes<T>(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_SimdCount, std::uint8_t)->Apply(isa_counts<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_SimdCount, std::int32_t)->Apply(isa_counts<std::int32_t>);
+
+template<typename T>
+void BM_SimdCompare(benchmark::State& state)
+{
+    simd::Isa isa;
+    if (!set_isa(state, isa)) {
+        return;
+    }
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<T> a(n, T{ 1 }, initialized_tag);
+    Vector<T> b(n, T{ 2 }, initialized_tag);
+    Vector<bool> out(n, uninitialized_tag);
+    for (auto _ : state) {
+        simd::compare(VectorView<const T>{ a }, VectorView<const T>{ b }, VectorView<bool>{ out }, std::less<>{}, isa);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * bench::bytes<T>(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_SimdCompare, float)->Apply(isa_counts<float>);
@@ -0,0 +1,75 @@
+#include "bench.hpp"
+
+#include <Containers2/small_vector.hpp>
+
+#include <vector>
+
+using namespace containers2;
+
+// many short-lived small buffers: SmallVector<int, 16> stays inline up to 16 elements and spills past that
+
+namespace {
+    void small_sizes(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t n : { 4, 16, 64 }) {
+            b->Arg(n);
+        }
+    }
+
+    template<typename Container>
+    void fill_and_sum(benchmark::State& state)
+    {
+        const size_t n = static_cast<size_t>(state.range(0));
+        for (auto _ : state) {
+            Container v(n, 1);
+            int sum = 0;
+            for (int x : v) {
+                sum += x;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+void BM_SmallVectorCreate(benchmark::State& state) { fill_and_sum<SmallVector<int, 16>>(state); }
+BENCHMARK(BM_SmallVectorCreate)->Apply(small_sizes);
+
+void BM_InlineVectorCreate(benchmark::State& state) { fill_and_sum<InlineVector<int, 64>>(state); }
+BENCHMARK(BM_InlineVectorCreate)->Apply(small_sizes);
+
+void BM_VectorCreate(benchmark::State& state) { fill_and_sum<Vector<int>>(state); }
+BENCHMARK(BM_VectorCreate)->Apply(small_sizes);
+
+void BM_StdVectorCreate(benchmark::State& state) { fill_and_sum<std::vector<int>>(state); }
+BENCHMARK(BM_StdVectorCreate)->Apply(small_sizes);
+
+// growth element by element from empty
+void BM_SmallVectorGrow(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        SmallVector<int, 16> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.resize(i + 1, uninitialized_tag);
+            v[i] = static_cast<int>(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SmallVectorGrow)->Apply(small_sizes);
+
+void BM_StdVectorGrow(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<int> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdVectorGrow)->Apply(small_sizes);
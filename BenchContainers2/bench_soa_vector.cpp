@@ -0,0 +1,81 @@
+#include "bench.hpp"
+
+#include <Containers2/soa_vector.hpp>
+
+#include <tuple>
+
+using namespace containers2;
+
+// scanning one field of a 32-byte record: SoA reads only that column, AoS drags the whole record through the cache
+
+namespace {
+    struct Particle
+    {
+        float x, y, z;
+        float mass;
+        std::uint64_t id;
+        std::uint64_t flags;
+    };
+}
+
+void BM_SoAScanField(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    SoAVector<float, float, float, float, std::uint64_t, std::uint64_t> particles{ n, std::tuple{ 0.0f, 0.0f, 0.0f, 1.0f, std::uint64_t{ 0 }, std::uint64_t{ 0 } } };
+    for (auto _ : state) {
+        float sum = 0;
+        for (float mass : particles.column<3>()) {
+            sum += mass;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SoAScanField)->Apply(bench::element_counts<Particle>);
+
+void BM_AoSScanField(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<Particle> particles(n, Particle{ 0, 0, 0, 1, 0, 0 }, initialized_tag);
+    for (auto _ : state) {
+        float sum = 0;
+        for (const Particle& p : particles) {
+            sum += p.mass;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AoSScanField)->Apply(bench::element_counts<Particle>);
+
+// whole-record access, where AoS has the locality
+void BM_SoAScanRecord(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    SoAVector<float, float, float, float, std::uint64_t, std::uint64_t> particles{ n, std::tuple{ 1.0f, 1.0f, 1.0f, 1.0f, std::uint64_t{ 1 }, std::uint64_t{ 1 } } };
+    for (auto _ : state) {
+        const auto [x, y, z, mass, id, flags] = particles.columns();
+        std::uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += static_cast<std::uint64_t>(x[i] + y[i] + z[i] + mass[i]) + id[i] + flags[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SoAScanRecord)->Apply(bench::element_counts<Particle>);
+
+void BM_AoSScanRecord(benchmark::State& state)
+{
+    const size_t n = static_cast<size_t>(state.range(0));
+    Vector<Particle> particles(n, Particle{ 1, 1, 1, 1, 1, 1 }, initialized_tag);
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const Particle& p : particles) {
+            sum += static_cast<std::uint64_t>(p.x + p.y + p.z + p.mass) + p.id + p.flags;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AoSScanRecord)->Apply(bench::element_counts<Particle>);
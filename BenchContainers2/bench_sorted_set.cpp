@@ -0,0 +1,94 @@
+#include "bench.hpp"
+
+#include <Containers2/sorted_set.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace containers2;
+
+// searches of random 32-bit values among distinct sorted keys filling each cache size: std::lower_bound on the sorted
+// Vector against every SortedSet layout, one query at a time and in batches
+
+namespace {
+    constexpr size_t query_count = 1 << 16;
+
+    // second argument: the layout
+    void counts_and_layouts(benchmark::internal::Benchmark* b)
+    {
+        for (std::int64_t bytes : bench::cache_sizes()) {
+            for (SortedLayout layout : { SortedLayout::sorted, SortedLayout::eytzinger, SortedLayout::btree }) {
+                b->Args({ bytes / static_cast<std::int64_t>(sizeof(std::uint32_t)), static_cast<std::int64_t>(layout) });
+            }
+        }
+    }
+
+    // the even numbers below 2n: half of the queries hit
+    Vector<std::uint32_t> even_keys(size_t n)
+    {
+        Vector<std::uint32_t> keys(n, uninitialized_tag);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = static_cast<std::uint32_t>(2 * i);
+        }
+        return keys;
+    }
+
+    Vector<std::uint32_t> random_queries(size_t n)
+    {
+        std::mt19937 random{ 1 };
+        std::uniform_int_distribution<std::uint32_t> value{ 0, static_cast<std::uint32_t>(2 * n - 1) };
+        Vector<std::uint32_t> queries(query_count, uninitialized_tag);
+        for (auto& query : queries) {
+            query = value(random);
+        }
+        return queries;
+    }
+
+    SortedSet<std::uint32_t> sorted_set(benchmark::State& state)
+    {
+        const char* names[]{ "sorted", "eytzinger", "btree" };
+        state.SetLabel(names[state.range(1)]);
+        return SortedSet<std::uint32_t>{ even_keys(static_cast<size_t>(state.range(0))), sorted_unique_tag, static_cast<SortedLayout>(state.range(1)) };
+    }
+}
+
+void BM_StdLowerBound(benchmark::State& state)
+{
+    const Vector<std::uint32_t> keys = even_keys(static_cast<size_t>(state.range(0)));
+    const Vector<std::uint32_t> queries = random_queries(keys.size());
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lower_bound(keys.begin(), keys.end(), queries[i]));
+        i = (i + 1) % query_count;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdLowerBound)->Apply(bench::element_counts<std::uint32_t>);
+
+void BM_SortedSetLowerBound(benchmark::State& state)
+{
+    const SortedSet<std::uint32_t> set = sorted_set(state);
+    const Vector<std::uint32_t> queries = random_queries(set.size());
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(set.lower_bound(queries[i]));
+        i = (i + 1) % query_count;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SortedSetLowerBound)->Apply(counts_and_layouts);
+
+// all the queries through the batched search
+
+void BM_SortedSetBatchedLowerBound(benchmark::State& state)
+{
+    const SortedSet<std::uint32_t> set = sorted_set(state);
+    const Vector<std::uint32_t> queries = random_queries(set.size());
+    Vector<size_t> ranks(query_count, uninitialized_tag);
+    for (auto _ : state) {
+        set.lower_bound(queries, ranks);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+}
+BENCHMARK(BM_SortedSetBatchedLowerBound)->Apply(counts_and_layouts);
@@ -0,0 +1,211 @@
+#include "bench.hpp"
+
+#include <Containers2/vector_of_vectors.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <utility>
+
+using namespace containers2;
+
+// an adjacency list of 32-bit vertex ids filling each cache size, 1 to 31 neighbours per vertex (16 on average), as
+// a VectorOfVectors and as a Vector<Vector<std::uint32_t>>: building it row by row, grouping it from unordered
+// (source, target) edges, and summing every neighbour. Items processed count the edges; bytes_per_edge counts the
+// element and bookkeeping bytes (not the allocator's headers, which the nested Vectors pay once per row).
+
+namespace {
+    constexpr size_t average_degree = 16;
+
+    size_t edge_count(const benchmark::State& state)
+    {
+        return static_cast<size_t>(state.range(0));
+    }
+
+    struct Graph
+    {
+        Vector<std::uint32_t> degrees;
+        Vector<std::pair<size_t, std::uint32_t>> edges; // shuffled
+
+        explicit Graph(size_t edge_count)
+        {
+            std::mt19937_64 random{ 42 };
+            const size_t vertices = std::max<size_t>(edge_count / average_degree, 1);
+            degrees = Vector<std::uint32_t>(vertices, uninitialized_tag);
+            size_t n = 0;
+            for (auto& degree : degrees) {
+                degree = static_cast<std::uint32_t>(1 + random() % (2 * average_degree - 1));
+                n += degree;
+            }
+            edges = Vector<std::pair<size_t, std::uint32_t>>(n, uninitialized_tag);
+            size_t e = 0;
+            for (size_t v = 0; v < vertices; ++v) {
+                for (std::uint32_t k = 0; k < degrees[v]; ++k) {
+                    edges[e++] = { v, static_cast<std::uint32_t>(random() % vertices) };
+                }
+            }
+            std::shuffle(edges.begin(), edges.end(), random);
+        }
+
+        size_t vertices() const { return degrees.size(); }
+    };
+
+    VectorOfVectors<std::uint32_t> build_jagged(const Graph& graph)
+    {
+        VectorOfVectors<std::uint32_t> jagged;
+        for (size_t v = 0; v < graph.vertices(); ++v) {
+            const VectorView<std::uint32_t> row = jagged.push_back(graph.degrees[v], uninitialized_tag);
+            std::iota(row.begin(), row.end(), static_cast<std::uint32_t>(v));
+        }
+        return jagged;
+    }
+
+    Vector<Vector<std::uint32_t>> build_nested(const Graph& graph)
+    {
+        Vector<Vector<std::uint32_t>> nested(graph.vertices());
+        for (size_t v = 0; v < graph.vertices(); ++v) {
+            nested[v] = Vector<std::uint32_t>(graph.degrees[v], uninitialized_tag);
+            std::iota(nested[v].begin(), nested[v].end(), static_cast<std::uint32_t>(v));
+        }
+        return nested;
+    }
+
+    void set_memory(benchmark::State& state, const VectorOfVectors<std::uint32_t>& jagged)
+    {
+        const size_t bytes = jagged.values_.capacity() * sizeof(std::uint32_t) + jagged.offsets_.capacity() * sizeof(size_t);
+        state.counters["bytes_per_edge"] = static_cast<double>(bytes) / static_cast<double>(jagged.element_count());
+        state.counters["allocations"] = 2;
+    }
+
+    void set_memory(benchmark::State& state, const Vector<Vector<std::uint32_t>>& nested)
+    {
+        size_t bytes = nested.capacity() * sizeof(Vector<std::uint32_t>);
+        size_t edges = 0;
+        for (const auto& row : nested) {
+            bytes += row.capacity() * sizeof(std::uint32_t);
+            edges += row.size();
+        }
+        state.counters["bytes_per_edge"] = static_cast<double>(bytes) / static_cast<double>(edges);
+        state.counters["allocations"] = static_cast<double>(nested.size() + 1);
+    }
+}
+
+void BM_VectorOfVectorsBuild(benchmark::State& state)
+{
+    const Graph graph{ edge_count(state) };
+    for (auto _ : state) {
+        const VectorOfVectors<std::uint32_t> jagged = build_jagged(graph);
+        benchmark::DoNotOptimize(jagged.values().data());
+    }
+    set_memory(state, build_jagged(graph));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graph.edges.size()));
+}
+BENCHMARK(BM_VectorOfVectorsBuild)->Apply(bench::element_counts<std::uint32_t>);
+
+void BM_NestedVectorBuild(benchmark::State& state)
+{
+    const Graph graph{ edge_count(state) };
+    for (auto _ : state) {
+        const Vector<Vector<std::uint32_t>> nested = build_nested(graph);
+        benchmark::DoNotOptimize(nested.data());
+    }
+    set_memory(state, build_nested(graph));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graph.edges.size()));
+}
+BENCHMARK(BM_NestedVectorBuild)->Apply(bench::element_counts<std::uint32_t>);
+
+// counting sort of the shuffled edges by source
+void BM_VectorOfVectorsGroup(benchmark::State& state)
+{
+    const Graph graph{ edge_count(state) };
+    for (auto _ : state) {
+        const VectorOfVectors<std::uint32_t> jagged{ graph.vertices(), graph.edges };
+        benchmark::DoNotOptimize(jagged.values().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graph.edges.size()));
+}
+BENCHMARK(BM_VectorOfVectorsGroup)->Apply(bench::element_counts<std::uint32_t>);
+
+// the same counting pass, then one Vector per source
+void BM_NestedVectorGroup(benchmark::State& state)
+{
+    const Graph graph{ edge_count(state) };
+    for (auto _ : state) {
+        Vector<size_t> degrees(graph.vertices(), size_t{ 0 });
+        for (const auto& edge : graph.edges) {
+            ++degrees[edge.first];
+        }
+        Vector<Vector<std::uint32_t>> nested(graph.vertices());
+        for (size_t v = 0; v < graph.vertices(); ++v) {
+            nested[v] = Vector<std::uint32_t>(degrees[v], uninitialized_tag);
+            degrees[v] = 0;
+        }
+        for (const auto& [source, target] : graph.edges) {
+            nested[source][degrees[source]++] = target;
+        }
+        benchmark::DoNotOptimize(nested.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graph.edges.size()));
+}
+BENCHMARK(BM_NestedVectorGroup)->Apply(bench::element_counts<std::uint32_t>);
+
+void BM_VectorOfVectorsScan(benchmark::State& state)
+{
+    const Graph graph{ edge_count(state) };
+    const VectorOfVectors<std::uint32_t> jagged = build_jagged(graph);
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (size_t v = 0; v < jagged.size(); ++v) {
+            for (std::uint32_t x : jagged[v]) {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graph.edges.size()));
+}
+BENCHMARK(BM_VectorOfVectorsScan)->Apply(bench::element_counts<std::uint32_t>);
+
+void BM_NestedVectorScan(benchmark::State& state)
+{
+    const Graph graph{ edge_count(state) };
+    const Vector<Vector<std::uint32_t>> nested = build_nested(graph);
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& row : nested) {
+            for (std::uint32_t x : row) {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graph.edges.size()));
+}
+BENCHMARK(BM_NestedVectorScan)->Apply(bench::element_counts<std::uint32_t>);
+
+// the same scan through parallel::for_each_row, by thread count, at twice the last level cache
+void BM_VectorOfVectorsParallelScan(benchmark::State& state)
+{
+    static std::map<std::int64_t, std::unique_ptr<ThreadPool>> pools;
+    auto& pool = pools[state.range(0)];
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(static_cast<size_t>(state.range(0)));
+    }
+    const Graph graph{ static_cast<size_t>(bench::cache_sizes().back()) / sizeof(std::uint32_t) };
+    const VectorOfVectors<std::uint32_t> jagged = build_jagged(graph);
+    Vector<std::uint64_t> sums(jagged.size(), uninitialized_tag);
+    for (auto _ : state) {
+        parallel::for_each_row(jagged, [&](size_t v, VectorView<const std::uint32_t> row) {
+            std::uint64_t sum = 0;
+            for (std::uint32_t x : row) {
+                sum += x;
+            }
+            sums[v] = sum;
+        }, *pool);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graph.edges.size()));
+}
+BENCHMARK(BM_VectorOfVectorsParallelScan)->Apply(bench::thread_counts)->UseRealTime();
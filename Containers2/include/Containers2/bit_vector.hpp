@@ -0,0 +1,492 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+#include <Containers2/simd.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    // Bits are packed in 64-bit words, bit i in word i / 64 at position i % 64. Bits past size() in the last word are
+    // always zero: BitVector and every operation below keep it that way, views built over raw words must respect it.
+    // Views always start on a word boundary.
+    using BitWord = std::uint64_t;
+
+    inline constexpr size_t bits_per_word = 64;
+
+    inline constexpr size_t bit_word_count(size_t bits) noexcept { return (bits + bits_per_word - 1) / bits_per_word; }
+
+    // B is bool or const bool: like VectorView<const T>, BitVectorView<const bool> is read-only and
+    // BitVectorView<bool> derives from it adding the mutators
+    template<typename B = bool>
+    struct BitVectorView;
+
+    template<typename B = bool>
+    struct BitVector;
+
+    template<typename B> requires(std::is_same_v<B, const bool>)
+    struct BitVectorView<B>
+    {
+        const BitWord* words_ = nullptr;
+        size_t size_ = 0;
+
+        BitVectorView(const BitWord* words, size_t s) noexcept : words_{ words }, size_{ s } {}
+
+        BitVectorView() noexcept = default;
+
+        BitVectorView(const BitVectorView&) noexcept = default;
+        BitVectorView& operator = (const BitVectorView&) & noexcept = default;
+
+        BitVectorView(BitVectorView&&) noexcept = default;
+        BitVectorView& operator = (BitVectorView&&) & noexcept = default;
+
+        ~BitVectorView() noexcept = default;
+
+        template<OwningContainerRvalue C>
+        BitVectorView(C&&) = delete;
+        template<OwningContainerRvalue C>
+        BitVectorView& operator = (C&&) = delete;
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        size_t word_count() const noexcept { return bit_word_count(size_); }
+        const BitWord* data() const noexcept { return words_; }
+        VectorView<const BitWord> words() const noexcept { return { words_, words_ + word_count() }; }
+
+        bool operator[](size_t index) const noexcept { return (words_[index / bits_per_word] >> (index % bits_per_word)) & 1; }
+        bool test(size_t index) const noexcept { return (*this)[index]; }
+    };
+
+    template<typename B> requires(std::is_same_v<B, bool>)
+    struct BitVectorView<B> : BitVectorView<const B>
+    {
+        using super = BitVectorView<const B>;
+        using super::words_;
+        using super::size_;
+
+        BitVectorView(BitWord* words, size_t s) noexcept : super{ words, s } {}
+
+        BitVectorView() noexcept = default;
+
+        BitVectorView(const BitVectorView&) noexcept = default;
+        BitVectorView& operator = (const BitVectorView&) & noexcept = default;
+
+        BitVectorView(BitVectorView&&) noexcept = default;
+        BitVectorView& operator = (BitVectorView&&) & noexcept = default;
+
+        ~BitVectorView() noexcept = default;
+
+        template<OwningContainerRvalue C>
+        BitVectorView(C&&) = delete;
+        template<OwningContainerRvalue C>
+        BitVectorView& operator = (C&&) = delete;
+
+        using super::size;
+        using super::word_count;
+        using super::operator[];
+
+        BitWord* data() const noexcept { return const_cast<BitWord*>(words_); }
+        VectorView<BitWord> words() const noexcept { return { data(), data() + word_count() }; }
+
+        void set(size_t index, bool value = true) const noexcept
+        {
+            BitWord& word = data()[index / bits_per_word];
+            const BitWord mask = BitWord{ 1 } << (index % bits_per_word);
+            word = value ? word | mask : word & ~mask;
+        }
+
+        void reset(size_t index) const noexcept { set(index, false); }
+        void flip(size_t index) const noexcept { data()[index / bits_per_word] ^= BitWord{ 1 } << (index % bits_per_word); }
+
+        void fill(bool value) const noexcept
+        {
+            std::fill(data(), data() + word_count(), value ? ~BitWord{ 0 } : 0);
+            if (value && size_ % bits_per_word != 0) {
+                data()[word_count() - 1] = (BitWord{ 1 } << (size_ % bits_per_word)) - 1;
+            }
+        }
+    };
+
+    // Owning bit container with Vector's ownership rules: move-only, BitVector<const bool> is built by moving a
+    // BitVector<bool> and cannot be modified. The words live in a Vector<BitWord>, so growth goes through realloc.
+    template<typename B>
+    struct BitVector : BitVectorView<B>
+    {
+        static_assert(std::is_same_v<std::remove_const_t<B>, bool>, "BitVector holds bool or const bool");
+
+        using super = BitVectorView<B>;
+        using super::words_;
+        using super::size_;
+
+        Vector<BitWord> storage_;
+
+        BitVector() noexcept = default;
+
+        // the bits are unspecified, except for those past size() in the last word
+        explicit BitVector(size_t s, uninitialized_tag_t = uninitialized_tag) requires(!std::is_const_v<B>) :
+            super{ nullptr, s }, storage_{ bit_word_count(s), uninitialized_tag }
+        {
+            words_ = storage_.data();
+            clear_tail();
+        }
+
+        BitVector(size_t s, bool value, initialized_tag_t = initialized_tag) requires(!std::is_const_v<B>) : BitVector(s, uninitialized_tag)
+        {
+            this->fill(value);
+        }
+
+        // non-copyable
+        BitVector(const BitVector&) = delete;
+        BitVector& operator = (const BitVector&) = delete;
+
+        BitVector(BitVector&& rhs) noexcept :
+            super{ std::exchange(static_cast<super&>(rhs), {}) }, storage_{ std::move(rhs.storage_) } {}
+
+        BitVector& operator = (BitVector&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                super::operator =(std::exchange(static_cast<super&>(rhs), {}));
+                storage_ = std::move(rhs.storage_);
+            }
+            return *this;
+        }
+
+        BitVector(BitVector<bool>&& rhs) noexcept requires(std::is_const_v<B>) :
+            super{ std::exchange(static_cast<BitVectorView<bool>&>(rhs), {}) }, storage_{ std::move(rhs.storage_) } {}
+
+        BitVector& operator = (BitVector<bool>&& rhs) & noexcept requires(std::is_const_v<B>)
+        {
+            super::operator =(std::exchange(static_cast<BitVectorView<bool>&>(rhs), {}));
+            storage_ = std::move(rhs.storage_);
+            return *this;
+        }
+
+        ~BitVector() noexcept = default;
+
+        // in bits
+        size_t capacity() const noexcept { return storage_.capacity() * bits_per_word; }
+
+        void reserve(size_t c) requires(!std::is_const_v<B>)
+        {
+            storage_.reserve(bit_word_count(c));
+            words_ = storage_.data();
+        }
+
+        void shrink_to_fit() requires(!std::is_const_v<B>)
+        {
+            storage_.shrink_to_fit();
+            words_ = storage_.data();
+        }
+
+        // preserving, geometric growth like Vector: new bits are set to value
+        void resize(size_t s, bool value = false) requires(!std::is_const_v<B>)
+        {
+            const size_t old_size = size_;
+            const size_t old_words = storage_.size();
+            storage_.resize(bit_word_count(s), value ? ~BitWord{ 0 } : 0, initialized_tag);
+            words_ = storage_.data();
+            size_ = s;
+            if (s > old_size && value && old_size % bits_per_word != 0) {
+                // the new bits of the old last word
+                storage_[old_words - 1] |= ~BitWord{ 0 } << (old_size % bits_per_word);
+            }
+            clear_tail();
+        }
+
+        void push_back(bool value) requires(!std::is_const_v<B>)
+        {
+            if (size_ % bits_per_word == 0) {
+                storage_.resize(storage_.size() + 1, 0, initialized_tag);
+                words_ = storage_.data();
+            }
+            const size_t index = size_++;
+            storage_[index / bits_per_word] |= BitWord{ value } << (index % bits_per_word);
+        }
+
+        void clear() noexcept requires(!std::is_const_v<B>)
+        {
+            storage_.resize(0);
+            size_ = 0;
+        }
+
+    private:
+        void clear_tail() noexcept
+        {
+            if (size_ % bits_per_word != 0) {
+                storage_[storage_.size() - 1] &= (BitWord{ 1 } << (size_ % bits_per_word)) - 1;
+            }
+        }
+    };
+
+    template<typename B>
+    inline constexpr bool is_owning_container_v<BitVector<B>> = true;
+
+    namespace detail {
+
+        // simd::detail::dispatch kernels over words
+
+        enum class BitOperation { and_, or_, xor_, andnot };
+
+        template<BitOperation Op>
+        struct BitwiseKernel
+        {
+            // a = a op b, in place so that no vector crosses a call boundary by value
+            template<typename W>
+            CONTAINERS2_SIMD_INLINE static void apply(W& a, const W& b)
+            {
+                if constexpr (Op == BitOperation::and_) {
+                    a &= b;
+                }
+                else if constexpr (Op == BitOperation::or_) {
+                    a |= b;
+                }
+                else if constexpr (Op == BitOperation::xor_) {
+                    a ^= b;
+                }
+                else {
+                    a &= ~b;
+                }
+            }
+
+            template<size_t Bytes>
+            CONTAINERS2_SIMD_INLINE static void run(const BitWord* a, const BitWord* b, BitWord* out, size_t n)
+            {
+                size_t i = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    // dependent on Bytes, or GCC drops the attribute
+                    typedef std::conditional_t<Bytes != 0, BitWord, void> V __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = simd::detail::lanes<Bytes, BitWord>;
+                    for (; i + L <= n; i += L) {
+                        V va;
+                        V vb;
+                        std::memcpy(&va, a + i, sizeof(V));
+                        std::memcpy(&vb, b + i, sizeof(V));
+                        apply(va, vb);
+                        std::memcpy(out + i, &va, sizeof(V));
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    BitWord r = a[i];
+                    apply(r, b[i]);
+                    out[i] = r;
+                }
+            }
+        };
+
+        // Vector instruction sets below AVX-512 VPOPCNTDQ have no popcount: bytes are counted with the shift-and-mask
+        // reduction in every lane, summed bytewise over up to 31 words (31 * 8 < 256) and only then widened to 64 bits.
+        struct PopcountKernel
+        {
+            template<size_t Bytes>
+            CONTAINERS2_SIMD_INLINE static size_t run(const BitWord* p, size_t n)
+            {
+                size_t i = 0;
+                size_t result = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    // dependent on Bytes, or GCC drops the attribute
+                    typedef std::conditional_t<Bytes != 0, BitWord, void> V __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = simd::detail::lanes<Bytes, BitWord>;
+                    const V m1 = V{} + 0x5555555555555555;
+                    const V m2 = V{} + 0x3333333333333333;
+                    const V m4 = V{} + 0x0f0f0f0f0f0f0f0f;
+                    const V m8 = V{} + 0x00ff00ff00ff00ff;
+                    const V m16 = V{} + 0x0000ffff0000ffff;
+                    const V m32 = V{} + 0x00000000ffffffff;
+                    V total{};
+                    while (i + L <= n) {
+                        V bytes{};
+                        for (size_t block = 0; block < 31 && i + L <= n; ++block, i += L) {
+                            V v;
+                            std::memcpy(&v, p + i, sizeof(V));
+                            v = v - ((v >> 1) & m1);
+                            v = (v & m2) + ((v >> 2) & m2);
+                            bytes += (v + (v >> 4)) & m4;
+                        }
+                        bytes = (bytes & m8) + ((bytes >> 8) & m8);
+                        bytes = (bytes & m16) + ((bytes >> 16) & m16);
+                        total += (bytes & m32) + (bytes >> 32);
+                    }
+                    for (size_t l = 0; l < L; ++l) {
+                        result += static_cast<size_t>(total[l]);
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result += static_cast<size_t>(std::popcount(p[i]));
+                }
+                return result;
+            }
+        };
+
+        template<BitOperation Op>
+        void bitwise(BitVectorView<bool> out, BitVectorView<const bool> a, BitVectorView<const bool> b, simd::Isa isa)
+        {
+            simd::detail::dispatch<BitwiseKernel<Op>>(isa, a.data(), b.data(), out.data(), out.word_count());
+        }
+
+        // position of the k-th set bit of word (k < popcount(word)): the bytes' prefix popcounts locate its byte
+        inline size_t select_in_word(BitWord word, size_t k) noexcept
+        {
+            BitWord counts = word - ((word >> 1) & 0x5555555555555555);
+            counts = (counts & 0x3333333333333333) + ((counts >> 2) & 0x3333333333333333);
+            counts = ((counts + (counts >> 4)) & 0x0f0f0f0f0f0f0f0f) * 0x0101010101010101;
+            size_t byte = 0;
+            while (((counts >> (8 * byte)) & 0xff) <= k) {
+                ++byte;
+            }
+            if (byte != 0) {
+                k -= (counts >> (8 * (byte - 1))) & 0xff;
+            }
+            unsigned bits = static_cast<unsigned>((word >> (8 * byte)) & 0xff);
+            for (; k != 0; --k) {
+                bits &= bits - 1;
+            }
+            return 8 * byte + static_cast<size_t>(std::countr_zero(bits));
+        }
+    }
+
+    // out = a & b, a | b, a ^ b and a & ~b; a, b and out have the same size and out may alias either of them
+
+    inline void bit_and(BitVectorView<bool> out, BitVectorView<const bool> a, BitVectorView<const bool> b, simd::Isa isa = simd::detected_isa())
+    {
+        detail::bitwise<detail::BitOperation::and_>(out, a, b, isa);
+    }
+
+    inline void bit_or(BitVectorView<bool> out, BitVectorView<const bool> a, BitVectorView<const bool> b, simd::Isa isa = simd::detected_isa())
+    {
+        detail::bitwise<detail::BitOperation::or_>(out, a, b, isa);
+    }
+
+    inline void bit_xor(BitVectorView<bool> out, BitVectorView<const bool> a, BitVectorView<const bool> b, simd::Isa isa = simd::detected_isa())
+    {
+        detail::bitwise<detail::BitOperation::xor_>(out, a, b, isa);
+    }
+
+    inline void bit_andnot(BitVectorView<bool> out, BitVectorView<const bool> a, BitVectorView<const bool> b, simd::Isa isa = simd::detected_isa())
+    {
+        detail::bitwise<detail::BitOperation::andnot>(out, a, b, isa);
+    }
+
+    // number of set bits
+    inline size_t popcount(BitVectorView<const bool> view, simd::Isa isa = simd::detected_isa())
+    {
+        return simd::detail::dispatch<detail::PopcountKernel>(isa, view.data(), view.word_count());
+    }
+
+    // index of the first set bit at or after from, view.size() if there is none
+    inline size_t find_next_set(BitVectorView<const bool> view, size_t from) noexcept
+    {
+        if (from >= view.size()) {
+            return view.size();
+        }
+        const VectorView<const BitWord> words = view.words();
+        size_t w = from / bits_per_word;
+        BitWord word = words[w] & (~BitWord{ 0 } << (from % bits_per_word));
+        while (word == 0) {
+            if (++w == words.size()) {
+                return view.size();
+            }
+            word = words[w];
+        }
+        return w * bits_per_word + static_cast<size_t>(std::countr_zero(word));
+    }
+
+    inline size_t find_first_set(BitVectorView<const bool> view) noexcept { return find_next_set(view, 0); }
+
+    // calls f(index) for every set bit, in increasing order
+    template<typename F>
+    void for_each_set(BitVectorView<const bool> view, F&& f)
+    {
+        const VectorView<const BitWord> words = view.words();
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (BitWord word = words[w]; word != 0; word &= word - 1) {
+                f(w * bits_per_word + static_cast<size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+
+    // Rank/select directory over a view that must outlive it and stay unchanged: the number of set bits before every
+    // 512-bit block answers rank() with at most 8 word popcounts, and the block of every select_sample-th set bit narrows
+    // the binary search of select() to the blocks between two samples. 12.5% of the bits, plus 64 bits per sample.
+    struct RankSelect
+    {
+        static constexpr size_t block_words = 8;
+        static constexpr size_t select_sample = 4096;
+
+        BitVectorView<const bool> bits_;
+        Vector<std::uint64_t> blocks_; // set bits before each block, followed by the total
+        Vector<std::uint64_t> samples_; // block holding set bit j * select_sample
+
+        explicit RankSelect(BitVectorView<const bool> bits) :
+            bits_{ bits }, blocks_{ (bits.word_count() + block_words - 1) / block_words + 1, uninitialized_tag }
+        {
+            const VectorView<const BitWord> words = bits.words();
+            std::uint64_t ones = 0;
+            for (size_t block = 0; block + 1 < blocks_.size(); ++block) {
+                blocks_[block] = ones;
+                const size_t first = block * block_words;
+                ones += popcount(BitVectorView<const bool>{ words.data() + first, std::min(block_words, words.size() - first) * bits_per_word });
+            }
+            blocks_[blocks_.size() - 1] = ones;
+
+            samples_.resize((ones + select_sample - 1) / select_sample, uninitialized_tag);
+            size_t block = 0;
+            for (size_t j = 0; j < samples_.size(); ++j) {
+                while (blocks_[block + 1] <= j * select_sample) {
+                    ++block;
+                }
+                samples_[j] = block;
+            }
+        }
+
+        size_t size() const noexcept { return bits_.size(); }
+        size_t ones() const noexcept { return blocks_[blocks_.size() - 1]; }
+
+        // set bits in [0, index), index <= size()
+        size_t rank(size_t index) const noexcept
+        {
+            const BitWord* words = bits_.data();
+            const size_t w = index / bits_per_word;
+            size_t result = blocks_[w / block_words];
+            for (size_t i = w / block_words * block_words; i < w; ++i) {
+                result += static_cast<size_t>(std::popcount(words[i]));
+            }
+            if (index % bits_per_word != 0) {
+                result += static_cast<size_t>(std::popcount(words[w] & ((BitWord{ 1 } << (index % bits_per_word)) - 1)));
+            }
+            return result;
+        }
+
+        // unset bits in [0, index)
+        size_t rank0(size_t index) const noexcept { return index - rank(index); }
+
+        // index of the k-th set bit counting from 0, k < ones()
+        size_t select(size_t k) const noexcept
+        {
+            const size_t j = k / select_sample;
+            const std::uint64_t* lo = blocks_.data() + samples_[j];
+            const std::uint64_t* hi = blocks_.data() + (j + 1 < samples_.size() ? samples_[j + 1] + 1 : blocks_.size() - 1);
+            // the last block whose count of preceding set bits is <= k
+            const size_t block = static_cast<size_t>(std::upper_bound(lo, hi, std::uint64_t{ k }) - blocks_.data()) - 1;
+            k -= blocks_[block];
+            const BitWord* words = bits_.data();
+            for (size_t w = block * block_words;; ++w) {
+                const size_t count = static_cast<size_t>(std::popcount(words[w]));
+                if (k < count) {
+                    return w * bits_per_word + detail::select_in_word(words[w], k);
+                }
+                k -= count;
+            }
+        }
+    };
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    // Append-only owning container for concurrent producers: elements live in chunks that are never reallocated, so
+    // references and chunk VectorViews stay valid while other threads append.
+    // Chunk 0 holds first_chunk elements (a power of two) and chunk k > 0 holds first_chunk << (k - 1), so an index
+    // maps to its chunk with a bit scan. Chunks are allocated on demand by the first appender that needs them (the
+    // losers of the CAS release theirs); like Vector's capacity, all their elements are constructed.
+    // push_back/grow_by are lock-free: indices are claimed with one fetch_add, every written element sets a bit in its
+    // chunk's ready bitmap and appenders advance size() over the ready prefix, helping each other. Readers see the
+    // published prefix [0, size()) only. Moves, consolidate() && and destruction need quiescence, like Vector's.
+    template<typename T>
+    struct ChunkedVector
+    {
+        static_assert(!std::is_const_v<T>, "ChunkedVector is append-only, its elements must be assignable");
+
+        static constexpr size_t max_chunks = 64;
+
+        std::array<std::atomic<T*>, max_chunks> chunks_{};
+        size_t shift_ = 0; // first_chunk == 1 << shift_
+        std::pmr::memory_resource* resource_ = std::pmr::new_delete_resource();
+        alignas(cache_line_size) std::atomic<size_t> reserved_{ 0 }; // indices handed out to appenders
+        alignas(cache_line_size) std::atomic<size_t> published_{ 0 }; // [0, published_) are written
+
+        // first_chunk is rounded up to a power of two
+        explicit ChunkedVector(size_t first_chunk = 1024, std::pmr::memory_resource* resource = std::pmr::new_delete_resource()) :
+            shift_{ static_cast<size_t>(std::countr_zero(std::bit_ceil(std::max<size_t>(first_chunk, 1)))) }, resource_{ resource } {}
+
+        // non-copyable
+        ChunkedVector(const ChunkedVector&) = delete;
+        ChunkedVector& operator = (const ChunkedVector&) = delete;
+
+        ChunkedVector(ChunkedVector&& rhs) noexcept :
+            shift_{ rhs.shift_ }, resource_{ rhs.resource_ },
+            reserved_{ rhs.reserved_.exchange(0, std::memory_order_relaxed) }, published_{ rhs.published_.exchange(0, std::memory_order_relaxed) }
+        {
+            for (size_t k = 0; k < max_chunks; ++k) {
+                chunks_[k].store(rhs.chunks_[k].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+
+        ChunkedVector& operator = (ChunkedVector&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                deallocate();
+                shift_ = rhs.shift_;
+                resource_ = rhs.resource_;
+                reserved_.store(rhs.reserved_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                published_.store(rhs.published_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                for (size_t k = 0; k < max_chunks; ++k) {
+                    chunks_[k].store(rhs.chunks_[k].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+            }
+            return *this;
+        }
+
+        ~ChunkedVector() noexcept
+        {
+            deallocate();
+        }
+
+        // published elements
+        size_t size() const noexcept { return published_.load(std::memory_order_acquire); }
+        bool empty() const noexcept { return size() == 0; }
+
+        size_t first_chunk() const noexcept { return size_t{ 1 } << shift_; }
+
+        // only for index < size(), or for indices the calling thread has appended itself
+        T& operator[](size_t index) const
+        {
+            const size_t k = chunk_of(index);
+            return chunks_[k].load(std::memory_order_acquire)[index - chunk_begin(k)];
+        }
+
+        // appends value and returns its index
+        size_t push_back(T value)
+        {
+            const size_t index = reserved_.fetch_add(1, std::memory_order_relaxed);
+            const size_t k = chunk_of(index);
+            chunk(k)[index - chunk_begin(k)] = std::move(value);
+            publish(index, 1);
+            return index;
+        }
+
+        // appends n copies of value at consecutive indices and returns the first one
+        size_t grow_by(size_t n, const T& value)
+        {
+            return append(n, [&](VectorView<T> view, size_t) { std::fill(view.begin(), view.end(), value); });
+        }
+
+        // appends a copy of values at consecutive indices and returns the first one
+        size_t grow_by(VectorView<const T> values)
+        {
+            return append(values.size(), [&](VectorView<T> view, size_t offset) { std::copy(values.begin() + offset, values.begin() + offset + view.size(), view.begin()); });
+        }
+
+        // number of chunks holding published elements
+        size_t chunk_count() const noexcept
+        {
+            const size_t s = size();
+            return s == 0 ? 0 : chunk_of(s - 1) + 1;
+        }
+
+        // published elements of chunk k: the view stays valid as long as the container lives
+        VectorView<T> chunk_view(size_t k) const
+        {
+            const size_t s = size();
+            const size_t begin = chunk_begin(k);
+            if (begin >= s) {
+                return {};
+            }
+            T* memory = chunks_[k].load(std::memory_order_acquire);
+            return { memory, memory + std::min(chunk_size(k), s - begin) };
+        }
+
+        // calls f(VectorView<T>) on every chunk of the published prefix, in order
+        template<typename F>
+        void for_each_chunk(F&& f) const
+        {
+            const size_t s = size();
+            for (size_t k = 0; s != 0 && k <= chunk_of(s - 1); ++k) {
+                T* memory = chunks_[k].load(std::memory_order_acquire);
+                f(VectorView<T>{ memory, memory + std::min(chunk_size(k), s - chunk_begin(k)) });
+            }
+        }
+
+        // contiguous copy of the published prefix
+        Vector<T> consolidate() const &
+        {
+            Vector<T> result{ size(), uninitialized_tag };
+            T* out = result.begin();
+            for_each_chunk([&](VectorView<T> view) { out = std::copy(view.begin(), view.end(), out); });
+            return result;
+        }
+
+        // moves the published prefix into a contiguous Vector and leaves the container empty
+        Vector<T> consolidate() &&
+        {
+            Vector<T> result{ size(), uninitialized_tag };
+            T* out = result.begin();
+            for_each_chunk([&](VectorView<T> view) { out = std::move(view.begin(), view.end(), out); });
+            *this = ChunkedVector{ first_chunk(), resource_ };
+            return result;
+        }
+
+    private:
+        using Word = std::atomic<std::uint64_t>;
+
+        static constexpr size_t chunk_alignment = std::max(alignof(T), alignof(Word));
+
+        size_t chunk_of(size_t index) const noexcept { return static_cast<size_t>(std::bit_width(index >> shift_)); }
+        size_t chunk_begin(size_t k) const noexcept { return k == 0 ? 0 : size_t{ 1 } << (shift_ + k - 1); }
+        size_t chunk_size(size_t k) const noexcept { return size_t{ 1 } << (k == 0 ? shift_ : shift_ + k - 1); }
+
+        // a chunk is its elements followed by its ready bitmap
+        static size_t bitmap_offset(size_t n) noexcept { return (n * sizeof(T) + alignof(Word) - 1) / alignof(Word) * alignof(Word); }
+        static size_t chunk_bytes(size_t n) noexcept { return bitmap_offset(n) + (n + 63) / 64 * sizeof(Word); }
+
+        Word* ready(size_t k) const noexcept
+        {
+            auto* memory = reinterpret_cast<std::byte*>(chunks_[k].load(std::memory_order_acquire));
+            return reinterpret_cast<Word*>(memory + bitmap_offset(chunk_size(k)));
+        }
+
+        T* chunk(size_t k)
+        {
+            T* memory = chunks_[k].load(std::memory_order_acquire);
+            if (memory != nullptr) {
+                return memory;
+            }
+            const size_t n = chunk_size(k);
+            auto* bytes = static_cast<std::byte*>(resource_->allocate(chunk_bytes(n), chunk_alignment));
+            T* allocated = reinterpret_cast<T*>(bytes);
+            try {
+                std::uninitialized_default_construct_n(allocated, n);
+            }
+            catch (...) {
+                resource_->deallocate(bytes, chunk_bytes(n), chunk_alignment);
+                throw;
+            }
+            std::uninitialized_value_construct_n(reinterpret_cast<Word*>(bytes + bitmap_offset(n)), (n + 63) / 64);
+            if (chunks_[k].compare_exchange_strong(memory, allocated, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return allocated;
+            }
+            release(k, allocated);
+            return memory;
+        }
+
+        void release(size_t k, T* memory) noexcept
+        {
+            const size_t n = chunk_size(k);
+            std::destroy_n(memory, n);
+            resource_->deallocate(memory, chunk_bytes(n), chunk_alignment);
+        }
+
+        void deallocate() noexcept
+        {
+            for (size_t k = 0; k < max_chunks; ++k) {
+                if (T* memory = chunks_[k].exchange(nullptr, std::memory_order_relaxed)) {
+                    release(k, memory);
+                }
+            }
+        }
+
+        // claims n indices, lets write(view, offset) fill them chunk by chunk and publishes them
+        template<typename Write>
+        size_t append(size_t n, Write&& write)
+        {
+            const size_t first = reserved_.fetch_add(n, std::memory_order_relaxed);
+            for (size_t index = first; index < first + n;) {
+                const size_t k = chunk_of(index);
+                const size_t offset = index - chunk_begin(k);
+                const size_t count = std::min(first + n - index, chunk_size(k) - offset);
+                T* memory = chunk(k);
+                write(VectorView<T>{ memory + offset, memory + offset + count }, index - first);
+                index += count;
+            }
+            publish(first, n);
+            return first;
+        }
+
+        // marks [first, first + n) ready, then moves published_ over every ready element that follows it; ready bits and
+        // published_ are sequentially consistent so that, of two appenders finishing concurrently, at least one sees
+        // the other's bits
+        void publish(size_t first, size_t n)
+        {
+            for (size_t index = first; index < first + n;) {
+                const size_t k = chunk_of(index);
+                const size_t offset = index - chunk_begin(k);
+                const size_t bits = std::min({ first + n - index, chunk_size(k) - offset, 64 - offset % 64 });
+                const std::uint64_t mask = (bits == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << bits) - 1) << (offset % 64);
+                ready(k)[offset / 64].fetch_or(mask);
+                index += bits;
+            }
+            size_t published = published_.load();
+            for (;;) {
+                const size_t k = chunk_of(published);
+                if (k >= max_chunks || chunks_[k].load() == nullptr) {
+                    return;
+                }
+                const size_t offset = published - chunk_begin(k);
+                const std::uint64_t word = ready(k)[offset / 64].load() >> (offset % 64);
+                const size_t run = std::min(static_cast<size_t>(std::countr_one(word)), chunk_size(k) - offset);
+                if (run == 0) {
+                    return;
+                }
+                if (published_.compare_exchange_weak(published, published + run)) {
+                    published += run;
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+#include <Containers2/simd.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    template<typename T>
+    concept CompressibleInteger = std::unsigned_integral<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+    // one block of compressed_block_size values: bits per packed value, stored from words_[offset]
+    template<CompressibleInteger T>
+    struct CompressedBlock
+    {
+        T reference; // frame of reference: the minimum; delta: the first value
+        std::uint64_t offset;
+        std::uint8_t bits;
+        bool delta;
+    };
+
+    inline constexpr size_t compressed_block_size = 256;
+
+    namespace detail {
+
+        // the packed values are interleaved over 32 bytes of lanes: value i of a block is in lane i % L, whose word j
+        // is at j * L + lane, so the values k * L .. k * L + L - 1 unpack together into consecutive outputs; with
+        // 256 values a lane holds exactly 8 * sizeof(T) of them and takes bits words
+        template<typename T>
+        inline constexpr size_t compressed_lanes = 32 / sizeof(T);
+
+        struct UnpackKernel
+        {
+            // V is T or a compiler vector of T
+            template<typename V, typename T>
+            CONTAINERS2_SIMD_INLINE static void unpack(const CompressedBlock<T>& block, const T* words, T* out)
+            {
+                constexpr size_t W = 8 * sizeof(T);
+                constexpr size_t L = compressed_lanes<T>;
+                constexpr size_t VL = sizeof(V) / sizeof(T);
+                const size_t bits = block.bits;
+                const T mask = bits == W ? ~T{ 0 } : static_cast<T>((T{ 1 } << bits) - 1);
+                const T* p = words + block.offset;
+                for (size_t lane = 0; lane < L; lane += VL) {
+                    // delta: every lane adds the difference to the value L positions before
+                    V previous = V{} + block.reference;
+                    for (size_t k = 0; k < W; ++k) {
+                        V v = V{};
+                        if (bits != 0) {
+                            const size_t position = k * bits;
+                            const size_t shift = position % W;
+                            V w;
+                            std::memcpy(&w, p + position / W * L + lane, sizeof(V));
+                            v = w >> shift;
+                            if (shift + bits > W) {
+                                std::memcpy(&w, p + (position / W + 1) * L + lane, sizeof(V));
+                                v |= w << (W - shift);
+                            }
+                            v &= mask;
+                        }
+                        if (block.delta) {
+                            previous += v;
+                            v = previous;
+                        }
+                        else {
+                            v += block.reference;
+                        }
+                        std::memcpy(out + k * L + lane, &v, sizeof(V));
+                    }
+                }
+            }
+
+            // count whole blocks, count * compressed_block_size outputs
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static void run(const CompressedBlock<T>* blocks, const T* words, size_t count, T* out)
+            {
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    // the lanes span 32 bytes, wider vectors would straddle two groups of them
+                    typedef T V __attribute__((vector_size(std::min<size_t>(Bytes, 32))));
+                    for (size_t b = 0; b < count; ++b) {
+                        unpack<V>(blocks[b], words, out + b * compressed_block_size);
+                    }
+                    return;
+                }
+#endif
+                for (size_t b = 0; b < count; ++b) {
+                    unpack<T>(blocks[b], words, out + b * compressed_block_size);
+                }
+            }
+        };
+    }
+
+    // Owning, immutable compression of unsigned 32 or 64-bit integers for columns of sorted ids and small values.
+    // Blocks of 256 values are bit-packed at the width of their largest value, either as offsets from the block
+    // minimum (frame of reference) or as differences from the value one lane before (delta, for sorted data),
+    // whichever is narrower. A block header per block gives O(1) seek: element access unpacks a single value (up to
+    // 8 * sizeof(T) of them for delta blocks) and decode() unpacks whole blocks with SIMD into a caller buffer,
+    // allocating nothing.
+    // Move-only like Vector: clone() is the explicit deep copy.
+    template<CompressibleInteger T>
+    struct CompressedVector
+    {
+        static constexpr size_t block_size = compressed_block_size;
+
+        Vector<CompressedBlock<T>> blocks_;
+        Vector<T> words_;
+        size_t size_ = 0;
+
+        CompressedVector() noexcept = default;
+
+        // compresses in the buffer of values, then shrinks it to the packed words
+        explicit CompressedVector(Vector<T>&& values) : size_{ values.size() }
+        {
+            values.resize(block_count() * block_size);
+            values.resize(encode(values.data(), values.data()));
+            values.shrink_to_fit();
+            words_ = std::move(values);
+        }
+
+        explicit CompressedVector(VectorView<const T> values) : size_{ values.size() }
+        {
+            Vector<T> words(block_count() * block_size, uninitialized_tag);
+            words.resize(encode(values.data(), words.data()));
+            words.shrink_to_fit();
+            words_ = std::move(words);
+        }
+
+        // non-copyable, see clone()
+        CompressedVector(const CompressedVector&) = delete;
+        CompressedVector& operator = (const CompressedVector&) = delete;
+
+        CompressedVector(CompressedVector&& rhs) noexcept :
+            blocks_{ std::move(rhs.blocks_) }, words_{ std::move(rhs.words_) }, size_{ std::exchange(rhs.size_, 0) } {}
+
+        CompressedVector& operator = (CompressedVector&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                blocks_ = std::move(rhs.blocks_);
+                words_ = std::move(rhs.words_);
+                size_ = std::exchange(rhs.size_, 0);
+            }
+            return *this;
+        }
+
+        ~CompressedVector() noexcept = default;
+
+        CompressedVector clone() const
+        {
+            CompressedVector copy;
+            copy.blocks_ = Vector<CompressedBlock<T>>(blocks_.size(), uninitialized_tag);
+            std::copy(blocks_.begin(), blocks_.end(), copy.blocks_.begin());
+            copy.words_ = Vector<T>(words_.size(), uninitialized_tag);
+            std::copy(words_.begin(), words_.end(), copy.words_.begin());
+            copy.size_ = size_;
+            return copy;
+        }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t block_count() const noexcept { return (size_ + block_size - 1) / block_size; }
+
+        // packed words and block headers
+        size_t compressed_bytes() const noexcept { return words_.size() * sizeof(T) + blocks_.size() * sizeof(CompressedBlock<T>); }
+
+        T operator[](size_t i) const
+        {
+            constexpr size_t L = detail::compressed_lanes<T>;
+            const CompressedBlock<T>& block = blocks_[i / block_size];
+            const size_t lane = i % block_size % L;
+            const size_t k = i % block_size / L;
+            if (!block.delta) {
+                return static_cast<T>(block.reference + unpack_one(block, lane, k));
+            }
+            T value = block.reference;
+            for (size_t j = 0; j <= k; ++j) {
+                value += unpack_one(block, lane, j);
+            }
+            return value;
+        }
+
+        // out = the values first .. first + out.size() - 1, which must exist; whole blocks are unpacked straight into
+        // out, partial ones at either end through a block on the stack
+        void decode(size_t first, VectorView<T> out, simd::Isa isa = simd::detected_isa()) const
+        {
+            T* o = out.data();
+            size_t remaining = out.size();
+            if (first % block_size != 0 && remaining != 0) {
+                const size_t n = std::min(block_size - first % block_size, remaining);
+                decode_partial(first / block_size, first % block_size, n, o, isa);
+                first += n;
+                o += n;
+                remaining -= n;
+            }
+            const size_t whole = remaining / block_size;
+            if (whole != 0) {
+                simd::detail::dispatch<detail::UnpackKernel>(isa, blocks_.data() + first / block_size, words_.data(), whole, o);
+                first += whole * block_size;
+                o += whole * block_size;
+                remaining -= whole * block_size;
+            }
+            if (remaining != 0) {
+                decode_partial(first / block_size, 0, remaining, o, isa);
+            }
+        }
+
+        void decode(VectorView<T> out, simd::Isa isa = simd::detected_isa()) const
+        {
+            decode(0, out, isa);
+        }
+
+    private:
+        // packed value k of a lane
+        T unpack_one(const CompressedBlock<T>& block, size_t lane, size_t k) const noexcept
+        {
+            constexpr size_t W = 8 * sizeof(T);
+            constexpr size_t L = detail::compressed_lanes<T>;
+            const size_t bits = block.bits;
+            if (bits == 0) {
+                return 0;
+            }
+            const T* p = words_.data() + block.offset;
+            const size_t position = k * bits;
+            const size_t shift = position % W;
+            T v = static_cast<T>(p[position / W * L + lane] >> shift);
+            if (shift + bits > W) {
+                v |= static_cast<T>(p[(position / W + 1) * L + lane] << (W - shift));
+            }
+            return bits == W ? v : static_cast<T>(v & ((T{ 1 } << bits) - 1));
+        }
+
+        void decode_partial(size_t b, size_t from, size_t n, T* out, simd::Isa isa) const
+        {
+            T block[block_size];
+            simd::detail::dispatch<detail::UnpackKernel>(isa, blocks_.data() + b, words_.data(), size_t{ 1 }, static_cast<T*>(block));
+            std::copy(block + from, block + from + n, out);
+        }
+
+        // fills blocks_ and returns the number of words; words may be values: block b is read before its words are
+        // written, and they end before block b + 1 starts
+        size_t encode(const T* values, T* words)
+        {
+            constexpr size_t W = 8 * sizeof(T);
+            constexpr size_t L = detail::compressed_lanes<T>;
+            blocks_ = Vector<CompressedBlock<T>>(block_count(), uninitialized_tag);
+            size_t offset = 0;
+            T block[block_size];
+            T packed[block_size];
+            for (size_t b = 0; b < block_count(); ++b) {
+                // the last block repeats its last value
+                const size_t n = std::min(block_size, size_ - b * block_size);
+                std::copy(values + b * block_size, values + b * block_size + n, block);
+                std::fill(block + n, block + block_size, block[n - 1]);
+
+                const auto [minimum, maximum] = std::minmax_element(block, block + block_size);
+                T delta_maximum = 0;
+                for (size_t i = 0; i < block_size; ++i) {
+                    delta_maximum = std::max(delta_maximum, static_cast<T>(block[i] - block[i < L ? 0 : i - L]));
+                }
+                const size_t delta_bits = static_cast<size_t>(std::bit_width(delta_maximum));
+                const size_t range_bits = static_cast<size_t>(std::bit_width(static_cast<T>(*maximum - *minimum)));
+                const bool delta = delta_bits < range_bits;
+                const size_t bits = delta ? delta_bits : range_bits;
+                const T reference = delta ? block[0] : *minimum;
+                for (size_t i = 0; i < block_size; ++i) {
+                    packed[i] = static_cast<T>(delta ? block[i] - block[i < L ? 0 : i - L] : block[i] - reference);
+                }
+                blocks_[b] = CompressedBlock<T>{ reference, offset, static_cast<std::uint8_t>(bits), delta };
+
+                T* p = words + offset;
+                std::fill(p, p + bits * L, T{ 0 });
+                if (bits != 0) {
+                    for (size_t i = 0; i < block_size; ++i) {
+                        const size_t lane = i % L;
+                        const size_t position = i / L * bits;
+                        const size_t shift = position % W;
+                        p[position / W * L + lane] |= static_cast<T>(packed[i] << shift);
+                        if (shift + bits > W) {
+                            p[(position / W + 1) * L + lane] |= static_cast<T>(packed[i] >> (W - shift));
+                        }
+                    }
+                }
+                offset += bits * L;
+            }
+            return offset;
+        }
+    };
+}
@@ -1,7 +1,35 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <type_traits>
+#include <utility>
+
+#if !defined(__GNUC__) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// non-temporal stores of copy_elements(): SSE2, the baseline of x86-64
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CONTAINERS2_STREAMING_STORES 1
+#else
+#define CONTAINERS2_STREAMING_STORES 0
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include <Containers2/instrumentation.hpp>
 
 namespace containers2 {
 
@@ -11,6 +39,14 @@ namespace containers2 {
     template<typename T>
     struct Vector;
 
+    // Specialized to true by owning containers other than Vector: views cannot be built from their temporaries,
+    // which would leave the view dangling as soon as the full expression ends.
+    template<typename C>
+    inline constexpr bool is_owning_container_v = false;
+
+    template<typename C>
+    concept OwningContainerRvalue = is_owning_container_v<std::remove_cvref_t<C>> && !std::is_lvalue_reference_v<C>;
+
     template<typename T> requires(std::is_const_v<T>)
     struct VectorView<T> 
     {
@@ -35,6 +71,10 @@ namespace containers2 {
         VectorView& operator = (Vector<T>&&) = delete;
         VectorView(Vector<std::remove_const_t<T>>&&) = delete;
         VectorView& operator = (Vector<std::remove_const_t<T>>&&) = delete;
+        template<OwningContainerRvalue C>
+        VectorView(C&&) = delete;
+        template<OwningContainerRvalue C>
+        VectorView& operator = (C&&) = delete;
 
         T* begin() const { return begin_; }
         T* end() const { return end_; }
@@ -71,6 +111,10 @@ namespace containers2 {
         VectorView& operator = (Vector<T>&&) = delete;
         VectorView(Vector<const T>&&) = delete;
         VectorView& operator = (Vector<const T>&&) = delete;
+        template<OwningContainerRvalue C>
+        VectorView(C&&) = delete;
+        template<OwningContainerRvalue C>
+        VectorView& operator = (C&&) = delete;
 
         T* begin() const { return const_cast<T*>(super::begin()); }
         T* end() const { return const_cast<T*>(super::end()); }
@@ -87,23 +131,270 @@ namespace containers2 {
     inline struct non_preserving_uninitialized_tag_t {} non_preserving_uninitialized_tag;
     inline struct non_preserving_initialized_tag_t {} non_preserving_initialized_tag;
 
+    namespace detail {
+
+        // hint that *p will be read soon, for searches that know their next addresses ahead of the loads
+        inline void prefetch(const void* p) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p);
+#elif defined(_M_X64) || defined(_M_IX86)
+            _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+            (void)p;
+#endif
+        }
+    }
+
+    // How copies of trivially copyable elements write their destination. automatic streams those larger than the last
+    // level cache: a destination that big cannot stay cached anyway, and writing it through the cache would only evict
+    // whatever else was there (and read every destination line before overwriting it).
+    enum class CopyMode { automatic, cached, streaming };
+
+    namespace detail {
+
+        // from the OS where it tells, 32 MiB otherwise
+        inline size_t last_level_cache_size() noexcept
+        {
+            static const size_t size = [] {
+#if defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+                for (int level : { _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE }) {
+                    const long bytes = sysconf(level);
+                    if (bytes > 0) {
+                        return static_cast<size_t>(bytes);
+                    }
+                }
+#endif
+                return size_t{ 32 } << 20;
+            }();
+            return size;
+        }
+
+        inline bool streams(size_t bytes, CopyMode mode) noexcept
+        {
+            return mode == CopyMode::streaming || (mode == CopyMode::automatic && bytes > last_level_cache_size());
+        }
+
+        // memcpy whose stores bypass the caches, aligned on the destination
+        inline void stream_copy(void* destination, const void* source, size_t bytes) noexcept
+        {
+            auto* d = static_cast<std::byte*>(destination);
+            auto* s = static_cast<const std::byte*>(source);
+#if CONTAINERS2_STREAMING_STORES
+            const size_t head = std::min(bytes, (16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16);
+            std::memcpy(d, s, head);
+            d += head;
+            s += head;
+            bytes -= head;
+            // a whole cache line per iteration: the write-combining buffer flushes full lines
+            for (; bytes >= 64; bytes -= 64, d += 64, s += 64) {
+                const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+                const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+                const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v1);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v2);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v3);
+            }
+            // non-temporal stores are weakly ordered: publish them before anything that follows
+            _mm_sfence();
+#endif
+            if (bytes != 0) {
+                std::memcpy(d, s, bytes);
+            }
+        }
+    }
+
+    // destination[i] = source[i]: memcpy (or streaming stores, see CopyMode) for trivially copyable elements,
+    // assignment otherwise; the views must have the same size and must not overlap
+    template<typename T>
+    void copy_elements(VectorView<const T> source, VectorView<std::type_identity_t<T>> destination, CopyMode mode = CopyMode::automatic)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            const size_t bytes = source.size() * sizeof(T);
+            if (detail::streams(bytes, mode)) {
+                detail::stream_copy(destination.data(), source.data(), bytes);
+            }
+            else if (bytes != 0) {
+                std::memcpy(destination.data(), source.data(), bytes);
+            }
+        }
+        else {
+            std::copy(source.begin(), source.end(), destination.begin());
+        }
+    }
+
+    // Memory resource that can resize a block in place (or by remapping it) instead of allocate+copy+free.
+    // Vectors of trivially copyable elements use it to grow without copying.
+    struct ReallocatingMemoryResource : std::pmr::memory_resource
+    {
+        // preserves the first min(old_bytes, new_bytes) bytes; the block may move
+        void* reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t alignment)
+        {
+            return do_reallocate(p, old_bytes, new_bytes, alignment);
+        }
+
+    protected:
+        virtual void* do_reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t alignment) = 0;
+    };
+
+    // malloc/realloc/free; glibc serves realloc of large blocks with mremap, so they are never copied.
+    // Over-aligned requests go through std::pmr::new_delete_resource() and are reallocated by copy.
+    struct MallocMemoryResource final : ReallocatingMemoryResource
+    {
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (alignment > alignof(std::max_align_t)) {
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+            void* p = std::malloc(bytes != 0 ? bytes : 1);
+            if (p == nullptr) {
+                throw std::bad_alloc{};
+            }
+            return p;
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            if (alignment > alignof(std::max_align_t)) {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+            else {
+                std::free(p);
+            }
+        }
+
+        void* do_reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t alignment) override
+        {
+            if (alignment > alignof(std::max_align_t)) {
+                void* q = do_allocate(new_bytes, alignment);
+                std::memcpy(q, p, std::min(old_bytes, new_bytes));
+                do_deallocate(p, old_bytes, alignment);
+                return q;
+            }
+            void* q = std::realloc(p, new_bytes != 0 ? new_bytes : 1);
+            if (q == nullptr) {
+                throw std::bad_alloc{};
+            }
+            return q;
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return dynamic_cast<const MallocMemoryResource*>(&other) != nullptr;
+        }
+    };
+
+    inline std::pmr::memory_resource* malloc_memory_resource() noexcept
+    {
+        static MallocMemoryResource resource;
+        return &resource;
+    }
+
+    inline constexpr size_t cache_line_size = 64;
+
+    // transparent huge pages of x86-64 and of most aarch64 kernels
+    inline constexpr size_t huge_page_size = size_t{ 1 } << 21;
+
+    // Rounds every block up to Alignment bytes both at the start and at the end, so that SIMD kernels
+    // get aligned loads and the tail of a buffer never shares a cache line with another allocation.
+    template<size_t Alignment>
+    struct AlignedMemoryResource final : std::pmr::memory_resource
+    {
+        static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+        std::pmr::memory_resource* upstream_;
+
+        explicit AlignedMemoryResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept : upstream_{ upstream } {}
+
+        static constexpr size_t padded(size_t bytes) noexcept { return (bytes + Alignment - 1) & ~(Alignment - 1); }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            return upstream_->allocate(padded(bytes), std::max(alignment, Alignment));
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            upstream_->deallocate(p, padded(bytes), std::max(alignment, Alignment));
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            auto* aligned = dynamic_cast<const AlignedMemoryResource*>(&other);
+            return aligned != nullptr && upstream_->is_equal(*aligned->upstream_);
+        }
+    };
+
+    // e.g. aligned_memory_resource<cache_line_size>() or aligned_memory_resource<32>() for AVX2
+    template<size_t Alignment>
+    std::pmr::memory_resource* aligned_memory_resource() noexcept
+    {
+        static AlignedMemoryResource<Alignment> resource;
+        return &resource;
+    }
+
+    // Memory resource used by default by Vector<T>: trivially copyable elements go through malloc so that
+    // growth can use realloc, everything else through the plain new[]/delete[] path (nullptr).
+    // Views never carry the resource, only owning containers do.
+    template<typename T>
+    std::pmr::memory_resource* default_memory_resource() noexcept
+    {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            return malloc_memory_resource();
+        }
+        else {
+            return nullptr;
+        }
+    }
+
+    // Per-thread size-class pool: cheap for short-lived Vectors, but Vectors allocated from it
+    // must be destroyed (or resized) on the thread that allocated them.
+    inline std::pmr::memory_resource* thread_local_memory_resource() noexcept
+    {
+        thread_local std::pmr::unsynchronized_pool_resource resource;
+        return &resource;
+    }
+
+    // Owning container: [begin_, end_) are the live elements, [end_, capacity_end_) is reserved storage.
+    // All capacity_end_ - begin_ elements are constructed, so shrinking only moves end_.
     template<typename T>
     struct Vector : VectorView<T>
     {
         using super = VectorView<T>;
         using super::begin_;
         using super::end_;
-        Vector(T* memory, size_t s) : super(memory, memory+s) {}
+
+        T* capacity_end_ = nullptr;
+        std::pmr::memory_resource* resource_ = default_memory_resource<T>();
+
+        // adopts memory allocated with new T[s] (resource == nullptr) or from resource
+        Vector(T* memory, size_t s, std::pmr::memory_resource* resource = nullptr) : super(memory, memory+s), capacity_end_{ memory+s }, resource_{ resource }
+        {
+            if constexpr (instrumentation::enabled) {
+                if (memory != nullptr) {
+                    instrumentation::detail::record<T>(instrumentation::EventKind::allocate, s * sizeof(T));
+                }
+            }
+        }
 
         Vector() noexcept = default;
 
-        explicit Vector(size_t s, uninitialized_tag_t = uninitialized_tag) requires(!std::is_const_v<T>) : Vector(new T[s], s) {}
-        explicit Vector(size_t s, T value, initialized_tag_t = initialized_tag) : Vector(s, uninitialized_tag)
+        explicit Vector(size_t s, uninitialized_tag_t = uninitialized_tag) requires(!std::is_const_v<T>) : Vector(s, uninitialized_tag, default_memory_resource<T>()) {}
+        explicit Vector(size_t s, T value, initialized_tag_t = initialized_tag) : Vector(s, value, initialized_tag, default_memory_resource<T>()) {}
+
+        Vector(size_t s, uninitialized_tag_t, std::pmr::memory_resource* resource) requires(!std::is_const_v<T>) : Vector(allocate(s, resource), s, resource) {}
+        Vector(size_t s, T value, initialized_tag_t, std::pmr::memory_resource* resource) : Vector(s, uninitialized_tag, resource)
         {
             std::fill(begin(), end(), value);
         }
 
-        Vector(std::initializer_list<T> l) : Vector(std::size(l))
+        Vector(std::initializer_list<T> l) : Vector(l, default_memory_resource<T>()) {}
+
+        Vector(std::initializer_list<T> l, std::pmr::memory_resource* resource) : Vector(std::size(l), uninitialized_tag, resource)
         {
             std::copy(std::begin(l), std::end(l), begin());
         }
@@ -118,27 +409,61 @@ namespace containers2 {
         Vector(const VectorView<std::remove_const_t<T>>&) = delete;
         Vector& operator = (const VectorView<std::remove_const_t<T>>&) = delete;
 
-        Vector(Vector&& rhs) noexcept(noexcept(std::exchange(static_cast<VectorView<T>&>(rhs), {}))) :
-            super{std::exchange(static_cast<VectorView<T>&>(rhs), {})} {}
+        // moves transfer the buffer together with the resource that has to release it
+        Vector(Vector&& rhs) noexcept :
+            super{ std::exchange(static_cast<VectorView<T>&>(rhs), {}) },
+            capacity_end_{ std::exchange(rhs.capacity_end_, nullptr) },
+            resource_{ std::exchange(rhs.resource_, default_memory_resource<T>()) } {}
 
-        Vector& operator = (Vector&& rhs) & noexcept(noexcept(std::exchange(static_cast<VectorView<T>&>(rhs), {})))
+        Vector& operator = (Vector&& rhs) & noexcept
         {
-            super::operator =(std::exchange(static_cast<VectorView<T>&>(rhs), {}));
+            if (this != &rhs) {
+                deallocate();
+                super::operator =(std::exchange(static_cast<VectorView<T>&>(rhs), {}));
+                capacity_end_ = std::exchange(rhs.capacity_end_, nullptr);
+                resource_ = std::exchange(rhs.resource_, default_memory_resource<T>());
+            }
             return *this;
         }
 
-        Vector(Vector<std::remove_const_t<T>>&& rhs) noexcept(noexcept(std::exchange(static_cast<VectorView<T>&>(rhs), {}))) requires(std::is_const_v<T>) :
-            super{ std::exchange(static_cast<VectorView<std::remove_const_t<T>>&>(rhs), {}) } {}
+        Vector(Vector<std::remove_const_t<T>>&& rhs) noexcept requires(std::is_const_v<T>) :
+            super{ std::exchange(static_cast<VectorView<std::remove_const_t<T>>&>(rhs), {}) },
+            capacity_end_{ std::exchange(rhs.capacity_end_, nullptr) },
+            resource_{ std::exchange(rhs.resource_, default_memory_resource<T>()) } {}
 
-        Vector& operator = (Vector<std::remove_const_t<T>>&& rhs) & noexcept(noexcept(std::exchange(static_cast<VectorView<T>&>(rhs), {}))) requires(std::is_const_v<T>)
+        Vector& operator = (Vector<std::remove_const_t<T>>&& rhs) & noexcept requires(std::is_const_v<T>)
         {
-            super::operator =(std::exchange(static_cast<VectorView<T>&>(rhs), {}));
+            deallocate();
+            super::operator =(std::exchange(static_cast<VectorView<std::remove_const_t<T>>&>(rhs), {}));
+            capacity_end_ = std::exchange(rhs.capacity_end_, nullptr);
+            resource_ = std::exchange(rhs.resource_, default_memory_resource<T>());
             return *this;
         }
 
         ~Vector() noexcept
         {
-            delete[] begin();
+            deallocate();
+        }
+
+        std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+        // the explicit deep copy: exactly size() elements, from the same resource
+        Vector<T> clone(CopyMode mode = CopyMode::automatic) const
+        {
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::clone };
+            using U = std::remove_const_t<T>;
+            Vector<U> copy{ size(), uninitialized_tag, resource_ };
+            copy_elements<U>(*this, copy, mode);
+            return copy;
+        }
+
+        // replaces the elements with a copy of source, reusing the capacity when it is enough (non preserving resize);
+        // source must not overlap this Vector
+        void copy_from(VectorView<const T> source, CopyMode mode = CopyMode::automatic) requires(!std::is_const_v<T>)
+        {
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::copy_from };
+            resize(source.size(), non_preserving_uninitialized_tag);
+            copy_elements<T>(source, *this, mode);
         }
 
         using super::begin;
@@ -147,42 +472,141 @@ namespace containers2 {
         using super::operator[];
         using super::size;
 
+        size_t capacity() const noexcept { return capacity_end_ - begin_; }
+
+        void reserve(size_t c) requires(!std::is_const_v<T>)
+        {
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::reserve };
+            if (c > capacity()) {
+                reallocate(c);
+            }
+        }
+
+        void shrink_to_fit() requires(!std::is_const_v<T>)
+        {
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::shrink_to_fit };
+            if (capacity() != size()) {
+                reallocate(size());
+            }
+        }
+
         // implement non-const preserving resize
 
+        // non preserving resizes never copy: they reuse the capacity or allocate exactly s elements
         void resize(size_t s, non_preserving_uninitialized_tag_t) requires(!std::is_const_v<T>)
         {
-            const size_t old_size = this->size();
-            if (old_size != s) {
-                Vector<T> new_vector{ s, uninitialized_tag };
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::resize_non_preserving_uninitialized };
+            if (s > capacity()) {
+                Vector<T> new_vector{ s, uninitialized_tag, resource_ };
                 *this = std::move(new_vector);
             }
+            end_ = begin_ + s;
         }
 
         void resize(size_t s, T value, non_preserving_initialized_tag_t) requires(!std::is_const_v<T>)
         {
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::resize_non_preserving_initialized };
             this->resize(s, non_preserving_uninitialized_tag);
             std::fill(this->begin(), this->end(), value);
         }
 
+        // preserving resizes shrink in place and grow geometrically
         void resize(size_t s, uninitialized_tag_t = uninitialized_tag) requires(!std::is_const_v<T>)
         {
-            const size_t old_size = this->size();
-            if (old_size != s) {
-                Vector<T> new_vector{ s, uninitialized_tag };
-                std::copy_n(this->begin(), std::min(s, old_size), std::begin(new_vector));
-                *this = std::move(new_vector);
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::resize_uninitialized };
+            if (s > capacity()) {
+                reallocate(std::max(s, 2 * capacity()));
             }
+            end_ = begin_ + s;
         }
 
         void resize(size_t s, T value, initialized_tag_t = initialized_tag) requires(!std::is_const_v<T>)
         {
+            instrumentation::detail::OperationScope scope{ instrumentation::Operation::resize_initialized };
             const size_t old_size = this->size();
-            if (old_size != s) {
-                Vector<T> new_vector{ s, uninitialized_tag };
-                std::fill(std::copy_n(this->begin(), std::min(s, old_size), std::begin(new_vector)), std::end(new_vector), value);
-                *this = std::move(new_vector);
+            this->resize(s, uninitialized_tag);
+            if (s > old_size) {
+                std::fill(this->begin() + old_size, this->end(), value);
             }
         }
 
+    private:
+        static T* allocate(size_t s, std::pmr::memory_resource* resource) requires(!std::is_const_v<T>)
+        {
+            if (resource == nullptr) {
+                return new T[s];
+            }
+            T* memory = static_cast<T*>(resource->allocate(s * sizeof(T), alignof(T)));
+            try {
+                std::uninitialized_default_construct_n(memory, s);
+            }
+            catch (...) {
+                resource->deallocate(memory, s * sizeof(T), alignof(T));
+                throw;
+            }
+            return memory;
+        }
+
+        // moves the buffer to one holding c elements, keeping the first min(size(), c) of them
+        void reallocate(size_t c) requires(!std::is_const_v<T>)
+        {
+            const size_t s = std::min(size(), c);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                auto* reallocating = dynamic_cast<ReallocatingMemoryResource*>(resource_);
+                if (reallocating != nullptr && begin_ != nullptr && c != 0) {
+                    const size_t old_capacity = capacity();
+                    T* memory = static_cast<T*>(reallocating->reallocate(this->begin(), old_capacity * sizeof(T), c * sizeof(T), alignof(T)));
+                    if (c > old_capacity) {
+                        std::uninitialized_default_construct(memory + old_capacity, memory + c);
+                    }
+                    if constexpr (instrumentation::enabled) {
+                        // realloc copies only when it cannot resize the block in place
+                        using instrumentation::EventKind;
+                        instrumentation::detail::record<T>(EventKind::deallocate, old_capacity * sizeof(T));
+                        instrumentation::detail::record<T>(EventKind::allocate, c * sizeof(T));
+                        instrumentation::detail::record<T>(EventKind::reallocate, c * sizeof(T), old_capacity * sizeof(T), memory != begin_ ? s * sizeof(T) : 0);
+                    }
+                    begin_ = memory;
+                    end_ = memory + s;
+                    capacity_end_ = memory + c;
+                    return;
+                }
+            }
+            Vector<T> new_vector{ c, uninitialized_tag, resource_ };
+            std::move(this->begin(), this->begin() + s, new_vector.begin());
+            new_vector.end_ = new_vector.begin_ + s;
+            if constexpr (instrumentation::enabled) {
+                instrumentation::detail::record<T>(instrumentation::EventKind::reallocate, c * sizeof(T), capacity() * sizeof(T), s * sizeof(T));
+            }
+            *this = std::move(new_vector);
+        }
+
+        void deallocate() noexcept
+        {
+            if constexpr (instrumentation::enabled) {
+                if (begin_ != nullptr) {
+                    instrumentation::detail::record<T>(instrumentation::EventKind::deallocate, capacity() * sizeof(T));
+                }
+            }
+            if (resource_ == nullptr) {
+                // buffers that went through a ReallocatingMemoryResource never get here, but once both paths are
+                // inlined GCC cannot tell them apart
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-dealloc"
+#endif
+                delete[] begin();
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+            }
+            else if (begin_ != nullptr) {
+                using U = std::remove_const_t<T>;
+                U* memory = const_cast<U*>(begin());
+                const size_t c = capacity();
+                std::destroy_n(memory, c);
+                resource_->deallocate(memory, c * sizeof(U), alignof(U));
+            }
+        }
     };
 }
@@ -0,0 +1,639 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+#include <Containers2/simd.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Lazy elementwise expressions over views: lazy(view) wraps a view, and operators on it build a tree of small
+// nodes that computes nothing. assign() and the reductions evaluate the whole tree in one loop over the elements,
+// with the SIMD dispatch of simd.hpp, so that a + b * c reads each operand once and writes once, without the
+// temporary Vectors of one loop per operator. Nothing is materialized but by assign() or to_vector().
+//
+// Operands of a binary node have the same element type: a scalar beside an expression converts to its element type,
+// other types need an explicit cast<U>(). Comparisons give expressions of bool, combined with &&, || and !, and
+// chosen between by select(). Operands must have the same size, checked where a node is built (std::invalid_argument
+// otherwise); a scalar has any size.
+// Nodes hold the views and scalars by value: an expression is valid as long as the memory of its views.
+namespace containers2::expr {
+
+    namespace detail {
+
+        struct Node {};
+
+#if CONTAINERS2_SIMD_X86
+        // attributes on alias templates are dropped: the vector type is declared in a class template
+        template<typename T, size_t L>
+        struct vector_of
+        {
+            typedef T type __attribute__((vector_size(L * sizeof(T))));
+        };
+
+        template<typename T, size_t L>
+        using vec = typename vector_of<T, L>::type;
+
+        template<size_t Bytes>
+        using mask_lane = std::conditional_t<Bytes == 1, std::int8_t, std::conditional_t<Bytes == 2, std::int16_t,
+            std::conditional_t<Bytes == 4, std::int32_t, std::int64_t>>>;
+
+        // bool lanes of vectors are 0 or -1 over Bytes bytes, as vector comparisons produce them
+        template<size_t Bytes, size_t L>
+        using mask = vec<mask_lane<Bytes>, L>;
+#endif
+
+        template<typename Op>
+        inline constexpr bool is_comparison_v = simd::VectorComparison<Op>;
+
+        template<typename Op>
+        inline constexpr bool is_logical_v = std::is_same_v<Op, std::logical_and<>> || std::is_same_v<Op, std::logical_or<>>;
+
+        struct Minimum
+        {
+            template<typename T>
+            constexpr T operator()(T a, T b) const { return b < a ? b : a; }
+        };
+
+        struct Maximum
+        {
+            template<typename T>
+            constexpr T operator()(T a, T b) const { return a < b ? b : a; }
+        };
+    }
+
+    template<typename E>
+    concept Expression = std::derived_from<E, detail::Node>;
+
+    template<Expression E>
+    using value_t = typename E::value_type;
+
+    template<typename E>
+    concept ArithmeticExpression = Expression<E> && simd::Arithmetic<value_t<E>>;
+
+    template<typename E>
+    concept BoolExpression = Expression<E> && std::same_as<value_t<E>, bool>;
+
+    // The elements of a view. Nodes are evaluated one at a time through operator[], and L at a time through
+    // load<L>() into lanes<L>: vectors of value_type, or masks for bool.
+    template<typename T>
+    struct Leaf : detail::Node
+    {
+        using value_type = T;
+        // widest element in the tree: L lanes of it fill a SIMD register
+        static constexpr size_t widest = sizeof(T);
+        // the width of the lanes of bool nodes
+        static constexpr size_t mask_bytes = sizeof(T);
+
+        const T* data_;
+        size_t size_;
+
+        size_t size() const noexcept { return size_; }
+
+        CONTAINERS2_SIMD_INLINE T operator[](size_t i) const { return data_[i]; }
+
+#if CONTAINERS2_SIMD_X86
+        template<size_t L>
+        using lanes = std::conditional_t<std::is_same_v<T, bool>, detail::mask<1, L>, detail::vec<std::conditional_t<std::is_same_v<T, bool>, std::int8_t, T>, L>>;
+
+        template<size_t L>
+        CONTAINERS2_SIMD_INLINE void load(size_t i, lanes<L>& out) const
+        {
+            std::memcpy(&out, data_ + i, sizeof(out));
+            if constexpr (std::is_same_v<T, bool>) {
+                out = -out;
+            }
+        }
+#endif
+    };
+
+    // a scalar beside an expression
+    template<typename T>
+    struct Constant : detail::Node
+    {
+        using value_type = T;
+        static constexpr size_t widest = sizeof(T);
+        static constexpr size_t mask_bytes = sizeof(T);
+
+        T value_;
+
+        // any size: the other operand decides
+        size_t size() const noexcept { return std::numeric_limits<size_t>::max(); }
+
+        CONTAINERS2_SIMD_INLINE T operator[](size_t) const { return value_; }
+
+#if CONTAINERS2_SIMD_X86
+        template<size_t L>
+        using lanes = detail::vec<T, L>;
+
+        template<size_t L>
+        CONTAINERS2_SIMD_INLINE void load(size_t, lanes<L>& out) const
+        {
+            out = lanes<L>{} + value_;
+        }
+#endif
+    };
+
+    // Op is std::negate<> or std::logical_not<>
+    template<typename Op, Expression A>
+    struct Unary : detail::Node
+    {
+        using value_type = value_t<A>;
+        static constexpr size_t widest = A::widest;
+        static constexpr size_t mask_bytes = A::mask_bytes;
+
+        A a_;
+
+        size_t size() const noexcept { return a_.size(); }
+
+        // the cast undoes the promotion of small integers
+        CONTAINERS2_SIMD_INLINE value_type operator[](size_t i) const { return static_cast<value_type>(Op{}(a_[i])); }
+
+#if CONTAINERS2_SIMD_X86
+        template<size_t L>
+        using lanes = typename A::template lanes<L>;
+
+        template<size_t L>
+        CONTAINERS2_SIMD_INLINE void load(size_t i, lanes<L>& out) const
+        {
+            a_.template load<L>(i, out);
+            if constexpr (std::is_same_v<Op, std::logical_not<>>) {
+                out = ~out;
+            }
+            else {
+                out = -out;
+            }
+        }
+#endif
+    };
+
+    // Op is an arithmetic std:: function object, Minimum, Maximum, a comparison, std::logical_and<> or std::logical_or<>
+    template<typename Op, Expression A, Expression B>
+    struct Binary : detail::Node
+    {
+        using operand_type = value_t<A>;
+        using value_type = std::conditional_t<detail::is_comparison_v<Op>, bool, operand_type>;
+        static constexpr size_t widest = std::max(A::widest, B::widest);
+        // comparisons give lanes of the width of their operands, logical operators take the width of the left one
+        static constexpr size_t mask_bytes = [] {
+            if constexpr (detail::is_logical_v<Op>) {
+                return A::mask_bytes;
+            }
+            else {
+                return sizeof(operand_type);
+            }
+        }();
+
+        A a_;
+        B b_;
+
+        // the size of the operand that is not a Constant
+        size_t size() const noexcept { return std::min(a_.size(), b_.size()); }
+
+        CONTAINERS2_SIMD_INLINE value_type operator[](size_t i) const { return static_cast<value_type>(Op{}(a_[i], b_[i])); }
+
+#if CONTAINERS2_SIMD_X86
+        template<size_t L>
+        using lanes = std::conditional_t<std::is_same_v<value_type, bool>, detail::mask<mask_bytes, L>, detail::vec<std::conditional_t<std::is_same_v<operand_type, bool>, std::int8_t, operand_type>, L>>;
+
+        template<size_t L>
+        CONTAINERS2_SIMD_INLINE void load(size_t i, lanes<L>& out) const
+        {
+            typename A::template lanes<L> a;
+            typename B::template lanes<L> b;
+            a_.template load<L>(i, a);
+            b_.template load<L>(i, b);
+            // spelled out rather than calling Op{}, whose operator() would pass vectors across a call
+            if constexpr (std::is_same_v<Op, std::plus<>>) {
+                out = a + b;
+            }
+            else if constexpr (std::is_same_v<Op, std::minus<>>) {
+                out = a - b;
+            }
+            else if constexpr (std::is_same_v<Op, std::multiplies<>>) {
+                out = a * b;
+            }
+            else if constexpr (std::is_same_v<Op, std::divides<>>) {
+                out = a / b;
+            }
+            else if constexpr (std::is_same_v<Op, detail::Minimum>) {
+                out = b < a ? b : a;
+            }
+            else if constexpr (std::is_same_v<Op, detail::Maximum>) {
+                out = a < b ? b : a;
+            }
+            else if constexpr (std::is_same_v<Op, std::equal_to<>>) {
+                out = a == b;
+            }
+            else if constexpr (std::is_same_v<Op, std::not_equal_to<>>) {
+                out = a != b;
+            }
+            else if constexpr (std::is_same_v<Op, std::less<>>) {
+                out = a < b;
+            }
+            else if constexpr (std::is_same_v<Op, std::less_equal<>>) {
+                out = a <= b;
+            }
+            else if constexpr (std::is_same_v<Op, std::greater<>>) {
+                out = a > b;
+            }
+            else if constexpr (std::is_same_v<Op, std::greater_equal<>>) {
+                out = a >= b;
+            }
+            else if constexpr (std::is_same_v<Op, std::logical_and<>>) {
+                out = a & __builtin_convertvector(b, lanes<L>);
+            }
+            else {
+                out = a | __builtin_convertvector(b, lanes<L>);
+            }
+        }
+#endif
+    };
+
+    template<typename U, ArithmeticExpression A>
+    struct Cast : detail::Node
+    {
+        using value_type = U;
+        static constexpr size_t widest = std::max(sizeof(U), A::widest);
+        static constexpr size_t mask_bytes = sizeof(U);
+
+        A a_;
+
+        size_t size() const noexcept { return a_.size(); }
+
+        CONTAINERS2_SIMD_INLINE U operator[](size_t i) const { return static_cast<U>(a_[i]); }
+
+#if CONTAINERS2_SIMD_X86
+        template<size_t L>
+        using lanes = detail::vec<U, L>;
+
+        template<size_t L>
+        CONTAINERS2_SIMD_INLINE void load(size_t i, lanes<L>& out) const
+        {
+            typename A::template lanes<L> a;
+            a_.template load<L>(i, a);
+            out = __builtin_convertvector(a, lanes<L>);
+        }
+#endif
+    };
+
+    template<BoolExpression C, Expression A, Expression B>
+    struct Select : detail::Node
+    {
+        using value_type = value_t<A>;
+        static constexpr size_t widest = std::max({ C::widest, A::widest, B::widest });
+        static constexpr size_t mask_bytes = sizeof(value_type);
+
+        C c_;
+        A a_;
+        B b_;
+
+        // the size of the operands that are not a Constant
+        size_t size() const noexcept { return std::min({ c_.size(), a_.size(), b_.size() }); }
+
+        CONTAINERS2_SIMD_INLINE value_type operator[](size_t i) const { return c_[i] ? a_[i] : b_[i]; }
+
+#if CONTAINERS2_SIMD_X86
+        template<size_t L>
+        using lanes = detail::vec<value_type, L>;
+
+        template<size_t L>
+        CONTAINERS2_SIMD_INLINE void load(size_t i, lanes<L>& out) const
+        {
+            typename C::template lanes<L> c;
+            lanes<L> a;
+            lanes<L> b;
+            c_.template load<L>(i, c);
+            a_.template load<L>(i, a);
+            b_.template load<L>(i, b);
+            out = __builtin_convertvector(c, detail::mask<sizeof(value_type), L>) ? a : b;
+        }
+#endif
+    };
+
+    // the views expressions start from; not from temporary containers, which would leave them dangling
+    template<typename T>
+    Leaf<std::remove_const_t<T>> lazy(const VectorView<T>& view) noexcept
+    {
+        return { {}, view.data(), view.size() };
+    }
+
+    template<typename T>
+    void lazy(Vector<T>&&) = delete;
+
+    template<OwningContainerRvalue C>
+    void lazy(C&&) = delete;
+
+    namespace detail {
+
+        // an expression as is, or a scalar as a Constant of the element type T
+        template<typename T, typename X>
+        auto operand(const X& x)
+        {
+            if constexpr (Expression<X>) {
+                return x;
+            }
+            else {
+                return Constant<T>{ {}, static_cast<T>(x) };
+            }
+        }
+
+        template<typename A, typename B>
+        struct operand_type : std::type_identity<value_t<A>> {};
+
+        template<typename A, typename B> requires(!Expression<A>)
+        struct operand_type<A, B> : std::type_identity<value_t<B>> {};
+
+        // the operands of a node, Constants aside, have the same size
+        inline void check_sizes(std::initializer_list<size_t> sizes)
+        {
+            constexpr size_t any = std::numeric_limits<size_t>::max();
+            size_t common = any;
+            for (size_t s : sizes) {
+                if (s != any && common != any && s != common) {
+                    throw std::invalid_argument("expr: operands of different sizes");
+                }
+                common = std::min(common, s);
+            }
+        }
+
+        template<typename Op, typename A, typename B>
+        auto binary(const A& a, const B& b)
+        {
+            using T = typename operand_type<A, B>::type;
+            using OA = decltype(operand<T>(a));
+            using OB = decltype(operand<T>(b));
+            Binary<Op, OA, OB> node{ {}, operand<T>(a), operand<T>(b) };
+            check_sizes({ node.a_.size(), node.b_.size() });
+            return node;
+        }
+    }
+
+    // two expressions of the same element type, or one and a scalar that converts to it
+    template<typename A, typename B>
+    concept ArithmeticOperands =
+        (ArithmeticExpression<A> && ArithmeticExpression<B> && std::same_as<value_t<A>, value_t<B>>) ||
+        (ArithmeticExpression<A> && !Expression<B> && std::convertible_to<B, value_t<A>>) ||
+        (!Expression<A> && ArithmeticExpression<B> && std::convertible_to<A, value_t<B>>);
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator + (const A& a, const B& b) { return detail::binary<std::plus<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator - (const A& a, const B& b) { return detail::binary<std::minus<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator * (const A& a, const B& b) { return detail::binary<std::multiplies<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator / (const A& a, const B& b) { return detail::binary<std::divides<>>(a, b); }
+
+    // elementwise b < a ? b : a
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto minimum(const A& a, const B& b) { return detail::binary<detail::Minimum>(a, b); }
+
+    // elementwise a < b ? b : a
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto maximum(const A& a, const B& b) { return detail::binary<detail::Maximum>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator == (const A& a, const B& b) { return detail::binary<std::equal_to<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator != (const A& a, const B& b) { return detail::binary<std::not_equal_to<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator < (const A& a, const B& b) { return detail::binary<std::less<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator <= (const A& a, const B& b) { return detail::binary<std::less_equal<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator > (const A& a, const B& b) { return detail::binary<std::greater<>>(a, b); }
+
+    template<typename A, typename B> requires ArithmeticOperands<A, B>
+    auto operator >= (const A& a, const B& b) { return detail::binary<std::greater_equal<>>(a, b); }
+
+    template<ArithmeticExpression A>
+    Unary<std::negate<>, A> operator - (const A& a) { return { {}, a }; }
+
+    // elementwise, both sides are evaluated
+    template<BoolExpression A, BoolExpression B>
+    Binary<std::logical_and<>, A, B> operator && (const A& a, const B& b)
+    {
+        detail::check_sizes({ a.size(), b.size() });
+        return { {}, a, b };
+    }
+
+    template<BoolExpression A, BoolExpression B>
+    Binary<std::logical_or<>, A, B> operator || (const A& a, const B& b)
+    {
+        detail::check_sizes({ a.size(), b.size() });
+        return { {}, a, b };
+    }
+
+    template<BoolExpression A>
+    Unary<std::logical_not<>, A> operator ! (const A& a) { return { {}, a }; }
+
+    template<simd::Arithmetic U, ArithmeticExpression A>
+    Cast<U, A> cast(const A& a) { return { {}, a }; }
+
+    // elementwise c ? a : b, with a and b expressions of the same element type or one of them a scalar
+    template<BoolExpression C, typename A, typename B> requires ArithmeticOperands<A, B>
+    auto select(const C& c, const A& a, const B& b)
+    {
+        using T = typename detail::operand_type<A, B>::type;
+        using OA = decltype(detail::operand<T>(a));
+        using OB = decltype(detail::operand<T>(b));
+        Select<C, OA, OB> node{ {}, c, detail::operand<T>(a), detail::operand<T>(b) };
+        detail::check_sizes({ node.c_.size(), node.a_.size(), node.b_.size() });
+        return node;
+    }
+
+    namespace detail {
+
+        // L lanes of the widest element fill Bytes: narrower elements take fractions of a register
+        template<size_t Bytes, Expression E>
+        inline constexpr size_t lanes = Bytes / E::widest;
+
+        struct Assign
+        {
+            template<size_t Bytes, typename E>
+            CONTAINERS2_SIMD_INLINE static void run(E e, value_t<E>* out, size_t n)
+            {
+                size_t i = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    constexpr size_t L = lanes<Bytes, E>;
+                    for (; i + L <= n; i += L) {
+                        typename E::template lanes<L> v;
+                        e.template load<L>(i, v);
+                        if constexpr (std::is_same_v<value_t<E>, bool>) {
+                            for (size_t l = 0; l < L; ++l) {
+                                out[i + l] = static_cast<bool>(v[l] & 1);
+                            }
+                        }
+                        else {
+                            std::memcpy(out + i, &v, sizeof(v));
+                        }
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    out[i] = e[i];
+                }
+            }
+        };
+
+        struct Sum
+        {
+            template<size_t Bytes, typename E>
+            CONTAINERS2_SIMD_INLINE static value_t<E> run(E e, size_t n)
+            {
+                size_t i = 0;
+                value_t<E> result{};
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    constexpr size_t L = lanes<Bytes, E>;
+                    // two independent accumulators, as simd::sum
+                    typename E::template lanes<L> acc0{};
+                    typename E::template lanes<L> acc1{};
+                    for (; i + 2 * L <= n; i += 2 * L) {
+                        typename E::template lanes<L> v0;
+                        typename E::template lanes<L> v1;
+                        e.template load<L>(i, v0);
+                        e.template load<L>(i + L, v1);
+                        acc0 += v0;
+                        acc1 += v1;
+                    }
+                    acc0 += acc1;
+                    for (size_t l = 0; l < L; ++l) {
+                        result += acc0[l];
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result += e[i];
+                }
+                return result;
+            }
+        };
+
+        template<bool Max>
+        struct MinMax
+        {
+            template<size_t Bytes, typename E>
+            CONTAINERS2_SIMD_INLINE static value_t<E> run(E e, size_t n)
+            {
+                using T = value_t<E>;
+                size_t i = 0;
+                T result = Max ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    constexpr size_t L = lanes<Bytes, E>;
+                    typename E::template lanes<L> acc = typename E::template lanes<L>{} + result;
+                    for (; i + L <= n; i += L) {
+                        typename E::template lanes<L> v;
+                        e.template load<L>(i, v);
+                        if constexpr (Max) {
+                            acc = v > acc ? v : acc;
+                        }
+                        else {
+                            acc = v < acc ? v : acc;
+                        }
+                    }
+                    for (size_t l = 0; l < L; ++l) {
+                        result = Max ? std::max<T>(result, acc[l]) : std::min<T>(result, acc[l]);
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result = Max ? std::max<T>(result, e[i]) : std::min<T>(result, e[i]);
+                }
+                return result;
+            }
+        };
+
+        struct Count
+        {
+            template<size_t Bytes, typename E>
+            CONTAINERS2_SIMD_INLINE static size_t run(E e, size_t n)
+            {
+                size_t i = 0;
+                size_t result = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    constexpr size_t L = lanes<Bytes, E>;
+                    while (i + L <= n) {
+                        // true lanes are -1: subtract them, flushing before 8-bit lanes can overflow
+                        typename E::template lanes<L> acc{};
+                        for (size_t block = 0; block < 64 && i + L <= n; ++block, i += L) {
+                            typename E::template lanes<L> v;
+                            e.template load<L>(i, v);
+                            acc -= v;
+                        }
+                        for (size_t l = 0; l < L; ++l) {
+                            result += static_cast<size_t>(acc[l]);
+                        }
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result += e[i];
+                }
+                return result;
+            }
+        };
+    }
+
+    // out[i] = e[i]: the only evaluation into memory; out must have the size of e (std::invalid_argument otherwise)
+    // and not overlap its views unless out is one of them, read and written at the same positions
+    template<Expression E>
+    void assign(VectorView<value_t<E>> out, const E& e, simd::Isa isa = simd::detected_isa())
+    {
+        if (out.size() != e.size()) {
+            throw std::invalid_argument("expr::assign: the output and the expression have different sizes");
+        }
+        simd::detail::dispatch<detail::Assign>(isa, e, out.data(), out.size());
+    }
+
+    template<Expression E>
+    Vector<value_t<E>> to_vector(const E& e, simd::Isa isa = simd::detected_isa())
+    {
+        Vector<value_t<E>> result(e.size(), uninitialized_tag);
+        assign(result, e, isa);
+        return result;
+    }
+
+    // reductions evaluate the expression without storing it, with the conventions of their simd:: counterparts
+    template<ArithmeticExpression E>
+    value_t<E> sum(const E& e, simd::Isa isa = simd::detected_isa())
+    {
+        return simd::detail::dispatch<detail::Sum>(isa, e, e.size());
+    }
+
+    template<ArithmeticExpression E>
+    value_t<E> min(const E& e, simd::Isa isa = simd::detected_isa())
+    {
+        return simd::detail::dispatch<detail::MinMax<false>>(isa, e, e.size());
+    }
+
+    template<ArithmeticExpression E>
+    value_t<E> max(const E& e, simd::Isa isa = simd::detected_isa())
+    {
+        return simd::detail::dispatch<detail::MinMax<true>>(isa, e, e.size());
+    }
+
+    // the number of true elements
+    template<BoolExpression E>
+    size_t count(const E& e, simd::Isa isa = simd::detected_isa())
+    {
+        return simd::detail::dispatch<detail::Count>(isa, e, e.size());
+    }
+}
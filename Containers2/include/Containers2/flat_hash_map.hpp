@@ -0,0 +1,413 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTAINERS2_HASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define CONTAINERS2_HASH_SSE2 0
+#endif
+
+namespace containers2 {
+
+    namespace detail {
+
+        // control bytes: a full slot holds the low 7 bits of its hash (0..127), the others are negative
+        inline constexpr std::int8_t control_empty = -128;
+        inline constexpr std::int8_t control_deleted = -2;
+
+        // 16 control bytes probed at once; every mask has bit i set for byte i
+        struct HashGroup
+        {
+            static constexpr size_t width = 16;
+
+#if CONTAINERS2_HASH_SSE2
+            __m128i control;
+
+            explicit HashGroup(const std::int8_t* p) noexcept : control{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) } {}
+
+            std::uint32_t match(std::int8_t h2) const noexcept
+            {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), control)));
+            }
+
+            std::uint32_t match_empty() const noexcept { return match(control_empty); }
+
+            std::uint32_t match_empty_or_deleted() const noexcept
+            {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), control)));
+            }
+#else
+            const std::int8_t* control;
+
+            explicit HashGroup(const std::int8_t* p) noexcept : control{ p } {}
+
+            template<typename Predicate>
+            std::uint32_t mask(Predicate predicate) const noexcept
+            {
+                std::uint32_t m = 0;
+                for (size_t i = 0; i < width; ++i) {
+                    m |= static_cast<std::uint32_t>(predicate(control[i])) << i;
+                }
+                return m;
+            }
+
+            std::uint32_t match(std::int8_t h2) const noexcept { return mask([h2](std::int8_t c) { return c == h2; }); }
+            std::uint32_t match_empty() const noexcept { return match(control_empty); }
+            std::uint32_t match_empty_or_deleted() const noexcept { return mask([](std::int8_t c) { return c < -1; }); }
+#endif
+        };
+
+        // the control bytes of a map without storage: every probe stops at the first group
+        alignas(HashGroup::width) inline const std::int8_t empty_group[HashGroup::width]{
+            control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty,
+            control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty };
+
+        // std::hash of integers is the identity: mix the bits so that both the probe position (high bits) and the
+        // control byte (low 7 bits) depend on all of them
+        inline size_t mix_hash(size_t h) noexcept
+        {
+            const std::uint64_t product = static_cast<std::uint64_t>(h) * 0x9e3779b97f4a7c15;
+            return static_cast<size_t>(product ^ (product >> 32));
+        }
+    }
+
+    // Read-only view of a FlatHashMap: control bytes, slots and capacity, trivially copyable whenever Hash and Eq are.
+    // Lookups never write, so any number of threads can share a view as long as nobody modifies the map.
+    // Probing: the hash picks a group of 16 control bytes, compared with the 7-bit tag of the key at once, and the
+    // groups follow a triangular sequence that visits all of them until one with an empty byte ends the search.
+    template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+    struct FlatHashMapView
+    {
+        using Slot = std::pair<K, V>;
+
+        // capacity + width bytes: the last width - 1 mirror the first ones so that a group can start at any slot
+        const std::int8_t* control_ = detail::empty_group;
+        const Slot* slots_ = nullptr;
+        size_t mask_ = 0; // capacity - 1
+        size_t size_ = 0;
+        [[no_unique_address]] Hash hash_{};
+        [[no_unique_address]] Eq eq_{};
+
+        FlatHashMapView() noexcept = default;
+
+        template<OwningContainerRvalue C>
+        FlatHashMapView(C&&) = delete;
+        template<OwningContainerRvalue C>
+        FlatHashMapView& operator = (C&&) = delete;
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t capacity() const noexcept { return slots_ == nullptr ? 0 : mask_ + 1; }
+        double load_factor() const noexcept { return capacity() == 0 ? 0.0 : static_cast<double>(size_) / static_cast<double>(capacity()); }
+
+        // nullptr if key is absent
+        const V* find(const K& key) const
+        {
+            const size_t i = find_index(key, detail::mix_hash(hash_(key)));
+            return i == npos ? nullptr : &slots_[i].second;
+        }
+
+        bool contains(const K& key) const { return find(key) != nullptr; }
+
+        // out[i] = find(keys[i]), with the control group of later keys prefetched while the earlier ones are probed
+        void find(VectorView<const K> keys, VectorView<const V*> out) const
+        {
+            constexpr size_t batch = 16;
+            size_t hashes[batch];
+            for (size_t first = 0; first < keys.size(); first += batch) {
+                const size_t n = std::min(batch, keys.size() - first);
+                for (size_t j = 0; j < n; ++j) {
+                    hashes[j] = detail::mix_hash(hash_(keys[first + j]));
+                    detail::prefetch(control_ + ((hashes[j] >> 7) & mask_));
+                }
+                for (size_t j = 0; j < n; ++j) {
+                    const size_t i = find_index(keys[first + j], hashes[j]);
+                    out[first + j] = i == npos ? nullptr : &slots_[i].second;
+                }
+            }
+        }
+
+        // calls f(const K&, const V&) on every element, in slot order
+        template<typename F>
+        void for_each(F&& f) const
+        {
+            for (size_t i = 0; i < capacity(); ++i) {
+                if (control_[i] >= 0) {
+                    f(std::as_const(slots_[i].first), slots_[i].second);
+                }
+            }
+        }
+
+    protected:
+        static constexpr size_t npos = ~size_t{ 0 };
+
+        size_t find_index(const K& key, size_t hash) const
+        {
+            const auto h2 = static_cast<std::int8_t>(hash & 0x7f);
+            size_t position = (hash >> 7) & mask_;
+            for (size_t step = detail::HashGroup::width;; step += detail::HashGroup::width) {
+                const detail::HashGroup group{ control_ + position };
+                for (std::uint32_t m = group.match(h2); m != 0; m &= m - 1) {
+                    const size_t i = (position + static_cast<size_t>(std::countr_zero(m))) & mask_;
+                    if (eq_(slots_[i].first, key)) {
+                        return i;
+                    }
+                }
+                if (group.match_empty() != 0) {
+                    return npos;
+                }
+                position = (position + step) & mask_;
+            }
+        }
+    };
+
+    // Open-addressing hash map owning its storage the way Vector does: a Vector of control bytes and a Vector of
+    // slots, every slot constructed (K and V must be default constructible) and full ones marked by their control
+    // byte. At most 7/8 of the slots are used, erased slots become tombstones until the next rehash.
+    // Move-only: clone() is the explicit deep copy. References to values stay valid until the next rehash.
+    template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+    struct FlatHashMap : FlatHashMapView<K, V, Hash, Eq>
+    {
+        using super = FlatHashMapView<K, V, Hash, Eq>;
+        using typename super::Slot;
+        using super::control_;
+        using super::slots_;
+        using super::mask_;
+        using super::size_;
+        using super::hash_;
+        using super::eq_;
+
+        static constexpr size_t min_capacity = detail::HashGroup::width;
+
+        Vector<std::int8_t> control_buffer_;
+        Vector<Slot> slot_buffer_;
+        size_t growth_left_ = 0; // insertions into empty slots before the next rehash
+
+        FlatHashMap() noexcept = default;
+
+        explicit FlatHashMap(size_t n)
+        {
+            reserve(n);
+        }
+
+        // non-copyable, see clone()
+        FlatHashMap(const FlatHashMap&) = delete;
+        FlatHashMap& operator = (const FlatHashMap&) = delete;
+
+        FlatHashMap(FlatHashMap&& rhs) noexcept :
+            super{ std::exchange(static_cast<super&>(rhs), {}) },
+            control_buffer_{ std::move(rhs.control_buffer_) }, slot_buffer_{ std::move(rhs.slot_buffer_) },
+            growth_left_{ std::exchange(rhs.growth_left_, 0) } {}
+
+        FlatHashMap& operator = (FlatHashMap&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                super::operator =(std::exchange(static_cast<super&>(rhs), {}));
+                control_buffer_ = std::move(rhs.control_buffer_);
+                slot_buffer_ = std::move(rhs.slot_buffer_);
+                growth_left_ = std::exchange(rhs.growth_left_, 0);
+            }
+            return *this;
+        }
+
+        ~FlatHashMap() noexcept = default;
+
+        FlatHashMap clone() const
+        {
+            FlatHashMap copy;
+            static_cast<super&>(copy) = *this;
+            if (slots_ != nullptr) {
+                copy.control_buffer_ = Vector<std::int8_t>{ control_buffer_.size(), uninitialized_tag };
+                std::copy(control_buffer_.begin(), control_buffer_.end(), copy.control_buffer_.begin());
+                copy.slot_buffer_ = Vector<Slot>{ slot_buffer_.size(), uninitialized_tag };
+                std::copy(slot_buffer_.begin(), slot_buffer_.end(), copy.slot_buffer_.begin());
+                copy.control_ = copy.control_buffer_.data();
+                copy.slots_ = copy.slot_buffer_.data();
+            }
+            copy.growth_left_ = growth_left_;
+            return copy;
+        }
+
+        using super::find;
+
+        V* find(const K& key)
+        {
+            return const_cast<V*>(super::find(key));
+        }
+
+        // inserts key with value unless key is present; returns the value in the map and whether it was inserted
+        std::pair<V*, bool> insert(const K& key, V value)
+        {
+            return insert_hashed(key, detail::mix_hash(hash_(key)), std::move(value));
+        }
+
+        V& operator[](const K& key)
+        {
+            return *insert(key, V{}).first;
+        }
+
+        std::pair<V*, bool> insert_or_assign(const K& key, V value)
+        {
+            const size_t hash = detail::mix_hash(hash_(key));
+            const size_t i = this->find_index(key, hash);
+            if (i != super::npos) {
+                slot(i).second = std::move(value);
+                return { &slot(i).second, false };
+            }
+            return insert_hashed(key, hash, std::move(value));
+        }
+
+        // inserts keys[i] with values[i] for every key not present yet (the first occurrence wins): one reserve, then
+        // insertions with the control group of later keys prefetched
+        void insert(VectorView<const K> keys, VectorView<const V> values)
+        {
+            reserve(size_ + keys.size());
+            constexpr size_t batch = 16;
+            size_t hashes[batch];
+            for (size_t first = 0; first < keys.size(); first += batch) {
+                const size_t n = std::min(batch, keys.size() - first);
+                for (size_t j = 0; j < n; ++j) {
+                    hashes[j] = detail::mix_hash(hash_(keys[first + j]));
+                    detail::prefetch(control_ + ((hashes[j] >> 7) & mask_));
+                }
+                for (size_t j = 0; j < n; ++j) {
+                    insert_hashed(keys[first + j], hashes[j], values[first + j]);
+                }
+            }
+        }
+
+        bool erase(const K& key)
+        {
+            const size_t i = this->find_index(key, detail::mix_hash(hash_(key)));
+            if (i == super::npos) {
+                return false;
+            }
+            set_control(i, detail::control_deleted);
+            slot(i) = Slot{}; // releases what the element owns
+            --size_;
+            return true;
+        }
+
+        // keeps the capacity
+        void clear()
+        {
+            if (slots_ == nullptr) {
+                return;
+            }
+            std::fill(control_buffer_.begin(), control_buffer_.end(), detail::control_empty);
+            std::fill(slot_buffer_.begin(), slot_buffer_.end(), Slot{});
+            size_ = 0;
+            growth_left_ = max_load(this->capacity());
+        }
+
+        // room for n elements without rehashing
+        void reserve(size_t n)
+        {
+            size_t c = min_capacity;
+            while (max_load(c) < n) {
+                c *= 2;
+            }
+            if (c > this->capacity() || (n > size_ + growth_left_ && c == this->capacity())) {
+                rehash(c);
+            }
+        }
+
+        // the value in a full slot and the slot storage are mutable, the key is not
+        template<typename F>
+        void for_each(F&& f)
+        {
+            for (size_t i = 0; i < this->capacity(); ++i) {
+                if (control_[i] >= 0) {
+                    f(std::as_const(slot(i).first), slot(i).second);
+                }
+            }
+        }
+
+        template<typename F>
+        void for_each(F&& f) const
+        {
+            super::for_each(std::forward<F>(f));
+        }
+
+    private:
+        static size_t max_load(size_t c) noexcept { return c - c / 8; }
+
+        Slot& slot(size_t i) noexcept { return slot_buffer_[i]; }
+
+        // also writes the mirror of the first width - 1 bytes
+        void set_control(size_t i, std::int8_t c) noexcept
+        {
+            control_buffer_[i] = c;
+            control_buffer_[((i - (detail::HashGroup::width - 1)) & mask_) + (detail::HashGroup::width - 1)] = c;
+        }
+
+        // first empty or deleted slot of the probe sequence of hash
+        size_t find_free(size_t hash) const noexcept
+        {
+            size_t position = (hash >> 7) & mask_;
+            for (size_t step = detail::HashGroup::width;; step += detail::HashGroup::width) {
+                const std::uint32_t m = detail::HashGroup{ control_ + position }.match_empty_or_deleted();
+                if (m != 0) {
+                    return (position + static_cast<size_t>(std::countr_zero(m))) & mask_;
+                }
+                position = (position + step) & mask_;
+            }
+        }
+
+        std::pair<V*, bool> insert_hashed(const K& key, size_t hash, V value)
+        {
+            const size_t existing = this->find_index(key, hash);
+            if (existing != super::npos) {
+                return { &slot(existing).second, false };
+            }
+            size_t i = find_free(hash);
+            if (growth_left_ == 0 && control_[i] != detail::control_deleted) {
+                // many tombstones: same capacity, otherwise double it
+                rehash(size_ < max_load(this->capacity()) / 2 ? std::max(this->capacity(), min_capacity) : std::max(2 * this->capacity(), min_capacity));
+                i = find_free(hash);
+            }
+            growth_left_ -= control_[i] == detail::control_empty;
+            set_control(i, static_cast<std::int8_t>(hash & 0x7f));
+            slot(i).first = key;
+            slot(i).second = std::move(value);
+            ++size_;
+            return { &slot(i).second, true };
+        }
+
+        void rehash(size_t c)
+        {
+            FlatHashMap grown;
+            grown.control_buffer_ = Vector<std::int8_t>{ c + detail::HashGroup::width, detail::control_empty, initialized_tag };
+            grown.slot_buffer_ = Vector<Slot>{ c, uninitialized_tag };
+            grown.control_ = grown.control_buffer_.data();
+            grown.slots_ = grown.slot_buffer_.data();
+            grown.mask_ = c - 1;
+            grown.hash_ = hash_;
+            grown.eq_ = eq_;
+            grown.growth_left_ = max_load(c) - size_;
+            for (size_t i = 0; i < this->capacity(); ++i) {
+                if (control_[i] >= 0) {
+                    const size_t hash = detail::mix_hash(hash_(slot(i).first));
+                    const size_t j = grown.find_free(hash);
+                    grown.set_control(j, static_cast<std::int8_t>(hash & 0x7f));
+                    grown.slot(j) = std::move(slot(i));
+                }
+            }
+            grown.size_ = size_;
+            *this = std::move(grown);
+        }
+    };
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    inline constexpr bool is_owning_container_v<FlatHashMap<K, V, Hash, Eq>> = true;
+}
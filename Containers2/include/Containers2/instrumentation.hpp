@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <typeinfo>
+
+// Opt-in allocation and resize instrumentation of Vector: define CONTAINERS2_INSTRUMENTATION to 1 for the whole
+// program (every translation unit has to agree, Vector's member functions differ). When it is 0, the default, Vector
+// contains no instrumentation code at all and no container changes layout either way.
+#ifndef CONTAINERS2_INSTRUMENTATION
+#define CONTAINERS2_INSTRUMENTATION 0
+#endif
+
+namespace containers2::instrumentation {
+
+    inline constexpr bool enabled = CONTAINERS2_INSTRUMENTATION != 0;
+
+    // the Vector member function an event happened in: every resize tag, reserve, shrink_to_fit, clone and copy_from;
+    // other covers construction, assignment and destruction
+    enum class Operation { other, resize_uninitialized, resize_initialized, resize_non_preserving_uninitialized, resize_non_preserving_initialized, reserve, shrink_to_fit, clone, copy_from };
+
+    inline constexpr size_t operation_count = 9;
+
+    // allocate/deallocate: a buffer of bytes was obtained or released (a realloc reports both, old buffer first)
+    // reallocate: a resize moved the elements to a buffer of bytes from one of old_bytes, copying copied_bytes
+    // (0 when realloc grew the buffer in place)
+    enum class EventKind { allocate, deallocate, reallocate };
+
+    struct Event
+    {
+        EventKind kind;
+        Operation operation;
+        const std::type_info* type; // the element type
+        size_t bytes;
+        size_t old_bytes;
+        size_t copied_bytes;
+    };
+
+    struct Statistics
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t deallocations = 0;
+        std::uint64_t reallocations = 0;
+        std::uint64_t bytes_allocated = 0;
+        std::uint64_t bytes_deallocated = 0;
+        std::uint64_t bytes_copied = 0;
+        std::uint64_t bytes_live = 0;
+        std::uint64_t bytes_live_high_water = 0;
+    };
+
+    // thread-safe counters; relaxed, a snapshot taken while other threads allocate is not a consistent cut
+    struct Counters
+    {
+        std::atomic<std::uint64_t> allocations{ 0 };
+        std::atomic<std::uint64_t> deallocations{ 0 };
+        std::atomic<std::uint64_t> reallocations{ 0 };
+        std::atomic<std::uint64_t> bytes_allocated{ 0 };
+        std::atomic<std::uint64_t> bytes_deallocated{ 0 };
+        std::atomic<std::uint64_t> bytes_copied{ 0 };
+        std::atomic<std::uint64_t> bytes_live{ 0 };
+        std::atomic<std::uint64_t> bytes_live_high_water{ 0 };
+
+        void record(const Event& event) noexcept
+        {
+            constexpr auto relaxed = std::memory_order_relaxed;
+            switch (event.kind) {
+            case EventKind::allocate: {
+                allocations.fetch_add(1, relaxed);
+                bytes_allocated.fetch_add(event.bytes, relaxed);
+                const std::uint64_t live = bytes_live.fetch_add(event.bytes, relaxed) + event.bytes;
+                std::uint64_t high_water = bytes_live_high_water.load(relaxed);
+                while (live > high_water && !bytes_live_high_water.compare_exchange_weak(high_water, live, relaxed)) {}
+                break;
+            }
+            case EventKind::deallocate:
+                deallocations.fetch_add(1, relaxed);
+                bytes_deallocated.fetch_add(event.bytes, relaxed);
+                bytes_live.fetch_sub(event.bytes, relaxed);
+                break;
+            case EventKind::reallocate:
+                reallocations.fetch_add(1, relaxed);
+                bytes_copied.fetch_add(event.copied_bytes, relaxed);
+                break;
+            }
+        }
+
+        Statistics snapshot() const noexcept
+        {
+            constexpr auto relaxed = std::memory_order_relaxed;
+            return { allocations.load(relaxed), deallocations.load(relaxed), reallocations.load(relaxed), bytes_allocated.load(relaxed),
+                bytes_deallocated.load(relaxed), bytes_copied.load(relaxed), bytes_live.load(relaxed), bytes_live_high_water.load(relaxed) };
+        }
+
+        // also restarts the high-water mark from the bytes live now
+        void reset() noexcept
+        {
+            constexpr auto relaxed = std::memory_order_relaxed;
+            const std::uint64_t live = bytes_live.load(relaxed);
+            allocations.store(0, relaxed);
+            deallocations.store(0, relaxed);
+            reallocations.store(0, relaxed);
+            bytes_allocated.store(0, relaxed);
+            bytes_deallocated.store(0, relaxed);
+            bytes_copied.store(0, relaxed);
+            bytes_live_high_water.store(live, relaxed);
+        }
+    };
+
+    // every Vector
+    inline Counters& totals() noexcept
+    {
+        static Counters counters;
+        return counters;
+    }
+
+    // Vector<T> and Vector<const T>
+    template<typename T>
+    Counters& by_type() noexcept
+    {
+        static Counters counters;
+        return counters;
+    }
+
+    inline Counters& by_operation(Operation operation) noexcept
+    {
+        static std::array<Counters, operation_count> counters;
+        return counters[static_cast<size_t>(operation)];
+    }
+
+    // called synchronously on the thread that caused the event, after the counters are updated; calls are serialized
+    // and must not use Vector themselves. Pass nullptr to remove it.
+    using Callback = void (*)(const Event& event, void* context);
+
+    namespace detail {
+        // the callback and its context change together under mutex_; installed_ keeps events lock-free without one
+        struct Hook
+        {
+            std::mutex mutex_;
+            Callback callback_ = nullptr;
+            void* context_ = nullptr;
+            std::atomic<bool> installed_{ false };
+        };
+
+        inline Hook& hook() noexcept
+        {
+            static Hook h;
+            return h;
+        }
+
+        inline thread_local Operation current_operation = Operation::other;
+
+        template<typename T>
+        void record(EventKind kind, size_t bytes, size_t old_bytes = 0, size_t copied_bytes = 0) noexcept
+        {
+            const Event event{ kind, current_operation, &typeid(T), bytes, old_bytes, copied_bytes };
+            totals().record(event);
+            by_type<std::remove_const_t<T>>().record(event);
+            by_operation(event.operation).record(event);
+            Hook& h = hook();
+            if (h.installed_.load(std::memory_order_relaxed)) {
+                std::lock_guard lock{ h.mutex_ };
+                if (h.callback_ != nullptr) {
+                    h.callback_(event, h.context_);
+                }
+            }
+        }
+
+        // attributes the events of a scope to operation; the outermost scope wins (initialized resizes call the
+        // uninitialized ones). Empty and free when instrumentation is compiled out.
+#if CONTAINERS2_INSTRUMENTATION
+        struct OperationScope
+        {
+            explicit OperationScope(Operation operation) noexcept : owner_{ current_operation == Operation::other }
+            {
+                if (owner_) {
+                    current_operation = operation;
+                }
+            }
+
+            OperationScope(const OperationScope&) = delete;
+            OperationScope& operator = (const OperationScope&) = delete;
+
+            ~OperationScope() noexcept
+            {
+                if (owner_) {
+                    current_operation = Operation::other;
+                }
+            }
+
+        private:
+            bool owner_;
+        };
+#else
+        struct OperationScope
+        {
+            explicit OperationScope(Operation) noexcept {}
+        };
+#endif
+    }
+
+    inline void set_callback(Callback callback, void* context = nullptr) noexcept
+    {
+        detail::Hook& h = detail::hook();
+        std::lock_guard lock{ h.mutex_ };
+        h.callback_ = callback;
+        h.context_ = context;
+        h.installed_.store(callback != nullptr, std::memory_order_relaxed);
+    }
+}
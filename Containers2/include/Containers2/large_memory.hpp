@@ -0,0 +1,222 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+#include <Containers2/parallel.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace containers2 {
+
+    // where the pages of a block go on a machine with several NUMA nodes: on the node of the thread writing them first
+    // (local, the kernel default), round-robin over all the nodes the process may use (interleave), or on one node (bind)
+    enum class NumaPolicy { local, interleave, bind };
+
+    namespace detail {
+#if defined(__linux__)
+        // the values of <numaif.h>, which comes with libnuma: the system calls themselves need no library
+        inline constexpr int mpol_bind = 2;
+        inline constexpr int mpol_interleave = 3;
+        inline constexpr unsigned long mpol_f_mems_allowed = 1 << 2;
+
+        struct NodeMask
+        {
+            static constexpr size_t max_nodes = 1024;
+            unsigned long words[max_nodes / (8 * sizeof(unsigned long))]{};
+
+            size_t count() const noexcept
+            {
+                size_t n = 0;
+                for (unsigned long word : words) {
+                    n += static_cast<size_t>(std::popcount(word));
+                }
+                return n;
+            }
+
+            bool contains(size_t node) const noexcept
+            {
+                constexpr size_t bits = 8 * sizeof(unsigned long);
+                return node < max_nodes && (words[node / bits] >> (node % bits) & 1) != 0;
+            }
+        };
+
+        // nodes the process may allocate from, none when the kernel has no NUMA support
+        inline const NodeMask& allowed_numa_nodes() noexcept
+        {
+            static const NodeMask nodes = [] {
+                NodeMask mask;
+                if (::syscall(SYS_get_mempolicy, nullptr, mask.words, NodeMask::max_nodes, nullptr, mpol_f_mems_allowed) != 0) {
+                    return NodeMask{};
+                }
+                return mask;
+            }();
+            return nodes;
+        }
+#endif
+    }
+
+    // at least 1, also without NUMA support
+    inline size_t numa_node_count() noexcept
+    {
+#if defined(__linux__)
+        return std::max<size_t>(detail::allowed_numa_nodes().count(), 1);
+#else
+        return 1;
+#endif
+    }
+
+    // Blocks of threshold bytes or more straight from mmap, for Vectors of gigabytes: aligned on huge pages, advised
+    // for transparent huge pages (MADV_HUGEPAGE, a hint the kernel may ignore) and placed by the NUMA policy. Pages are
+    // backed only when first written, so a Vector of trivial elements built with uninitialized_tag costs nothing until
+    // parallel::fill() touches it from every thread of a pool; with local placement its pages then spread over the
+    // nodes of those threads. Growth remaps the pages instead of copying them.
+    // Smaller blocks go to malloc_memory_resource(): a huge page per small Vector would waste memory.
+    // The policy degrades to the default placement when it cannot apply: a single node, a node the process may not
+    // use, or a kernel without NUMA support. Elsewhere than Linux every block goes to malloc_memory_resource().
+    struct LargePageMemoryResource final : ReallocatingMemoryResource
+    {
+        NumaPolicy policy_ = NumaPolicy::local;
+        size_t node_ = 0; // bind only
+        size_t threshold_ = huge_page_size;
+
+        explicit LargePageMemoryResource(NumaPolicy policy = NumaPolicy::local, size_t node = 0, size_t threshold = huge_page_size) noexcept :
+            policy_{ policy }, node_{ node }, threshold_{ threshold } {}
+
+        static constexpr size_t mapped_bytes(size_t bytes) noexcept { return (bytes + huge_page_size - 1) & ~(huge_page_size - 1); }
+
+        // whether a block of bytes is mapped rather than taken from malloc
+        bool maps(size_t bytes, size_t alignment) const noexcept
+        {
+#if defined(__linux__)
+            return bytes >= threshold_ && bytes != 0 && alignment <= huge_page_size;
+#else
+            (void)bytes;
+            (void)alignment;
+            return false;
+#endif
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (!maps(bytes, alignment)) {
+                return malloc_memory_resource()->allocate(bytes, alignment);
+            }
+#if defined(__linux__)
+            // one huge page more than needed, then the unaligned head and the tail are unmapped
+            const size_t length = mapped_bytes(bytes);
+            void* address = ::mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (address == MAP_FAILED) {
+                throw std::bad_alloc{};
+            }
+            auto* mapped = static_cast<std::byte*>(address);
+            const size_t head = (huge_page_size - reinterpret_cast<std::uintptr_t>(mapped) % huge_page_size) % huge_page_size;
+            if (head != 0) {
+                ::munmap(mapped, head);
+            }
+            ::munmap(mapped + head + length, huge_page_size - head);
+            advise(mapped + head, length);
+            return mapped + head;
+#else
+            return nullptr;
+#endif
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            if (!maps(bytes, alignment)) {
+                malloc_memory_resource()->deallocate(p, bytes, alignment);
+                return;
+            }
+#if defined(__linux__)
+            ::munmap(p, mapped_bytes(bytes));
+#endif
+        }
+
+        void* do_reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t alignment) override
+        {
+            const bool old_mapped = maps(old_bytes, alignment);
+            const bool new_mapped = maps(new_bytes, alignment);
+            if (!old_mapped && !new_mapped) {
+                return static_cast<ReallocatingMemoryResource*>(malloc_memory_resource())->reallocate(p, old_bytes, new_bytes, alignment);
+            }
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+            if (old_mapped && new_mapped) {
+                // the mapping keeps its advice and policy, but a moved one is only aligned on small pages
+                void* q = ::mremap(p, mapped_bytes(old_bytes), mapped_bytes(new_bytes), MREMAP_MAYMOVE);
+                if (q == MAP_FAILED) {
+                    throw std::bad_alloc{};
+                }
+                return q;
+            }
+#endif
+            void* q = do_allocate(new_bytes, alignment);
+            std::memcpy(q, p, std::min(old_bytes, new_bytes));
+            do_deallocate(p, old_bytes, alignment);
+            return q;
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            auto* large = dynamic_cast<const LargePageMemoryResource*>(&other);
+            return large != nullptr && large->policy_ == policy_ && large->node_ == node_ && large->threshold_ == threshold_;
+        }
+
+    private:
+#if defined(__linux__)
+        // hints only: failures leave the defaults
+        void advise(void* address, size_t length) const noexcept
+        {
+#ifdef MADV_HUGEPAGE
+            ::madvise(address, length, MADV_HUGEPAGE);
+#endif
+            const detail::NodeMask& allowed = detail::allowed_numa_nodes();
+            if (policy_ == NumaPolicy::local || allowed.count() < 2) {
+                return;
+            }
+            if (policy_ == NumaPolicy::interleave) {
+                ::syscall(SYS_mbind, address, length, detail::mpol_interleave, allowed.words, detail::NodeMask::max_nodes, 0u);
+            }
+            else if (allowed.contains(node_)) {
+                detail::NodeMask node;
+                node.words[node_ / (8 * sizeof(unsigned long))] = 1ul << (node_ % (8 * sizeof(unsigned long)));
+                ::syscall(SYS_mbind, address, length, detail::mpol_bind, node.words, detail::NodeMask::max_nodes, 0u);
+            }
+        }
+#endif
+    };
+
+    // local placement, from huge_page_size bytes
+    inline std::pmr::memory_resource* large_page_memory_resource() noexcept
+    {
+        static LargePageMemoryResource resource;
+        return &resource;
+    }
+
+    namespace parallel {
+
+        // Vector(s, value, initialized_tag, resource) with the pages written for the first time by every thread of the
+        // pool instead of the calling one: the page faults are taken in parallel and, with local placement, the pages
+        // spread over the NUMA nodes of the threads
+        template<typename T>
+        Vector<T> make_vector(size_t s, const T& value, std::pmr::memory_resource* resource = large_page_memory_resource(), ThreadPool& pool = ThreadPool::default_pool())
+        {
+            static_assert(std::is_trivially_default_constructible_v<T>, "constructing the elements would touch every page on the calling thread");
+            Vector<T> result(s, uninitialized_tag, resource);
+            parallel::fill(VectorView<T>{ result }, value, pool);
+            return result;
+        }
+    }
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <cerrno>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace containers2 {
+
+    // read_only: pages are shared with the page cache and cannot be written (MappedVector<const T> only)
+    // copy_on_write: writes are private to the mapping and never reach the file
+    // shared: writes reach the file (see MappedVector::sync)
+    enum class MapMode { read_only, copy_on_write, shared };
+
+    enum class MapAdvice { normal, sequential, random, will_need };
+
+    struct MapOptions
+    {
+        // fault in the whole file while mapping (MAP_POPULATE), instead of page by page on first access
+        bool populate = false;
+        // read-ahead hint for the kernel (madvise)
+        MapAdvice advice = MapAdvice::normal;
+    };
+
+    namespace detail {
+
+        struct FileMapping
+        {
+            void* address = nullptr;
+            size_t bytes = 0;
+        };
+
+#ifdef _WIN32
+        [[noreturn]] inline void throw_last_error(const char* what)
+        {
+            throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), what);
+        }
+
+        // populate and advice have no equivalent applied here: Windows reads ahead on its own
+        inline FileMapping map_file(const std::filesystem::path& path, MapMode mode, MapOptions, std::optional<size_t> create_bytes)
+        {
+            const bool writable = mode == MapMode::shared || create_bytes.has_value();
+            HANDLE file = ::CreateFileW(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                nullptr, create_bytes.has_value() ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw_last_error("CreateFileW");
+            }
+            LARGE_INTEGER size{};
+            if (create_bytes.has_value()) {
+                size.QuadPart = static_cast<LONGLONG>(*create_bytes);
+            }
+            else if (!::GetFileSizeEx(file, &size)) {
+                ::CloseHandle(file);
+                throw_last_error("GetFileSizeEx");
+            }
+            FileMapping mapping{ nullptr, static_cast<size_t>(size.QuadPart) };
+            if (mapping.bytes != 0) {
+                const DWORD protection = mode == MapMode::read_only ? PAGE_READONLY : mode == MapMode::copy_on_write ? PAGE_WRITECOPY : PAGE_READWRITE;
+                HANDLE section = ::CreateFileMappingW(file, nullptr, protection, static_cast<DWORD>(size.QuadPart >> 32), static_cast<DWORD>(size.QuadPart), nullptr);
+                if (section == nullptr) {
+                    ::CloseHandle(file);
+                    throw_last_error("CreateFileMappingW");
+                }
+                const DWORD access = mode == MapMode::read_only ? FILE_MAP_READ : mode == MapMode::copy_on_write ? FILE_MAP_COPY : FILE_MAP_WRITE;
+                mapping.address = ::MapViewOfFile(section, access, 0, 0, mapping.bytes);
+                ::CloseHandle(section);
+                if (mapping.address == nullptr) {
+                    ::CloseHandle(file);
+                    throw_last_error("MapViewOfFile");
+                }
+            }
+            ::CloseHandle(file);
+            return mapping;
+        }
+
+        inline void unmap_file(FileMapping mapping) noexcept
+        {
+            if (mapping.address != nullptr) {
+                ::UnmapViewOfFile(mapping.address);
+            }
+        }
+
+        inline void sync_file(FileMapping mapping)
+        {
+            if (mapping.address != nullptr && !::FlushViewOfFile(mapping.address, mapping.bytes)) {
+                throw_last_error("FlushViewOfFile");
+            }
+        }
+#else
+        [[noreturn]] inline void throw_errno(const char* what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        inline FileMapping map_file(const std::filesystem::path& path, MapMode mode, MapOptions options, std::optional<size_t> create_bytes)
+        {
+            const bool writable = mode == MapMode::shared || create_bytes.has_value();
+            const int fd = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | (create_bytes.has_value() ? O_CREAT | O_TRUNC : 0) | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                throw_errno("open");
+            }
+            FileMapping mapping{};
+            if (create_bytes.has_value()) {
+                mapping.bytes = *create_bytes;
+                if (::ftruncate(fd, static_cast<off_t>(mapping.bytes)) != 0) {
+                    ::close(fd);
+                    throw_errno("ftruncate");
+                }
+            }
+            else {
+                struct stat status {};
+                if (::fstat(fd, &status) != 0) {
+                    ::close(fd);
+                    throw_errno("fstat");
+                }
+                mapping.bytes = static_cast<size_t>(status.st_size);
+            }
+            if (mapping.bytes != 0) {
+                const int protection = mode == MapMode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+                int flags = mode == MapMode::shared ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+                if (options.populate) {
+                    flags |= MAP_POPULATE;
+                }
+#endif
+                mapping.address = ::mmap(nullptr, mapping.bytes, protection, flags, fd, 0);
+                if (mapping.address == MAP_FAILED) {
+                    ::close(fd);
+                    throw_errno("mmap");
+                }
+                const int advice[]{ MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED };
+                if (options.advice != MapAdvice::normal) {
+                    ::madvise(mapping.address, mapping.bytes, advice[static_cast<int>(options.advice)]); // only a hint
+                }
+            }
+            ::close(fd);
+            return mapping;
+        }
+
+        inline void unmap_file(FileMapping mapping) noexcept
+        {
+            if (mapping.address != nullptr) {
+                ::munmap(mapping.address, mapping.bytes);
+            }
+        }
+
+        inline void sync_file(FileMapping mapping)
+        {
+            if (mapping.address != nullptr && ::msync(mapping.address, mapping.bytes, MS_SYNC) != 0) {
+                throw_errno("msync");
+            }
+        }
+#endif
+    }
+
+    // Owning container backed by a memory-mapped file: it owns the mapping the same way Vector owns its buffer
+    // (move-only, no implicit copies) and is viewed as VectorView<const T> or, for writable mappings, VectorView<T>.
+    // The file holds size() = file size / sizeof(T) elements, trailing bytes are not part of the view.
+    template<typename T>
+    struct MappedVector : VectorView<T>
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be mapped from a file");
+
+        using super = VectorView<T>;
+        using super::begin_;
+        using super::end_;
+
+        detail::FileMapping mapping_{};
+
+        MappedVector() noexcept = default;
+
+        // mutable elements need a writable mapping mode
+        explicit MappedVector(const std::filesystem::path& path, MapMode mode = std::is_const_v<T> ? MapMode::read_only : MapMode::copy_on_write, MapOptions options = {}) :
+            MappedVector(check_mode(mode), path, options, std::nullopt) {}
+
+        // creates (or truncates) the file to hold s elements and maps it shared: writes reach the file
+        MappedVector(const std::filesystem::path& path, size_t s, MapOptions options = {}) requires(!std::is_const_v<T>) :
+            MappedVector(MapMode::shared, path, options, s * sizeof(T)) {}
+
+        // non-copyable
+        MappedVector(const MappedVector&) = delete;
+        MappedVector& operator = (const MappedVector&) = delete;
+
+        // non-copyable from parent classes
+        MappedVector(const VectorView<const T>&) = delete;
+        MappedVector& operator = (const VectorView<const T>&) = delete;
+        MappedVector(const VectorView<std::remove_const_t<T>>&) = delete;
+        MappedVector& operator = (const VectorView<std::remove_const_t<T>>&) = delete;
+
+        MappedVector(MappedVector&& rhs) noexcept :
+            super{ std::exchange(static_cast<VectorView<T>&>(rhs), {}) }, mapping_{ std::exchange(rhs.mapping_, {}) } {}
+
+        MappedVector& operator = (MappedVector&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                detail::unmap_file(mapping_);
+                super::operator =(std::exchange(static_cast<VectorView<T>&>(rhs), {}));
+                mapping_ = std::exchange(rhs.mapping_, {});
+            }
+            return *this;
+        }
+
+        MappedVector(MappedVector<std::remove_const_t<T>>&& rhs) noexcept requires(std::is_const_v<T>) :
+            super{ std::exchange(static_cast<VectorView<std::remove_const_t<T>>&>(rhs), {}) }, mapping_{ std::exchange(rhs.mapping_, {}) } {}
+
+        MappedVector& operator = (MappedVector<std::remove_const_t<T>>&& rhs) & noexcept requires(std::is_const_v<T>)
+        {
+            detail::unmap_file(mapping_);
+            super::operator =(std::exchange(static_cast<VectorView<std::remove_const_t<T>>&>(rhs), {}));
+            mapping_ = std::exchange(rhs.mapping_, {});
+            return *this;
+        }
+
+        ~MappedVector() noexcept
+        {
+            detail::unmap_file(mapping_);
+        }
+
+        using super::begin;
+        using super::end;
+        using super::data;
+        using super::operator[];
+        using super::size;
+
+        // writes dirty pages of a shared mapping back to the file
+        void sync() const
+        {
+            detail::sync_file(mapping_);
+        }
+
+    private:
+        MappedVector(MapMode mode, const std::filesystem::path& path, MapOptions options, std::optional<size_t> create_bytes) :
+            mapping_{ detail::map_file(path, mode, options, create_bytes) }
+        {
+            T* memory = static_cast<T*>(mapping_.address);
+            super::operator =(super{ memory, memory + mapping_.bytes / sizeof(T) });
+        }
+
+        static MapMode check_mode(MapMode mode)
+        {
+            if (!std::is_const_v<T> && mode == MapMode::read_only) {
+                throw std::invalid_argument("MappedVector of mutable elements needs a writable mapping mode");
+            }
+            return mode;
+        }
+    };
+
+    template<typename T>
+    inline constexpr bool is_owning_container_v<MappedVector<T>> = true;
+}
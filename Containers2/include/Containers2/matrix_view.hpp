@@ -0,0 +1,311 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace containers2 {
+
+    // Non-owning views over strided and two-dimensional data. Like VectorView they are trivially copyable and come in
+    // a const-data flavor (the base) and a mutable-data flavor derived from it.
+
+    template<typename T, size_t Rank = 1>
+    struct StridedView;
+
+    template<typename T>
+    struct MatrixView;
+
+    // N-dimensional view: element (i0, i1, ...) lives at data_ + i0 * strides_[0] + i1 * strides_[1] + ...
+    // Strides are in elements and may be negative (reversed dimensions).
+    template<typename T, size_t Rank> requires(std::is_const_v<T>)
+    struct StridedView<T, Rank>
+    {
+        static_assert(Rank >= 1, "StridedView needs at least one dimension");
+
+        T* data_ = nullptr;
+        std::array<size_t, Rank> extents_{};
+        std::array<ptrdiff_t, Rank> strides_{};
+
+        StridedView(T* data, std::array<size_t, Rank> extents, std::array<ptrdiff_t, Rank> strides) noexcept :
+            data_{ data }, extents_{ extents }, strides_{ strides } {}
+        StridedView(VectorView<T> view) noexcept requires(Rank == 1) : data_{ view.data() }, extents_{ view.size() }, strides_{ 1 } {}
+
+        StridedView() noexcept = default;
+
+        StridedView(const StridedView&) noexcept = default;
+        StridedView& operator = (const StridedView&) & noexcept = default;
+
+        StridedView(StridedView&&) noexcept = default;
+        StridedView& operator = (StridedView&&) & noexcept = default;
+
+        ~StridedView() noexcept = default;
+
+        T* data() const { return data_; }
+
+        size_t extent(size_t dimension) const { return extents_[dimension]; }
+        ptrdiff_t stride(size_t dimension) const { return strides_[dimension]; }
+
+        size_t size() const
+        {
+            size_t s = 1;
+            for (size_t e : extents_) {
+                s *= e;
+            }
+            return s;
+        }
+
+        template<std::convertible_to<size_t>... I> requires(sizeof...(I) == Rank)
+        T& operator()(I... indices) const
+        {
+            const size_t index[]{ static_cast<size_t>(indices)... };
+            ptrdiff_t offset = 0;
+            for (size_t d = 0; d < Rank; ++d) {
+                offset += static_cast<ptrdiff_t>(index[d]) * strides_[d];
+            }
+            return data_[offset];
+        }
+
+        T& operator[](size_t index) const requires(Rank == 1) { return data_[static_cast<ptrdiff_t>(index) * strides_[0]]; }
+
+        // [begin, end) along dimension
+        StridedView slice(size_t dimension, size_t begin, size_t end) const
+        {
+            StridedView result = *this;
+            result.data_ += static_cast<ptrdiff_t>(begin) * strides_[dimension];
+            result.extents_[dimension] = end - begin;
+            return result;
+        }
+
+        // every step-th element along dimension
+        StridedView step(size_t dimension, size_t step) const
+        {
+            if (step == 0) {
+                throw std::invalid_argument("step: zero step");
+            }
+            StridedView result = *this;
+            result.extents_[dimension] = (extents_[dimension] + step - 1) / step;
+            result.strides_[dimension] *= static_cast<ptrdiff_t>(step);
+            return result;
+        }
+
+        // fixes dimension at index and drops it
+        StridedView<T, Rank - 1> at(size_t dimension, size_t index) const requires(Rank > 1)
+        {
+            StridedView<T, Rank - 1> result{ data_ + static_cast<ptrdiff_t>(index) * strides_[dimension], {}, {} };
+            for (size_t d = 0, r = 0; d < Rank; ++d) {
+                if (d != dimension) {
+                    result.extents_[r] = extents_[d];
+                    result.strides_[r] = strides_[d];
+                    ++r;
+                }
+            }
+            return result;
+        }
+
+        // swaps two dimensions without moving any element
+        StridedView transposed(size_t a = 0, size_t b = 1) const requires(Rank > 1)
+        {
+            StridedView result = *this;
+            std::swap(result.extents_[a], result.extents_[b]);
+            std::swap(result.strides_[a], result.strides_[b]);
+            return result;
+        }
+
+        // true when the elements are densely packed in row-major order, i.e. the view is a VectorView
+        bool is_contiguous() const
+        {
+            ptrdiff_t expected = 1;
+            for (size_t d = Rank; d-- > 0;) {
+                if (extents_[d] != 1 && strides_[d] != expected) {
+                    return false;
+                }
+                expected *= static_cast<ptrdiff_t>(extents_[d]);
+            }
+            return true;
+        }
+    };
+
+    template<typename T, size_t Rank> requires(!std::is_const_v<T>)
+    struct StridedView<T, Rank> : StridedView<const T, Rank>
+    {
+        using super = StridedView<const T, Rank>;
+
+        StridedView(T* data, std::array<size_t, Rank> extents, std::array<ptrdiff_t, Rank> strides) noexcept : super{ data, extents, strides } {}
+        StridedView(VectorView<T> view) noexcept requires(Rank == 1) : super{ view } {}
+
+        StridedView() noexcept = default;
+
+        StridedView(const StridedView&) noexcept = default;
+        StridedView& operator = (const StridedView&) & noexcept = default;
+
+        StridedView(StridedView&&) noexcept = default;
+        StridedView& operator = (StridedView&&) & noexcept = default;
+
+        ~StridedView() noexcept = default;
+
+        T* data() const { return const_cast<T*>(super::data()); }
+
+        using super::extent;
+        using super::stride;
+        using super::size;
+        using super::is_contiguous;
+
+        template<std::convertible_to<size_t>... I> requires(sizeof...(I) == Rank)
+        T& operator()(I... indices) const { return const_cast<T&>(super::operator()(indices...)); }
+
+        T& operator[](size_t index) const requires(Rank == 1) { return const_cast<T&>(super::operator[](index)); }
+
+        StridedView slice(size_t dimension, size_t begin, size_t end) const { return mutable_view(super::slice(dimension, begin, end)); }
+        StridedView step(size_t dimension, size_t step) const { return mutable_view(super::step(dimension, step)); }
+        StridedView transposed(size_t a = 0, size_t b = 1) const requires(Rank > 1) { return mutable_view(super::transposed(a, b)); }
+
+        StridedView<T, Rank - 1> at(size_t dimension, size_t index) const requires(Rank > 1)
+        {
+            const auto view = super::at(dimension, index);
+            return { const_cast<T*>(view.data_), view.extents_, view.strides_ };
+        }
+
+    private:
+        static StridedView mutable_view(const super& view) { return { const_cast<T*>(view.data_), view.extents_, view.strides_ }; }
+    };
+
+    // Row-major matrix whose rows are contiguous, possibly padded to row_stride_ elements: a row is a VectorView,
+    // a column a StridedView and a sub-block another MatrixView over the same memory.
+    template<typename T> requires(std::is_const_v<T>)
+    struct MatrixView<T>
+    {
+        T* data_ = nullptr;
+        size_t rows_ = 0;
+        size_t columns_ = 0;
+        size_t row_stride_ = 0;
+
+        MatrixView(T* data, size_t rows, size_t columns, size_t row_stride) noexcept : data_{ data }, rows_{ rows }, columns_{ columns }, row_stride_{ row_stride } {}
+        // the first rows * columns elements of view, densely packed
+        MatrixView(VectorView<T> view, size_t rows, size_t columns) noexcept : MatrixView(view.data(), rows, columns, columns) {}
+
+        MatrixView() noexcept = default;
+
+        MatrixView(const MatrixView&) noexcept = default;
+        MatrixView& operator = (const MatrixView&) & noexcept = default;
+
+        MatrixView(MatrixView&&) noexcept = default;
+        MatrixView& operator = (MatrixView&&) & noexcept = default;
+
+        ~MatrixView() noexcept = default;
+
+        T* data() const { return data_; }
+
+        size_t rows() const { return rows_; }
+        size_t columns() const { return columns_; }
+        size_t row_stride() const { return row_stride_; }
+        size_t size() const { return rows_ * columns_; }
+
+        T& operator()(size_t row, size_t column) const { return data_[row * row_stride_ + column]; }
+
+        VectorView<T> row(size_t index) const { return { data_ + index * row_stride_, data_ + index * row_stride_ + columns_ }; }
+        StridedView<T> column(size_t index) const { return { data_ + index, { rows_ }, { static_cast<ptrdiff_t>(row_stride_) } }; }
+
+        MatrixView block(size_t row, size_t column, size_t rows, size_t columns) const { return { data_ + row * row_stride_ + column, rows, columns, row_stride_ }; }
+
+        StridedView<T, 2> strided() const { return { data_, { rows_, columns_ }, { static_cast<ptrdiff_t>(row_stride_), 1 } }; }
+    };
+
+    template<typename T> requires(!std::is_const_v<T>)
+    struct MatrixView<T> : MatrixView<const T>
+    {
+        using super = MatrixView<const T>;
+
+        MatrixView(T* data, size_t rows, size_t columns, size_t row_stride) noexcept : super{ data, rows, columns, row_stride } {}
+        MatrixView(VectorView<T> view, size_t rows, size_t columns) noexcept : super{ view, rows, columns } {}
+
+        MatrixView() noexcept = default;
+
+        MatrixView(const MatrixView&) noexcept = default;
+        MatrixView& operator = (const MatrixView&) & noexcept = default;
+
+        MatrixView(MatrixView&&) noexcept = default;
+        MatrixView& operator = (MatrixView&&) & noexcept = default;
+
+        ~MatrixView() noexcept = default;
+
+        T* data() const { return const_cast<T*>(super::data()); }
+
+        using super::rows;
+        using super::columns;
+        using super::row_stride;
+        using super::size;
+
+        T& operator()(size_t row, size_t column) const { return const_cast<T&>(super::operator()(row, column)); }
+
+        VectorView<T> row(size_t index) const { return { data() + index * row_stride(), data() + index * row_stride() + columns() }; }
+        StridedView<T> column(size_t index) const { return { data() + index, { rows() }, { static_cast<ptrdiff_t>(row_stride()) } }; }
+
+        MatrixView block(size_t row, size_t column, size_t rows, size_t columns) const { return { data() + row * row_stride() + column, rows, columns, row_stride() }; }
+
+        StridedView<T, 2> strided() const { return { data(), { rows(), columns() }, { static_cast<ptrdiff_t>(row_stride()), 1 } }; }
+    };
+
+    // default tile edge: a 64x64 tile of 4-byte elements is 16KiB, two of them fit in a 32-48KiB L1 data cache
+    inline constexpr size_t default_tile_size = 64;
+
+    // calls f(row, column, tile) for every tile_rows x tile_columns block of matrix (smaller at the borders), row of tiles by row of tiles
+    template<typename T, typename F>
+    void for_each_tile(MatrixView<T> matrix, size_t tile_rows, size_t tile_columns, F&& f)
+    {
+        if (tile_rows == 0 || tile_columns == 0) {
+            throw std::invalid_argument("for_each_tile: empty tiles");
+        }
+        for (size_t r = 0; r < matrix.rows(); r += tile_rows) {
+            const size_t rows = std::min(tile_rows, matrix.rows() - r);
+            for (size_t c = 0; c < matrix.columns(); c += tile_columns) {
+                f(r, c, matrix.block(r, c, rows, std::min(tile_columns, matrix.columns() - c)));
+            }
+        }
+    }
+
+    // dst(c, r) = src(r, c), tile by tile so that both the rows read and the rows written stay in cache;
+    // dst must be src.columns() x src.rows() and must not overlap src
+    template<typename T>
+    void transpose(MatrixView<const T> src, MatrixView<T> dst, size_t tile = default_tile_size)
+    {
+        if (dst.rows() != src.columns() || dst.columns() != src.rows()) {
+            throw std::invalid_argument("transpose: dst must be src.columns() x src.rows()");
+        }
+        for_each_tile(src, tile, tile, [&](size_t row, size_t column, MatrixView<const T> block) {
+            for (size_t r = 0; r < block.rows(); ++r) {
+                for (size_t c = 0; c < block.columns(); ++c) {
+                    dst(column + c, row + r) = block(r, c);
+                }
+            }
+        });
+    }
+
+    // in-place transpose of a square matrix, swapping tile (i, j) with tile (j, i)
+    template<typename T>
+    void transpose_in_place(MatrixView<T> matrix, size_t tile = default_tile_size)
+    {
+        if (matrix.rows() != matrix.columns()) {
+            throw std::invalid_argument("transpose_in_place: the matrix must be square");
+        }
+        if (tile == 0) {
+            throw std::invalid_argument("transpose_in_place: empty tiles");
+        }
+        const size_t n = matrix.rows();
+        for (size_t r = 0; r < n; r += tile) {
+            for (size_t c = r; c < n; c += tile) {
+                const size_t row_end = std::min(r + tile, n);
+                const size_t column_end = std::min(c + tile, n);
+                for (size_t i = r; i < row_end; ++i) {
+                    for (size_t j = (r == c ? i + 1 : c); j < column_end; ++j) {
+                        std::swap(matrix(i, j), matrix(j, i));
+                    }
+                }
+            }
+        }
+    }
+}
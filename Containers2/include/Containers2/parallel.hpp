@@ -0,0 +1,418 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace containers2 {
+
+    // Splits a view into n contiguous chunks, computed on demand (no allocation); trivially copyable like the view.
+    // Balanced chunks differ in size by at most one element; aligned chunks move every inner boundary up to the next
+    // multiple of alignment bytes so that threads writing neighbouring chunks never share a cache line
+    // (chunks can then be empty when the view is small).
+    template<typename T>
+    struct Chunks
+    {
+        VectorView<T> view_;
+        size_t count_ = 0;
+        size_t alignment_ = 0; // in bytes, 0 for balanced chunks
+
+        size_t size() const { return count_; }
+
+        size_t boundary(size_t index) const
+        {
+            const size_t s = view_.size();
+            if (index == 0 || index >= count_) {
+                return index == 0 ? 0 : s;
+            }
+            size_t b = s / count_ * index + s % count_ * index / count_;
+            const auto address = reinterpret_cast<std::uintptr_t>(view_.data());
+            if (alignment_ > sizeof(T) && alignment_ % sizeof(T) == 0 && address % sizeof(T) == 0) {
+                const size_t per_line = alignment_ / sizeof(T);
+                const size_t first = (alignment_ - address % alignment_) % alignment_ / sizeof(T);
+                b = b <= first ? first : first + (b - first + per_line - 1) / per_line * per_line;
+            }
+            return std::min(b, s);
+        }
+
+        VectorView<T> operator[](size_t index) const
+        {
+            return { view_.data() + boundary(index), view_.data() + boundary(index + 1) };
+        }
+    };
+
+    template<typename T>
+    Chunks<T> split(VectorView<T> view, size_t n)
+    {
+        return { view, std::max<size_t>(n, 1), 0 };
+    }
+
+    template<typename T>
+    Chunks<T> split_aligned(VectorView<T> view, size_t n, size_t alignment = cache_line_size)
+    {
+        return { view, std::max<size_t>(n, 1), alignment };
+    }
+
+    // Fork-join pool with one task deque per worker: workers pop their own deque from the back and steal from the
+    // front of the others' when they run dry. The thread calling run() executes tasks too while it waits, so nested
+    // run() calls from inside a task cannot deadlock.
+    struct ThreadPool
+    {
+        // concurrency counts the calling thread: concurrency - 1 workers are started
+        explicit ThreadPool(size_t concurrency = std::thread::hardware_concurrency())
+        {
+            const size_t workers = concurrency > 1 ? concurrency - 1 : 0;
+            for (size_t i = 0; i < workers; ++i) {
+                queues_.push_back(std::make_unique<Queue>());
+            }
+            for (size_t i = 0; i < workers; ++i) {
+                threads_.emplace_back([this, i] { work(i); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock{ sleep_mutex_ };
+                stop_ = true;
+            }
+            sleep_.notify_all();
+            for (auto& thread : threads_) {
+                thread.join();
+            }
+        }
+
+        size_t concurrency() const noexcept { return threads_.size() + 1; }
+
+        static ThreadPool& default_pool()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        // calls f(i) for every i in [0, tasks) and returns once all of them are done, rethrowing the first exception
+        template<typename F>
+        void run(size_t tasks, F&& f)
+        {
+            if (tasks == 0) {
+                return;
+            }
+            if (tasks == 1 || threads_.empty()) {
+                for (size_t i = 0; i < tasks; ++i) {
+                    f(i);
+                }
+                return;
+            }
+
+            using Function = std::remove_reference_t<F>;
+            Job job{ [](const void* function, size_t index) { (*static_cast<Function*>(const_cast<void*>(function)))(index); }, &f, tasks };
+            const size_t first = next_queue_.fetch_add(1, std::memory_order_relaxed);
+            for (size_t i = 0; i < tasks; ++i) {
+                Queue& queue = *queues_[(first + i) % queues_.size()];
+                std::lock_guard lock{ queue.mutex };
+                queue.tasks.push_back({ &job, i });
+            }
+            pending_.fetch_add(tasks, std::memory_order_release);
+            {
+                std::lock_guard lock{ sleep_mutex_ };
+            }
+            sleep_.notify_all();
+
+            while (job.remaining.load(std::memory_order_acquire) != 0) {
+                if (auto task = steal(queues_.size())) {
+                    execute(*task);
+                }
+                else {
+                    break; // everything left is running on workers
+                }
+            }
+            std::unique_lock lock{ job.mutex };
+            job.done_condition.wait(lock, [&] { return job.done; });
+            if (job.error) {
+                std::rethrow_exception(job.error);
+            }
+        }
+
+    private:
+        struct Job
+        {
+            void (*invoke)(const void*, size_t);
+            const void* function;
+            std::atomic<size_t> remaining;
+            std::exception_ptr error{};
+            std::mutex mutex{};
+            std::condition_variable done_condition{};
+            bool done = false;
+        };
+
+        struct Task
+        {
+            Job* job;
+            size_t index;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> threads_;
+        std::atomic<size_t> pending_{ 0 };
+        std::atomic<size_t> next_queue_{ 0 };
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_;
+        bool stop_ = false;
+
+        // own queue first (from the back), then the others (from the front); own == queues_.size() for outside threads
+        std::optional<Task> steal(size_t own)
+        {
+            if (pending_.load(std::memory_order_acquire) == 0) {
+                return std::nullopt;
+            }
+            if (own < queues_.size()) {
+                Queue& queue = *queues_[own];
+                std::lock_guard lock{ queue.mutex };
+                if (!queue.tasks.empty()) {
+                    Task task = queue.tasks.back();
+                    queue.tasks.pop_back();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    return task;
+                }
+            }
+            for (size_t i = 1; i <= queues_.size(); ++i) {
+                Queue& queue = *queues_[(own + i) % queues_.size()];
+                std::lock_guard lock{ queue.mutex };
+                if (!queue.tasks.empty()) {
+                    Task task = queue.tasks.front();
+                    queue.tasks.pop_front();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    return task;
+                }
+            }
+            return std::nullopt;
+        }
+
+        static void execute(Task task)
+        {
+            Job& job = *task.job;
+            try {
+                job.invoke(job.function, task.index);
+            }
+            catch (...) {
+                std::lock_guard lock{ job.mutex };
+                if (!job.error) {
+                    job.error = std::current_exception();
+                }
+            }
+            if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                // the caller destroys job as soon as it sees done, so done is published under the job's lock
+                std::lock_guard lock{ job.mutex };
+                job.done = true;
+                job.done_condition.notify_all();
+            }
+        }
+
+        void work(size_t index)
+        {
+            for (;;) {
+                if (auto task = steal(index)) {
+                    execute(*task);
+                    continue;
+                }
+                std::unique_lock lock{ sleep_mutex_ };
+                sleep_.wait(lock, [&] { return stop_ || pending_.load(std::memory_order_acquire) != 0; });
+                if (stop_) {
+                    return;
+                }
+            }
+        }
+    };
+
+    inline struct deterministic_tag_t {} deterministic_tag;
+
+    namespace parallel {
+
+        namespace detail {
+            // a few chunks per thread for load balancing, but no chunk smaller than min_chunk elements
+            inline size_t chunk_count(size_t s, const ThreadPool& pool, size_t min_chunk = 4096)
+            {
+                return std::max<size_t>(1, std::min(pool.concurrency() * 4, s / min_chunk));
+            }
+
+            // fixed-size chunks: the partition, hence the order of floating point operations, ignores the thread count
+            inline constexpr size_t deterministic_chunk = 16384;
+        }
+
+        template<typename T, typename F>
+        void for_each(VectorView<T> view, F f, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const auto chunks = split_aligned(view, detail::chunk_count(view.size(), pool));
+            pool.run(chunks.size(), [&](size_t i) {
+                for (auto& element : chunks[i]) {
+                    f(element);
+                }
+            });
+        }
+
+        // out[i] = f(in[i]); in and out must have the same size, they may be the same view
+        template<typename T, typename U, typename F>
+        void transform(VectorView<const T> in, VectorView<U> out, F f, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const auto chunks = split_aligned(out, detail::chunk_count(out.size(), pool));
+            pool.run(chunks.size(), [&](size_t i) {
+                const size_t begin = chunks.boundary(i);
+                const size_t end = chunks.boundary(i + 1);
+                for (size_t j = begin; j < end; ++j) {
+                    out[j] = f(in[j]);
+                }
+            });
+        }
+
+        // view = value from every thread. On memory not written yet, such as a new Vector from a
+        // LargePageMemoryResource, each page is backed on the NUMA node of the thread that writes it first; chunk
+        // boundaries on huge pages keep every huge page on one thread
+        template<typename T>
+        void fill(VectorView<T> view, const T& value, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const auto chunks = split_aligned(view, detail::chunk_count(view.size(), pool, std::max<size_t>(huge_page_size / sizeof(T), 1)), huge_page_size);
+            pool.run(chunks.size(), [&](size_t i) {
+                const VectorView<T> chunk = chunks[i];
+                std::fill(chunk.begin(), chunk.end(), value);
+            });
+        }
+
+        // copy_elements() of aligned chunks on every thread, for copies of gigabytes that one core cannot move at the
+        // bandwidth of the memory; automatic decides on streaming for the whole copy, not per chunk
+        template<typename T>
+        void copy(VectorView<const T> in, VectorView<std::type_identity_t<T>> out, CopyMode mode = CopyMode::automatic, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const CopyMode chunk_mode = containers2::detail::streams(in.size() * sizeof(T), mode) ? CopyMode::streaming : CopyMode::cached;
+            const auto chunks = split_aligned(out, detail::chunk_count(out.size(), pool, std::max<size_t>((size_t{ 1 } << 16) / sizeof(T), 1))); // 64 KiB at least
+            pool.run(chunks.size(), [&](size_t i) {
+                const size_t begin = chunks.boundary(i);
+                const size_t end = chunks.boundary(i + 1);
+                copy_elements<T>(VectorView<const T>{ in.data() + begin, in.data() + end }, chunks[i], chunk_mode);
+            });
+        }
+
+        namespace detail {
+            template<typename T, typename Op>
+            T reduce_chunks(Chunks<const T> chunks, T init, Op op, ThreadPool& pool)
+            {
+                std::vector<std::optional<T>> partials(chunks.size());
+                pool.run(chunks.size(), [&](size_t i) {
+                    const VectorView<const T> chunk = chunks[i];
+                    if (chunk.size() != 0) {
+                        T partial = chunk[0];
+                        for (size_t j = 1; j < chunk.size(); ++j) {
+                            partial = op(std::move(partial), chunk[j]);
+                        }
+                        partials[i] = std::move(partial);
+                    }
+                });
+                for (auto& partial : partials) {
+                    if (partial) {
+                        init = op(std::move(init), std::move(*partial));
+                    }
+                }
+                return init;
+            }
+        }
+
+        // op must be associative; chunk results are combined in order, but how the view is chunked depends on the
+        // number of threads, so non-associative operations (floating point additions) can differ between pools
+        template<typename T, typename Op = std::plus<>>
+        T reduce(VectorView<const T> view, T init, Op op = {}, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            return detail::reduce_chunks(split(view, detail::chunk_count(view.size(), pool)), std::move(init), op, pool);
+        }
+
+        // same result for any pool and any number of threads: the view is cut in fixed-size chunks
+        template<typename T, typename Op = std::plus<>>
+        T reduce(VectorView<const T> view, T init, Op op, deterministic_tag_t, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const size_t count = (view.size() + detail::deterministic_chunk - 1) / detail::deterministic_chunk;
+            return detail::reduce_chunks(Chunks<const T>{ view, std::max<size_t>(count, 1), 0 }, std::move(init), op, pool);
+        }
+
+        // out[i] = in[0] op in[1] op ... op in[i], in two passes: chunk totals, then each chunk scanned from the total
+        // of the chunks before it; in and out must have the same size, they may be the same view
+        template<typename T, typename Op = std::plus<>>
+        void inclusive_scan(VectorView<const T> in, VectorView<T> out, Op op = {}, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const auto chunks = split_aligned(out, detail::chunk_count(out.size(), pool));
+            std::vector<std::optional<T>> totals(chunks.size());
+            pool.run(chunks.size(), [&](size_t i) {
+                const size_t begin = chunks.boundary(i);
+                const size_t end = chunks.boundary(i + 1);
+                if (begin != end) {
+                    T total = in[begin];
+                    for (size_t j = begin + 1; j < end; ++j) {
+                        total = op(std::move(total), in[j]);
+                    }
+                    totals[i] = std::move(total);
+                }
+            });
+            // exclusive prefix of the chunk totals
+            std::optional<T> carry;
+            for (auto& total : totals) {
+                if (total) {
+                    std::optional<T> next = carry ? std::optional<T>{ op(*carry, *total) } : total;
+                    total = carry;
+                    carry = std::move(next);
+                }
+            }
+            pool.run(chunks.size(), [&](size_t i) {
+                const size_t begin = chunks.boundary(i);
+                const size_t end = chunks.boundary(i + 1);
+                if (begin == end) {
+                    return;
+                }
+                T running = totals[i] ? op(*totals[i], in[begin]) : T{ in[begin] };
+                out[begin] = running;
+                for (size_t j = begin + 1; j < end; ++j) {
+                    running = op(std::move(running), in[j]);
+                    out[j] = running;
+                }
+            });
+        }
+
+        // sorts the chunks in parallel, then merges neighbouring runs pairwise, every round in parallel
+        template<typename T, typename Compare = std::less<>>
+        void sort(VectorView<T> view, Compare compare = {}, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const auto chunks = split(view, detail::chunk_count(view.size(), pool));
+            pool.run(chunks.size(), [&](size_t i) {
+                const VectorView<T> chunk = chunks[i];
+                std::sort(chunk.begin(), chunk.end(), compare);
+            });
+            for (size_t width = 1; width < chunks.size(); width *= 2) {
+                const size_t pairs = (chunks.size() + 2 * width - 1) / (2 * width);
+                pool.run(pairs, [&](size_t pair) {
+                    const size_t first = pair * 2 * width;
+                    const size_t middle = std::min(first + width, chunks.size());
+                    const size_t last = std::min(first + 2 * width, chunks.size());
+                    std::inplace_merge(view.begin() + chunks.boundary(first), view.begin() + chunks.boundary(middle), view.begin() + chunks.boundary(last), compare);
+                });
+            }
+        }
+    }
+}
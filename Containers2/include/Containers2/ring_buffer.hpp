@@ -0,0 +1,274 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    // Slots handed out by a batch reserve_push/reserve_pop: position counts pushes since construction, the slots are
+    // first followed by second (non-empty only when the batch wraps around the end of the storage).
+    template<typename T>
+    struct RingReservation
+    {
+        VectorView<T> first;
+        VectorView<T> second;
+        size_t position = 0;
+
+        size_t size() const { return first.size() + second.size(); }
+    };
+
+    namespace detail {
+        template<typename T>
+        RingReservation<T> ring_reservation(Vector<T>& storage, size_t position, size_t n)
+        {
+            const size_t index = position & (storage.size() - 1);
+            const size_t first = std::min(n, storage.size() - index);
+            return { { storage.begin() + index, storage.begin() + index + first }, { storage.begin(), storage.begin() + (n - first) }, position };
+        }
+
+        inline size_t ring_capacity(size_t capacity)
+        {
+            return capacity == 0 ? 0 : std::bit_ceil(capacity);
+        }
+    }
+
+    // Bounded lock-free queue for exactly one producer thread and one consumer thread.
+    // It owns a power-of-two Vector of slots (all constructed, like Vector's capacity) and is move-only; moving a
+    // queue while it is in use is a data race. Each index lives on its own cache line next to the owner's cached copy
+    // of the other index, so the two threads only touch each other's line when the queue looks full or empty.
+    template<typename T>
+    struct SpscRingBuffer
+    {
+        Vector<T> storage_;
+        alignas(cache_line_size) std::atomic<size_t> head_{ 0 }; // next position to pop, written by the consumer
+        size_t cached_tail_ = 0;
+        alignas(cache_line_size) std::atomic<size_t> tail_{ 0 }; // next position to push, written by the producer
+        size_t cached_head_ = 0;
+
+        SpscRingBuffer() noexcept = default;
+
+        // capacity is rounded up to a power of two
+        explicit SpscRingBuffer(size_t capacity) : storage_{ detail::ring_capacity(capacity), uninitialized_tag } {}
+
+        // non-copyable
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator = (const SpscRingBuffer&) = delete;
+
+        SpscRingBuffer(SpscRingBuffer&& rhs) noexcept :
+            storage_{ std::move(rhs.storage_) },
+            head_{ rhs.head_.exchange(0, std::memory_order_relaxed) }, cached_tail_{ std::exchange(rhs.cached_tail_, 0) },
+            tail_{ rhs.tail_.exchange(0, std::memory_order_relaxed) }, cached_head_{ std::exchange(rhs.cached_head_, 0) } {}
+
+        SpscRingBuffer& operator = (SpscRingBuffer&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                storage_ = std::move(rhs.storage_);
+                head_.store(rhs.head_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                cached_tail_ = std::exchange(rhs.cached_tail_, 0);
+                tail_.store(rhs.tail_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                cached_head_ = std::exchange(rhs.cached_head_, 0);
+            }
+            return *this;
+        }
+
+        ~SpscRingBuffer() noexcept = default;
+
+        size_t capacity() const noexcept { return storage_.size(); }
+
+        // exact only when neither side is running
+        size_t size() const noexcept { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+        bool empty() const noexcept { return size() == 0; }
+
+        // producer side
+        bool try_push(T value)
+        {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cached_head_ == capacity()) {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail - cached_head_ == capacity()) {
+                    return false;
+                }
+            }
+            storage_[tail & (capacity() - 1)] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // producer side: up to n free slots to fill in place, visible to the consumer after commit_push
+        RingReservation<T> reserve_push(size_t n)
+        {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            cached_head_ = head_.load(std::memory_order_acquire);
+            return detail::ring_reservation(storage_, tail, std::min(n, capacity() - (tail - cached_head_)));
+        }
+
+        void commit_push(const RingReservation<T>& reservation)
+        {
+            tail_.store(reservation.position + reservation.size(), std::memory_order_release);
+        }
+
+        // consumer side
+        std::optional<T> try_pop()
+        {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            if (head == cached_tail_) {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (head == cached_tail_) {
+                    return std::nullopt;
+                }
+            }
+            std::optional<T> value{ std::move(storage_[head & (capacity() - 1)]) };
+            head_.store(head + 1, std::memory_order_release);
+            return value;
+        }
+
+        // consumer side: up to n filled slots to read (or move from) in place, handed back to the producer by commit_pop
+        RingReservation<T> reserve_pop(size_t n)
+        {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            return detail::ring_reservation(storage_, head, std::min(n, cached_tail_ - head));
+        }
+
+        void commit_pop(const RingReservation<T>& reservation)
+        {
+            head_.store(reservation.position + reservation.size(), std::memory_order_release);
+        }
+    };
+
+    // Bounded lock-free queue for any number of producers and consumers (Vyukov's sequence-numbered slots).
+    // Every slot has a sequence number in a separate array, so that the elements stay contiguous and batches can be
+    // handed out as VectorViews: a slot at position p is free when its sequence is p and filled when it is p + 1.
+    // Batches are claimed with a single CAS; they may be committed in any order.
+    template<typename T>
+    struct MpmcRingBuffer
+    {
+        Vector<T> storage_;
+        Vector<std::atomic<size_t>> sequences_;
+        alignas(cache_line_size) std::atomic<size_t> head_{ 0 };
+        alignas(cache_line_size) std::atomic<size_t> tail_{ 0 };
+
+        MpmcRingBuffer() noexcept = default;
+
+        // capacity is rounded up to a power of two
+        explicit MpmcRingBuffer(size_t capacity) :
+            storage_{ detail::ring_capacity(capacity), uninitialized_tag }, sequences_{ detail::ring_capacity(capacity), uninitialized_tag }
+        {
+            for (size_t i = 0; i < sequences_.size(); ++i) {
+                sequences_[i].store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // non-copyable
+        MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+        MpmcRingBuffer& operator = (const MpmcRingBuffer&) = delete;
+
+        MpmcRingBuffer(MpmcRingBuffer&& rhs) noexcept :
+            storage_{ std::move(rhs.storage_) }, sequences_{ std::move(rhs.sequences_) },
+            head_{ rhs.head_.exchange(0, std::memory_order_relaxed) }, tail_{ rhs.tail_.exchange(0, std::memory_order_relaxed) } {}
+
+        MpmcRingBuffer& operator = (MpmcRingBuffer&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                storage_ = std::move(rhs.storage_);
+                sequences_ = std::move(rhs.sequences_);
+                head_.store(rhs.head_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                tail_.store(rhs.tail_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            return *this;
+        }
+
+        ~MpmcRingBuffer() noexcept = default;
+
+        size_t capacity() const noexcept { return storage_.size(); }
+
+        // exact only when no thread is running
+        size_t size() const noexcept { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+        bool empty() const noexcept { return size() == 0; }
+
+        bool try_push(T value)
+        {
+            const auto reservation = reserve(tail_, 0, 1);
+            if (reservation.size() == 0) {
+                return false;
+            }
+            reservation.first[0] = std::move(value);
+            commit_push(reservation);
+            return true;
+        }
+
+        RingReservation<T> reserve_push(size_t n)
+        {
+            return reserve(tail_, 0, n);
+        }
+
+        void commit_push(const RingReservation<T>& reservation)
+        {
+            publish(reservation, 1);
+        }
+
+        std::optional<T> try_pop()
+        {
+            const auto reservation = reserve(head_, 1, 1);
+            if (reservation.size() == 0) {
+                return std::nullopt;
+            }
+            std::optional<T> value{ std::move(reservation.first[0]) };
+            commit_pop(reservation);
+            return value;
+        }
+
+        RingReservation<T> reserve_pop(size_t n)
+        {
+            return reserve(head_, 1, n);
+        }
+
+        void commit_pop(const RingReservation<T>& reservation)
+        {
+            publish(reservation, capacity());
+        }
+
+    private:
+        // claims up to n consecutive slots from index whose sequence is their position + ready
+        RingReservation<T> reserve(std::atomic<size_t>& index, size_t ready, size_t n)
+        {
+            if (capacity() == 0 || n == 0) {
+                return {};
+            }
+            const size_t mask = capacity() - 1;
+            size_t position = index.load(std::memory_order_relaxed);
+            for (;;) {
+                size_t count = 0;
+                while (count < n && count < capacity() && sequences_[(position + count) & mask].load(std::memory_order_acquire) == position + count + ready) {
+                    ++count;
+                }
+                if (count == 0) {
+                    const auto difference = static_cast<std::ptrdiff_t>(sequences_[position & mask].load(std::memory_order_acquire) - (position + ready));
+                    if (difference < 0) {
+                        return {}; // full (push) or empty (pop)
+                    }
+                    position = index.load(std::memory_order_relaxed); // another thread claimed position already
+                }
+                else if (index.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+                    return detail::ring_reservation(storage_, position, count);
+                }
+            }
+        }
+
+        void publish(const RingReservation<T>& reservation, size_t offset)
+        {
+            const size_t mask = capacity() - 1;
+            for (size_t i = 0; i < reservation.size(); ++i) {
+                const size_t position = reservation.position + i;
+                sequences_[position & mask].store(position + offset, std::memory_order_release);
+            }
+        }
+    };
+}
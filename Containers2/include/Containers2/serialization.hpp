@@ -0,0 +1,345 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+// Binary layout of nested arrays that is read in place: a serialized buffer is reopened as views without parsing
+// or copying, whether it was read into a Vector or mapped with MappedVector.
+//
+// All integers are little-endian (the zero-copy views need a little-endian host) and every array starts at a multiple
+// of serial_alignment from the start of the buffer. The buffer is
+//   header: magic "C2SERIAL", u32 version, u32 header bytes
+//   arrays: the elements of each array, written in the order they were streamed, children before their parents
+//   footer: the root SerializedVector, u64 total bytes, u32 sizeof of the leaf elements, u32 nesting depth of the
+//           root elements, 8 reserved bytes, magic "C2SEREND"
+// A SerializedVector is { i64 offset, u64 size }: the offset of its first element from the SerializedVector itself,
+// so that buffers can be moved, copied and mapped anywhere.
+static_assert(std::endian::native == std::endian::little, "serialized buffers are read in place: the host must be little-endian");
+
+namespace containers2 {
+
+    inline constexpr std::uint32_t serial_version = 1;
+
+    // of every array in a serialized buffer, and of the buffers themselves
+    inline constexpr size_t serial_alignment = 16;
+
+    struct SerializationError : std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
+
+    // An array in a serialized buffer, read in place: it only makes sense at its own address, so it cannot be copied
+    // out of the buffer. Nested as SerializedVector<SerializedVector<T>> for vectors of vectors.
+    template<typename T>
+    struct SerializedVector
+    {
+        std::int64_t offset_;
+        std::uint64_t size_;
+
+        SerializedVector(const SerializedVector&) = delete;
+        SerializedVector& operator = (const SerializedVector&) = delete;
+
+        const T* data() const noexcept { return reinterpret_cast<const T*>(reinterpret_cast<const std::byte*>(this) + offset_); }
+        const T* begin() const noexcept { return data(); }
+        const T* end() const noexcept { return data() + size_; }
+
+        size_t size() const noexcept { return static_cast<size_t>(size_); }
+        bool empty() const noexcept { return size_ == 0; }
+
+        const T& operator[](size_t index) const { return data()[index]; }
+
+        VectorView<const T> view() const noexcept { return { begin(), end() }; }
+    };
+
+    // where SerialWriter put an array: the offset of its first element from the start of the buffer
+    template<typename T>
+    struct SerialHandle
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    namespace detail {
+
+        template<typename T>
+        inline constexpr bool is_serial_handle_v = false;
+
+        template<typename T>
+        inline constexpr bool is_serial_handle_v<SerialHandle<T>> = true;
+
+        // levels of SerializedVector around the leaf elements
+        template<typename T>
+        inline constexpr std::uint32_t serial_depth_v = 0;
+
+        template<typename T>
+        inline constexpr std::uint32_t serial_depth_v<SerializedVector<T>> = 1 + serial_depth_v<T>;
+
+        template<typename T>
+        struct serial_leaf { using type = T; };
+
+        template<typename T>
+        struct serial_leaf<SerializedVector<T>> : serial_leaf<T> {};
+
+        template<typename T>
+        using serial_leaf_t = typename serial_leaf<T>::type;
+
+        struct SerialRef
+        {
+            std::int64_t offset;
+            std::uint64_t size;
+        };
+
+        struct SerialHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t header_bytes;
+        };
+
+        struct SerialFooter
+        {
+            SerialRef root;
+            std::uint64_t total_bytes;
+            std::uint32_t leaf_bytes;
+            std::uint32_t depth;
+            std::uint64_t reserved;
+            char magic[8];
+        };
+
+        inline constexpr char serial_header_magic[8]{ 'C', '2', 'S', 'E', 'R', 'I', 'A', 'L' };
+        inline constexpr char serial_footer_magic[8]{ 'C', '2', 'S', 'E', 'R', 'E', 'N', 'D' };
+
+        static_assert(sizeof(SerialHeader) % serial_alignment == 0 && sizeof(SerialFooter) % serial_alignment == 0);
+        static_assert(offsetof(SerialFooter, root) == 0);
+        static_assert(sizeof(SerializedVector<int>) == sizeof(SerialRef) && std::is_standard_layout_v<SerializedVector<int>>);
+    }
+
+    // Leaf elements: trivially copyable values without pointers, aligned to at most serial_alignment. Nested arrays are
+    // written from the SerialHandles of their children instead.
+    template<typename T>
+    concept Serializable = std::is_trivially_copyable_v<T> && alignof(T) <= serial_alignment && !detail::is_serial_handle_v<T>;
+
+    // Streams a serialized buffer to an std::ostream, never seeking: arrays are written bottom-up, a parent from the
+    // handles of children already written, so only the handles of the arrays still to be referenced stay in memory.
+    // One array at a time can also be streamed in chunks between begin_array() and end_array().
+    // Stream errors throw SerializationError.
+    struct SerialWriter
+    {
+        std::ostream* out_;
+        std::uint64_t position_ = 0;
+        // the array being streamed
+        bool open_ = false;
+        std::uint64_t open_offset_ = 0;
+        std::uint64_t open_size_ = 0;
+        bool finished_ = false;
+
+        explicit SerialWriter(std::ostream& out) : out_{ &out }
+        {
+            detail::SerialHeader header{};
+            std::memcpy(header.magic, detail::serial_header_magic, sizeof(header.magic));
+            header.version = serial_version;
+            header.header_bytes = sizeof(detail::SerialHeader);
+            write_bytes(&header, sizeof(header));
+        }
+
+        SerialWriter(const SerialWriter&) = delete;
+        SerialWriter& operator = (const SerialWriter&) = delete;
+
+        std::uint64_t bytes_written() const noexcept { return position_; }
+
+        template<Serializable T>
+        SerialHandle<T> write(VectorView<const T> values)
+        {
+            begin_array();
+            append<T>(values);
+            return end_array<T>();
+        }
+
+        // an array of the children
+        template<typename T>
+        SerialHandle<SerializedVector<T>> write(VectorView<const SerialHandle<T>> children)
+        {
+            begin_array();
+            append<T>(children);
+            return end_array<SerializedVector<T>>();
+        }
+
+        void begin_array()
+        {
+            check_open(false);
+            pad();
+            open_ = true;
+            open_offset_ = position_;
+            open_size_ = 0;
+        }
+
+        template<Serializable T>
+        void append(VectorView<const T> values)
+        {
+            check_open(true);
+            write_bytes(values.data(), values.size() * sizeof(T));
+            open_size_ += values.size();
+        }
+
+        // children of an array of SerializedVector<T>: each handle becomes an offset from the position of its element
+        template<typename T>
+        void append(VectorView<const SerialHandle<T>> children)
+        {
+            check_open(true);
+            constexpr size_t chunk = 256;
+            detail::SerialRef refs[chunk];
+            for (size_t first = 0; first < children.size(); first += chunk) {
+                const size_t n = std::min(chunk, children.size() - first);
+                for (size_t i = 0; i < n; ++i) {
+                    const std::uint64_t position = position_ + i * sizeof(detail::SerialRef);
+                    refs[i] = detail::SerialRef{ static_cast<std::int64_t>(children[first + i].offset - position), children[first + i].size };
+                }
+                write_bytes(refs, n * sizeof(detail::SerialRef));
+                open_size_ += n;
+            }
+        }
+
+        template<typename T>
+        SerialHandle<T> end_array()
+        {
+            check_open(true);
+            open_ = false;
+            return SerialHandle<T>{ open_offset_, open_size_ };
+        }
+
+        // writes the footer: the buffer is complete and opens as open_serialized<T>
+        template<typename T>
+        void finish(SerialHandle<T> root)
+        {
+            check_open(false);
+            pad();
+            detail::SerialFooter footer{};
+            footer.root = detail::SerialRef{ static_cast<std::int64_t>(root.offset - position_), root.size };
+            footer.total_bytes = position_ + sizeof(footer);
+            footer.leaf_bytes = sizeof(detail::serial_leaf_t<T>);
+            footer.depth = detail::serial_depth_v<T>;
+            std::memcpy(footer.magic, detail::serial_footer_magic, sizeof(footer.magic));
+            write_bytes(&footer, sizeof(footer));
+            out_->flush();
+            if (!*out_) {
+                throw SerializationError("serialized buffer: flush failed");
+            }
+            finished_ = true;
+        }
+
+    private:
+        void write_bytes(const void* p, size_t bytes)
+        {
+            if (finished_) {
+                throw std::logic_error("SerialWriter: the buffer is already finished");
+            }
+            out_->write(static_cast<const char*>(p), static_cast<std::streamsize>(bytes));
+            if (!*out_) {
+                throw SerializationError("serialized buffer: write failed");
+            }
+            position_ += bytes;
+        }
+
+        void pad()
+        {
+            const char zeros[serial_alignment]{};
+            write_bytes(zeros, (serial_alignment - position_ % serial_alignment) % serial_alignment);
+        }
+
+        void check_open(bool open) const
+        {
+            if (open_ != open) {
+                throw std::logic_error(open ? "SerialWriter: no array is open" : "SerialWriter: an array is still open");
+            }
+        }
+    };
+
+    namespace detail {
+
+        inline void check_serial_buffer(VectorView<const std::byte> buffer, std::uint32_t leaf_bytes, std::uint32_t depth)
+        {
+            if (reinterpret_cast<std::uintptr_t>(buffer.data()) % serial_alignment != 0) {
+                throw SerializationError("serialized buffer: misaligned");
+            }
+            if (buffer.size() < sizeof(SerialHeader) + sizeof(SerialFooter) || buffer.size() % serial_alignment != 0) {
+                throw SerializationError("serialized buffer: truncated");
+            }
+            const auto& header = *reinterpret_cast<const SerialHeader*>(buffer.data());
+            if (std::memcmp(header.magic, serial_header_magic, sizeof(header.magic)) != 0) {
+                throw SerializationError("serialized buffer: not a serialized buffer");
+            }
+            if (header.version != serial_version || header.header_bytes != sizeof(SerialHeader)) {
+                throw SerializationError("serialized buffer: unsupported version");
+            }
+            const auto& footer = *reinterpret_cast<const SerialFooter*>(buffer.data() + buffer.size() - sizeof(SerialFooter));
+            if (std::memcmp(footer.magic, serial_footer_magic, sizeof(footer.magic)) != 0 || footer.total_bytes != buffer.size()) {
+                throw SerializationError("serialized buffer: truncated");
+            }
+            if (footer.leaf_bytes != leaf_bytes || footer.depth != depth) {
+                throw SerializationError("serialized buffer: the root holds another type");
+            }
+        }
+
+        // the elements of ref lie between the header and the footer, aligned, and so do those of the nested arrays;
+        // budget is the number of nested array references left to visit
+        template<typename T>
+        void validate_serial(const SerializedVector<T>& ref, const std::byte* begin, const std::byte* end, std::uint64_t& budget)
+        {
+            const std::int64_t position = reinterpret_cast<const std::byte*>(&ref) - begin;
+            const std::int64_t first = ref.offset_;
+            const std::int64_t limit = end - begin;
+            if (first < -position || first > limit - position) {
+                throw SerializationError("serialized buffer: array out of bounds");
+            }
+            const std::int64_t target = position + first;
+            if (target < static_cast<std::int64_t>(sizeof(SerialHeader)) || static_cast<std::uint64_t>(target) % alignof(T) != 0) {
+                throw SerializationError("serialized buffer: array out of bounds");
+            }
+            if (ref.size_ > static_cast<std::uint64_t>(limit - target) / sizeof(T)) {
+                throw SerializationError("serialized buffer: array out of bounds");
+            }
+            if constexpr (serial_depth_v<T> != 0) {
+                // arrays referenced many times (a reused SerialHandle, or a hostile buffer) are walked once per
+                // reference: more references than the buffer can hold means the walk could blow up exponentially
+                if (ref.size_ > budget) {
+                    throw SerializationError("serialized buffer: too many references to shared arrays");
+                }
+                budget -= ref.size_;
+                for (const T& child : ref) {
+                    validate_serial(child, begin, end, budget);
+                }
+            }
+        }
+    }
+
+    // The root of a buffer written by SerialWriter::finish<T>, read in place: the views stay valid as long as the
+    // buffer. Checks the header and the footer only, in constant time: for trusted buffers.
+    template<typename T>
+    const SerializedVector<T>& open_serialized_trusted(VectorView<const std::byte> buffer)
+    {
+        detail::check_serial_buffer(buffer, sizeof(detail::serial_leaf_t<T>), detail::serial_depth_v<T>);
+        // the root opens the footer
+        return *reinterpret_cast<const SerializedVector<T>*>(buffer.data() + buffer.size() - sizeof(detail::SerialFooter));
+    }
+
+    // As open_serialized_trusted, after checking that every array of the tree lies within the buffer, aligned for its
+    // elements: for untrusted input. Every reference to a nested array is checked, leaf elements are not read; the
+    // references visited may not outnumber those the buffer can hold, so the cost is linear in the buffer size and
+    // trees that share arrays beyond that (SerialHandles reused many times over) are rejected.
+    template<typename T>
+    const SerializedVector<T>& open_serialized(VectorView<const std::byte> buffer)
+    {
+        const SerializedVector<T>& root = open_serialized_trusted<T>(buffer);
+        std::uint64_t budget = (buffer.size() - sizeof(detail::SerialHeader) - sizeof(detail::SerialFooter)) / sizeof(detail::SerialRef);
+        detail::validate_serial(root, buffer.data(), buffer.data() + buffer.size() - sizeof(detail::SerialFooter), budget);
+        return root;
+    }
+}
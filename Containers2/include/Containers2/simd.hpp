@@ -0,0 +1,398 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+// Vectorized kernels over VectorView for arithmetic element types.
+// On x86 with GCC/Clang every kernel is compiled for SSE2, AVX2 and AVX-512 and the widest instruction set
+// supported by the running CPU is picked at runtime; everywhere else only the scalar version exists.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CONTAINERS2_SIMD_X86 1
+#define CONTAINERS2_SIMD_INLINE [[gnu::always_inline]] inline
+#else
+#define CONTAINERS2_SIMD_X86 0
+#define CONTAINERS2_SIMD_INLINE inline
+#endif
+
+namespace containers2::simd {
+
+    // instruction sets the kernels are compiled for, in increasing order of width
+    enum class Isa { scalar, sse2, avx2, avx512 };
+
+    inline Isa detected_isa() noexcept
+    {
+#if CONTAINERS2_SIMD_X86
+        static const Isa isa = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                return Isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return Isa::avx2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return Isa::sse2;
+            }
+            return Isa::scalar;
+        }();
+        return isa;
+#else
+        return Isa::scalar;
+#endif
+    }
+
+    template<typename T>
+    concept Arithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    // the comparisons accepted by compare(): they apply lane-wise to compiler vectors as well
+    template<typename Compare>
+    concept VectorComparison =
+        std::is_same_v<Compare, std::equal_to<>> || std::is_same_v<Compare, std::not_equal_to<>> ||
+        std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less_equal<>> ||
+        std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater_equal<>>;
+
+    namespace detail {
+
+        // Every kernel is a struct with a static run<Bytes>(): the vector loop works on compiler vectors of Bytes bytes
+        // (Bytes == 0 skips it), the scalar loop handles the tail. run() is force-inlined in the per-instruction-set
+        // wrappers below so that the same body is code-generated once per target.
+
+        template<size_t Bytes, typename T>
+        inline constexpr size_t lanes = Bytes / sizeof(T);
+
+        struct Fill
+        {
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static void run(T* p, size_t n, T value)
+            {
+                size_t i = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    typedef T V __attribute__((vector_size(Bytes)));
+                    const V v = V{} + value;
+                    for (; i + lanes<Bytes, T> <= n; i += lanes<Bytes, T>) {
+                        std::memcpy(p + i, &v, sizeof(V));
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    p[i] = value;
+                }
+            }
+        };
+
+        struct Sum
+        {
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static T run(const T* p, size_t n)
+            {
+                size_t i = 0;
+                T result{};
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    typedef T V __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = lanes<Bytes, T>;
+                    // two independent accumulators hide the latency of floating point additions
+                    V acc0{};
+                    V acc1{};
+                    for (; i + 2 * L <= n; i += 2 * L) {
+                        V v0;
+                        V v1;
+                        std::memcpy(&v0, p + i, sizeof(V));
+                        std::memcpy(&v1, p + i + L, sizeof(V));
+                        acc0 += v0;
+                        acc1 += v1;
+                    }
+                    acc0 += acc1;
+                    for (size_t l = 0; l < L; ++l) {
+                        result += acc0[l];
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result += p[i];
+                }
+                return result;
+            }
+        };
+
+        template<bool Max>
+        struct MinMax
+        {
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static T run(const T* p, size_t n)
+            {
+                size_t i = 0;
+                T result = Max ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    typedef T V __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = lanes<Bytes, T>;
+                    V acc = V{} + result;
+                    for (; i + L <= n; i += L) {
+                        V v;
+                        std::memcpy(&v, p + i, sizeof(V));
+                        if constexpr (Max) {
+                            acc = v > acc ? v : acc;
+                        }
+                        else {
+                            acc = v < acc ? v : acc;
+                        }
+                    }
+                    for (size_t l = 0; l < L; ++l) {
+                        result = Max ? std::max<T>(result, acc[l]) : std::min<T>(result, acc[l]);
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result = Max ? std::max(result, p[i]) : std::min(result, p[i]);
+                }
+                return result;
+            }
+        };
+
+        struct Dot
+        {
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static T run(const T* a, const T* b, size_t n)
+            {
+                size_t i = 0;
+                T result{};
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    typedef T V __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = lanes<Bytes, T>;
+                    V acc0{};
+                    V acc1{};
+                    for (; i + 2 * L <= n; i += 2 * L) {
+                        V a0;
+                        V a1;
+                        V b0;
+                        V b1;
+                        std::memcpy(&a0, a + i, sizeof(V));
+                        std::memcpy(&a1, a + i + L, sizeof(V));
+                        std::memcpy(&b0, b + i, sizeof(V));
+                        std::memcpy(&b1, b + i + L, sizeof(V));
+                        acc0 += a0 * b0;
+                        acc1 += a1 * b1;
+                    }
+                    acc0 += acc1;
+                    for (size_t l = 0; l < L; ++l) {
+                        result += acc0[l];
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result += a[i] * b[i];
+                }
+                return result;
+            }
+        };
+
+        struct Count
+        {
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static size_t run(const T* p, size_t n, T value)
+            {
+                size_t i = 0;
+                size_t result = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    typedef T V __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = lanes<Bytes, T>;
+                    const V x = V{} + value;
+                    while (i + L <= n) {
+                        // matches are -1 lanes: subtract them, flushing before 8-bit lanes can overflow
+                        decltype(x == x) acc{};
+                        for (size_t block = 0; block < 64 && i + L <= n; ++block, i += L) {
+                            V v;
+                            std::memcpy(&v, p + i, sizeof(V));
+                            acc -= v == x;
+                        }
+                        for (size_t l = 0; l < L; ++l) {
+                            result += static_cast<size_t>(acc[l]);
+                        }
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    result += p[i] == value;
+                }
+                return result;
+            }
+        };
+
+        struct Find
+        {
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static size_t run(const T* p, size_t n, T value)
+            {
+                size_t i = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    typedef T V __attribute__((vector_size(Bytes)));
+                    typedef std::conditional_t<sizeof(T) != 0, unsigned long long, void> W __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = lanes<Bytes, T>;
+                    const V x = V{} + value;
+                    for (; i + L <= n; i += L) {
+                        V v;
+                        std::memcpy(&v, p + i, sizeof(V));
+                        const W m = reinterpret_cast<W>(v == x);
+                        unsigned long long any = 0;
+                        for (size_t w = 0; w < Bytes / sizeof(unsigned long long); ++w) {
+                            any |= m[w];
+                        }
+                        if (any != 0) {
+                            break; // the scalar loop locates the lane
+                        }
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    if (p[i] == value) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+        };
+
+        template<typename Compare>
+        struct CompareKernel
+        {
+            template<size_t Bytes, typename T>
+            CONTAINERS2_SIMD_INLINE static void run(const T* a, const T* b, bool* out, size_t n)
+            {
+                size_t i = 0;
+#if CONTAINERS2_SIMD_X86
+                if constexpr (Bytes != 0) {
+                    typedef T V __attribute__((vector_size(Bytes)));
+                    constexpr size_t L = lanes<Bytes, T>;
+                    for (; i + L <= n; i += L) {
+                        V va;
+                        V vb;
+                        std::memcpy(&va, a + i, sizeof(V));
+                        std::memcpy(&vb, b + i, sizeof(V));
+                        // spelled out rather than calling Compare{}, whose operator() would pass vectors across a call
+                        decltype(va == vb) m;
+                        if constexpr (std::is_same_v<Compare, std::equal_to<>>) {
+                            m = va == vb;
+                        }
+                        else if constexpr (std::is_same_v<Compare, std::not_equal_to<>>) {
+                            m = va != vb;
+                        }
+                        else if constexpr (std::is_same_v<Compare, std::less<>>) {
+                            m = va < vb;
+                        }
+                        else if constexpr (std::is_same_v<Compare, std::less_equal<>>) {
+                            m = va <= vb;
+                        }
+                        else if constexpr (std::is_same_v<Compare, std::greater<>>) {
+                            m = va > vb;
+                        }
+                        else {
+                            m = va >= vb;
+                        }
+                        // lanes are 0 or -1: the low bit is the result (m[l] != 0 makes GCC 12 ICE at -O3 with AVX-512)
+                        for (size_t l = 0; l < L; ++l) {
+                            out[i + l] = static_cast<bool>(m[l] & 1);
+                        }
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    out[i] = Compare{}(a[i], b[i]);
+                }
+            }
+        };
+
+#if CONTAINERS2_SIMD_X86
+        template<typename Kernel, typename... Args>
+        __attribute__((target("sse2"))) auto run_sse2(Args... args) { return Kernel::template run<16>(args...); }
+
+        template<typename Kernel, typename... Args>
+        __attribute__((target("avx2"))) auto run_avx2(Args... args) { return Kernel::template run<32>(args...); }
+
+        template<typename Kernel, typename... Args>
+        __attribute__((target("avx512f,avx512bw"))) auto run_avx512(Args... args) { return Kernel::template run<64>(args...); }
+#endif
+
+        // requesting an instruction set the CPU lacks falls back to the widest one it has
+        template<typename Kernel, typename... Args>
+        auto dispatch(Isa isa, Args... args)
+        {
+#if CONTAINERS2_SIMD_X86
+            switch (std::min(isa, detected_isa())) {
+            case Isa::avx512:
+                return run_avx512<Kernel>(args...);
+            case Isa::avx2:
+                return run_avx2<Kernel>(args...);
+            case Isa::sse2:
+                return run_sse2<Kernel>(args...);
+            case Isa::scalar:
+                break;
+            }
+#endif
+            return Kernel::template run<0>(args...);
+        }
+    }
+
+    template<Arithmetic T>
+    void fill(VectorView<T> view, std::type_identity_t<T> value, Isa isa = detected_isa())
+    {
+        detail::dispatch<detail::Fill>(isa, view.data(), view.size(), value);
+    }
+
+    // computed in T, like std::accumulate(begin, end, T{}); floating point sums are reassociated
+    template<Arithmetic T>
+    T sum(VectorView<const T> view, Isa isa = detected_isa())
+    {
+        return detail::dispatch<detail::Sum>(isa, view.data(), view.size());
+    }
+
+    // the minimum of an empty view is std::numeric_limits<T>::max()
+    template<Arithmetic T>
+    T min(VectorView<const T> view, Isa isa = detected_isa())
+    {
+        return detail::dispatch<detail::MinMax<false>>(isa, view.data(), view.size());
+    }
+
+    // the maximum of an empty view is std::numeric_limits<T>::lowest()
+    template<Arithmetic T>
+    T max(VectorView<const T> view, Isa isa = detected_isa())
+    {
+        return detail::dispatch<detail::MinMax<true>>(isa, view.data(), view.size());
+    }
+
+    // a and b must have the same size
+    template<Arithmetic T>
+    T dot(VectorView<const T> a, VectorView<const T> b, Isa isa = detected_isa())
+    {
+        return detail::dispatch<detail::Dot>(isa, a.data(), b.data(), a.size());
+    }
+
+    template<Arithmetic T>
+    size_t count(VectorView<const T> view, std::type_identity_t<T> value, Isa isa = detected_isa())
+    {
+        return detail::dispatch<detail::Count>(isa, view.data(), view.size(), value);
+    }
+
+    // index of the first element equal to value, view.size() if there is none
+    template<Arithmetic T>
+    size_t find(VectorView<const T> view, std::type_identity_t<T> value, Isa isa = detected_isa())
+    {
+        return detail::dispatch<detail::Find>(isa, view.data(), view.size(), value);
+    }
+
+    // out[i] = Compare{}(a[i], b[i]); a, b and out must have the same size
+    template<VectorComparison Compare, Arithmetic T>
+    void compare(VectorView<const T> a, VectorView<const T> b, VectorView<bool> out, Compare = {}, Isa isa = detected_isa())
+    {
+        detail::dispatch<detail::CompareKernel<Compare>>(isa, a.data(), b.data(), out.data(), a.size());
+    }
+}
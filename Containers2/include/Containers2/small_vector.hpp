@@ -0,0 +1,351 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    // Owning container with a compile-time capacity N stored inline (no heap allocation at all).
+    // Like Vector, all N elements are constructed and [begin_, end_) is the live part, it is move-only and it is a
+    // VectorView, so every function taking a view accepts it. Growing past N throws std::length_error.
+    // Moves relocate the elements into the destination's own storage.
+    template<typename T, size_t N>
+    struct InlineVector : VectorView<T>
+    {
+        using U = std::remove_const_t<T>;
+        using super = VectorView<T>;
+        using super::begin_;
+        using super::end_;
+
+        std::array<U, N> storage_;
+
+        InlineVector() noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            super::operator =(super{ storage_.data(), storage_.data() });
+        }
+
+        explicit InlineVector(size_t s, uninitialized_tag_t = uninitialized_tag) : InlineVector()
+        {
+            set_size(s);
+        }
+
+        explicit InlineVector(size_t s, T value, initialized_tag_t = initialized_tag) : InlineVector(s, uninitialized_tag)
+        {
+            std::fill(storage_.begin(), storage_.begin() + s, value);
+        }
+
+        InlineVector(std::initializer_list<T> l) : InlineVector(std::size(l), uninitialized_tag)
+        {
+            std::copy(std::begin(l), std::end(l), storage_.begin());
+        }
+
+        // non-copyable
+        InlineVector(const InlineVector&) = delete;
+        InlineVector& operator = (const InlineVector&) = delete;
+
+        // non-copyable from parent classes
+        InlineVector(const VectorView<const T>&) = delete;
+        InlineVector& operator = (const VectorView<const T>&) = delete;
+        InlineVector(const VectorView<std::remove_const_t<T>>&) = delete;
+        InlineVector& operator = (const VectorView<std::remove_const_t<T>>&) = delete;
+
+        // moves leave rhs empty, like Vector's
+        InlineVector(InlineVector&& rhs) noexcept(std::is_nothrow_move_assignable_v<U>) : InlineVector()
+        {
+            take(rhs);
+        }
+
+        InlineVector& operator = (InlineVector&& rhs) & noexcept(std::is_nothrow_move_assignable_v<U>)
+        {
+            if (this != &rhs) {
+                take(rhs);
+            }
+            return *this;
+        }
+
+        InlineVector(InlineVector<U, N>&& rhs) noexcept(std::is_nothrow_move_assignable_v<U>) requires(std::is_const_v<T>) : InlineVector()
+        {
+            take(rhs);
+        }
+
+        InlineVector& operator = (InlineVector<U, N>&& rhs) & noexcept(std::is_nothrow_move_assignable_v<U>) requires(std::is_const_v<T>)
+        {
+            take(rhs);
+            return *this;
+        }
+
+        ~InlineVector() noexcept = default;
+
+        using super::begin;
+        using super::end;
+        using super::data;
+        using super::operator[];
+        using super::size;
+
+        static constexpr size_t capacity() noexcept { return N; }
+
+        void resize(size_t s, non_preserving_uninitialized_tag_t) requires(!std::is_const_v<T>)
+        {
+            set_size(s);
+        }
+
+        void resize(size_t s, T value, non_preserving_initialized_tag_t) requires(!std::is_const_v<T>)
+        {
+            set_size(s);
+            std::fill(begin(), end(), value);
+        }
+
+        void resize(size_t s, uninitialized_tag_t = uninitialized_tag) requires(!std::is_const_v<T>)
+        {
+            set_size(s);
+        }
+
+        void resize(size_t s, T value, initialized_tag_t = initialized_tag) requires(!std::is_const_v<T>)
+        {
+            const size_t old_size = size();
+            set_size(s);
+            if (s > old_size) {
+                std::fill(begin() + old_size, end(), value);
+            }
+        }
+
+    private:
+        template<typename V, size_t M>
+        friend struct InlineVector;
+
+        void set_size(size_t s)
+        {
+            if (s > N) {
+                throw std::length_error("InlineVector capacity exceeded");
+            }
+            super::operator =(super{ storage_.data(), storage_.data() + s });
+        }
+
+        template<typename V>
+        void take(InlineVector<V, N>& rhs)
+        {
+            const size_t s = rhs.size();
+            std::move(rhs.storage_.begin(), rhs.storage_.begin() + s, storage_.begin());
+            set_size(s);
+            rhs.set_size(0);
+        }
+    };
+
+    // Owning container keeping up to N elements inline and spilling to a heap Vector past that.
+    // Spilling preserves the elements and grows geometrically; shrink_to_fit() moves them back inline when they fit.
+    // Moves never allocate: heap buffers are handed over (also from and to a Vector), inline elements are relocated.
+    template<typename T, size_t N>
+    struct SmallVector : VectorView<T>
+    {
+        using U = std::remove_const_t<T>;
+        using super = VectorView<T>;
+        using super::begin_;
+        using super::end_;
+
+        std::array<U, N> inline_;
+        Vector<U> heap_; // empty while the elements are inline
+
+        SmallVector() noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            super::operator =(super{ inline_.data(), inline_.data() });
+        }
+
+        explicit SmallVector(size_t s, uninitialized_tag_t = uninitialized_tag) : SmallVector()
+        {
+            resize_storage(s, false);
+        }
+
+        explicit SmallVector(size_t s, T value, initialized_tag_t = initialized_tag) : SmallVector(s, uninitialized_tag)
+        {
+            std::fill(mutable_begin(), mutable_begin() + s, value);
+        }
+
+        SmallVector(std::initializer_list<T> l) : SmallVector(std::size(l), uninitialized_tag)
+        {
+            std::copy(std::begin(l), std::end(l), mutable_begin());
+        }
+
+        // adopts the buffer of a Vector without allocating
+        explicit SmallVector(Vector<U>&& rhs) noexcept(std::is_nothrow_default_constructible_v<U>) : SmallVector()
+        {
+            adopt(std::move(rhs));
+        }
+
+        // non-copyable
+        SmallVector(const SmallVector&) = delete;
+        SmallVector& operator = (const SmallVector&) = delete;
+
+        // non-copyable from parent classes
+        SmallVector(const VectorView<const T>&) = delete;
+        SmallVector& operator = (const VectorView<const T>&) = delete;
+        SmallVector(const VectorView<std::remove_const_t<T>>&) = delete;
+        SmallVector& operator = (const VectorView<std::remove_const_t<T>>&) = delete;
+
+        SmallVector(SmallVector&& rhs) noexcept(std::is_nothrow_move_assignable_v<U>) : SmallVector()
+        {
+            take(rhs);
+        }
+
+        SmallVector& operator = (SmallVector&& rhs) & noexcept(std::is_nothrow_move_assignable_v<U>)
+        {
+            if (this != &rhs) {
+                take(rhs);
+            }
+            return *this;
+        }
+
+        SmallVector(SmallVector<U, N>&& rhs) noexcept(std::is_nothrow_move_assignable_v<U>) requires(std::is_const_v<T>) : SmallVector()
+        {
+            take(rhs);
+        }
+
+        SmallVector& operator = (SmallVector<U, N>&& rhs) & noexcept(std::is_nothrow_move_assignable_v<U>) requires(std::is_const_v<T>)
+        {
+            take(rhs);
+            return *this;
+        }
+
+        ~SmallVector() noexcept = default;
+
+        using super::begin;
+        using super::end;
+        using super::data;
+        using super::operator[];
+        using super::size;
+
+        bool is_inline() const noexcept { return heap_.data() == nullptr; }
+
+        size_t capacity() const noexcept { return is_inline() ? N : heap_.capacity(); }
+
+        // hands the elements over to a Vector: free when they are on the heap, one allocation when they are inline
+        Vector<U> release() && requires(!std::is_const_v<T>)
+        {
+            if (is_inline()) {
+                Vector<U> result{ size(), uninitialized_tag };
+                std::move(mutable_begin(), mutable_begin() + size(), result.begin());
+                clear_storage();
+                return result;
+            }
+            Vector<U> result{ std::move(heap_) };
+            clear_storage();
+            return result;
+        }
+
+        void shrink_to_fit() requires(!std::is_const_v<T>)
+        {
+            if (is_inline()) {
+                return;
+            }
+            const size_t s = size();
+            if (s <= N) {
+                std::move(heap_.begin(), heap_.begin() + s, inline_.begin());
+                clear_storage();
+                super::operator =(super{ inline_.data(), inline_.data() + s });
+            }
+            else {
+                heap_.shrink_to_fit();
+                super::operator =(super{ heap_.begin(), heap_.end() });
+            }
+        }
+
+        void resize(size_t s, non_preserving_uninitialized_tag_t) requires(!std::is_const_v<T>)
+        {
+            resize_storage(s, false);
+        }
+
+        void resize(size_t s, T value, non_preserving_initialized_tag_t) requires(!std::is_const_v<T>)
+        {
+            resize_storage(s, false);
+            std::fill(begin(), end(), value);
+        }
+
+        void resize(size_t s, uninitialized_tag_t = uninitialized_tag) requires(!std::is_const_v<T>)
+        {
+            resize_storage(s, true);
+        }
+
+        void resize(size_t s, T value, initialized_tag_t = initialized_tag) requires(!std::is_const_v<T>)
+        {
+            const size_t old_size = size();
+            resize_storage(s, true);
+            if (s > old_size) {
+                std::fill(begin() + old_size, end(), value);
+            }
+        }
+
+    private:
+        template<typename V, size_t M>
+        friend struct SmallVector;
+
+        U* mutable_begin() const noexcept { return const_cast<U*>(super::begin()); }
+
+        void resize_storage(size_t s, bool preserve)
+        {
+            if (!is_inline()) {
+                if (preserve) {
+                    heap_.resize(s, uninitialized_tag);
+                }
+                else {
+                    heap_.resize(s, non_preserving_uninitialized_tag);
+                }
+                super::operator =(super{ heap_.begin(), heap_.end() });
+            }
+            else if (s <= N) {
+                super::operator =(super{ inline_.data(), inline_.data() + s });
+            }
+            else {
+                Vector<U> spilled{ preserve ? std::max(s, 2 * N) : s, uninitialized_tag };
+                if (preserve) {
+                    std::move(inline_.begin(), inline_.begin() + size(), spilled.begin());
+                }
+                spilled.resize(s, uninitialized_tag);
+                heap_ = std::move(spilled);
+                super::operator =(super{ heap_.begin(), heap_.end() });
+            }
+        }
+
+        void adopt(Vector<U>&& rhs) noexcept
+        {
+            heap_ = std::move(rhs);
+            if (heap_.data() == nullptr) {
+                super::operator =(super{ inline_.data(), inline_.data() });
+            }
+            else {
+                super::operator =(super{ heap_.begin(), heap_.end() });
+            }
+        }
+
+        template<typename V>
+        void take(SmallVector<V, N>& rhs)
+        {
+            if (rhs.is_inline()) {
+                const size_t s = rhs.size();
+                std::move(rhs.inline_.begin(), rhs.inline_.begin() + s, inline_.begin());
+                clear_storage();
+                super::operator =(super{ inline_.data(), inline_.data() + s });
+            }
+            else {
+                adopt(std::move(rhs.heap_));
+            }
+            rhs.clear_storage();
+        }
+
+        void clear_storage() noexcept
+        {
+            heap_ = Vector<U>{};
+            super::operator =(super{ inline_.data(), inline_.data() });
+        }
+    };
+
+    template<typename T, size_t N>
+    inline constexpr bool is_owning_container_v<InlineVector<T, N>> = true;
+
+    template<typename T, size_t N>
+    inline constexpr bool is_owning_container_v<SmallVector<T, N>> = true;
+}
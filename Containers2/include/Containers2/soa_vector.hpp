@@ -0,0 +1,231 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    // Structure-of-arrays owning container: one contiguous column per field, all in a single allocation with every
+    // column starting on its own cache line. Each column is exposed as a VectorView<Field>, const-qualified fields give
+    // VectorView<const Field> columns (decoupled constness, as for Vector<const T>).
+    // Like Vector it is move-only, all capacity() rows are constructed and [0, size()) are the live ones.
+    template<typename... Fields>
+    struct SoAVector
+    {
+        static_assert(sizeof...(Fields) != 0, "SoAVector needs at least one field");
+
+        template<size_t I>
+        using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+        using columns_t = std::tuple<std::remove_const_t<Fields>*...>;
+
+        static constexpr size_t column_alignment = std::max({ cache_line_size, alignof(Fields)... });
+
+        static constexpr bool has_const_fields = (std::is_const_v<Fields> || ...);
+
+        columns_t columns_{};
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+        std::pmr::memory_resource* resource_ = std::pmr::new_delete_resource();
+
+        SoAVector() noexcept = default;
+
+        explicit SoAVector(size_t s, uninitialized_tag_t = uninitialized_tag, std::pmr::memory_resource* resource = std::pmr::new_delete_resource()) requires(!has_const_fields) :
+            columns_{ allocate(s, resource) }, size_{ s }, capacity_{ s }, resource_{ resource } {}
+
+        SoAVector(size_t s, const std::tuple<Fields...>& value, initialized_tag_t = initialized_tag, std::pmr::memory_resource* resource = std::pmr::new_delete_resource()) :
+            columns_{ allocate(s, resource) }, size_{ s }, capacity_{ s }, resource_{ resource }
+        {
+            fill(0, s, value);
+        }
+
+        // non-copyable
+        SoAVector(const SoAVector&) = delete;
+        SoAVector& operator = (const SoAVector&) = delete;
+
+        SoAVector(SoAVector&& rhs) noexcept :
+            columns_{ std::exchange(rhs.columns_, {}) }, size_{ std::exchange(rhs.size_, 0) }, capacity_{ std::exchange(rhs.capacity_, 0) }, resource_{ rhs.resource_ } {}
+
+        SoAVector& operator = (SoAVector&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                deallocate();
+                columns_ = std::exchange(rhs.columns_, {});
+                size_ = std::exchange(rhs.size_, 0);
+                capacity_ = std::exchange(rhs.capacity_, 0);
+                resource_ = rhs.resource_;
+            }
+            return *this;
+        }
+
+        SoAVector(SoAVector<std::remove_const_t<Fields>...>&& rhs) noexcept requires(has_const_fields) :
+            columns_{ std::exchange(rhs.columns_, {}) }, size_{ std::exchange(rhs.size_, 0) }, capacity_{ std::exchange(rhs.capacity_, 0) }, resource_{ rhs.resource_ } {}
+
+        SoAVector& operator = (SoAVector<std::remove_const_t<Fields>...>&& rhs) & noexcept requires(has_const_fields)
+        {
+            deallocate();
+            columns_ = std::exchange(rhs.columns_, {});
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+            resource_ = rhs.resource_;
+            return *this;
+        }
+
+        ~SoAVector() noexcept
+        {
+            deallocate();
+        }
+
+        size_t size() const noexcept { return size_; }
+        size_t capacity() const noexcept { return capacity_; }
+
+        template<size_t I>
+        VectorView<field_t<I>> column() const
+        {
+            auto* p = std::get<I>(columns_);
+            return { p, p + size_ };
+        }
+
+        std::tuple<VectorView<Fields>...> columns() const
+        {
+            return std::apply([this](auto*... p) { return std::tuple<VectorView<Fields>...>{ VectorView<Fields>{ p, p + size_ }... }; }, columns_);
+        }
+
+        // the fields of a row, by reference
+        std::tuple<Fields&...> operator[](size_t index) const
+        {
+            return std::apply([index](auto*... p) { return std::tuple<Fields&...>{ p[index]... }; }, columns_);
+        }
+
+        void reserve(size_t c) requires(!has_const_fields)
+        {
+            if (c > capacity_) {
+                reallocate(c);
+            }
+        }
+
+        void shrink_to_fit() requires(!has_const_fields)
+        {
+            if (capacity_ != size_) {
+                reallocate(size_);
+            }
+        }
+
+        void resize(size_t s, non_preserving_uninitialized_tag_t) requires(!has_const_fields)
+        {
+            if (s > capacity_) {
+                *this = SoAVector{ s, uninitialized_tag, resource_ };
+            }
+            size_ = s;
+        }
+
+        void resize(size_t s, const std::tuple<Fields...>& value, non_preserving_initialized_tag_t) requires(!has_const_fields)
+        {
+            resize(s, non_preserving_uninitialized_tag);
+            fill(0, s, value);
+        }
+
+        void resize(size_t s, uninitialized_tag_t = uninitialized_tag) requires(!has_const_fields)
+        {
+            if (s > capacity_) {
+                reallocate(std::max(s, 2 * capacity_));
+            }
+            size_ = s;
+        }
+
+        void resize(size_t s, const std::tuple<Fields...>& value, initialized_tag_t = initialized_tag) requires(!has_const_fields)
+        {
+            const size_t old_size = size_;
+            resize(s, uninitialized_tag);
+            if (s > old_size) {
+                fill(old_size, s, value);
+            }
+        }
+
+    private:
+        static constexpr size_t count = sizeof...(Fields);
+
+        static constexpr size_t align_up(size_t bytes) noexcept { return (bytes + column_alignment - 1) & ~(column_alignment - 1); }
+
+        // byte offset of every column for c rows, followed by the total size
+        static constexpr std::array<size_t, count + 1> layout(size_t c) noexcept
+        {
+            std::array<size_t, count + 1> offsets{};
+            size_t offset = 0;
+            size_t i = 0;
+            ((offsets[i++] = offset, offset = align_up(offset + c * sizeof(Fields))), ...);
+            offsets[count] = offset;
+            return offsets;
+        }
+
+        template<size_t I = 0>
+        static void construct_columns(const columns_t& columns, size_t c)
+        {
+            if constexpr (I < count) {
+                std::uninitialized_default_construct_n(std::get<I>(columns), c);
+                try {
+                    construct_columns<I + 1>(columns, c);
+                }
+                catch (...) {
+                    std::destroy_n(std::get<I>(columns), c);
+                    throw;
+                }
+            }
+        }
+
+        static columns_t allocate(size_t c, std::pmr::memory_resource* resource)
+        {
+            if (c == 0) {
+                return {};
+            }
+            const auto offsets = layout(c);
+            std::byte* buffer = static_cast<std::byte*>(resource->allocate(offsets[count], column_alignment));
+            columns_t columns = [&]<size_t... I>(std::index_sequence<I...>) {
+                return columns_t{ reinterpret_cast<std::remove_const_t<Fields>*>(buffer + offsets[I])... };
+            }(std::index_sequence_for<Fields...>{});
+            try {
+                construct_columns(columns, c);
+            }
+            catch (...) {
+                resource->deallocate(buffer, offsets[count], column_alignment);
+                throw;
+            }
+            return columns;
+        }
+
+        void deallocate() noexcept
+        {
+            if (capacity_ == 0) {
+                return;
+            }
+            std::apply([this](auto*... p) { (std::destroy_n(p, capacity_), ...); }, columns_);
+            resource_->deallocate(std::get<0>(columns_), layout(capacity_)[count], column_alignment);
+        }
+
+        void reallocate(size_t c)
+        {
+            const size_t s = std::min(size_, c);
+            SoAVector<std::remove_const_t<Fields>...> grown{ c, uninitialized_tag, resource_ };
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (std::move(std::get<I>(columns_), std::get<I>(columns_) + s, std::get<I>(grown.columns_)), ...);
+            }(std::index_sequence_for<Fields...>{});
+            grown.size_ = s;
+            *this = std::move(grown);
+        }
+
+        void fill(size_t from, size_t to, const std::tuple<Fields...>& value)
+        {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (std::fill(std::get<I>(columns_) + from, std::get<I>(columns_) + to, std::get<I>(value)), ...);
+            }(std::index_sequence_for<Fields...>{});
+        }
+    };
+}
@@ -0,0 +1,405 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    // the keys are already sorted and unique: the constructors skip sorting
+    inline struct sorted_unique_tag_t {} sorted_unique_tag;
+
+    // How a SortedSet lays its keys out for searching:
+    // sorted: the sorted keys alone, searched by a branchless binary search; no extra memory.
+    // eytzinger: a copy of the keys in breadth-first order of a complete binary tree (at most twice the keys), so
+    // that the next levels of a search share cache lines and can be prefetched together.
+    // btree: the sorted keys are the leaves of an implicit static B+ tree whose nodes fill a cache line; the inner
+    // levels take about 1/B of the keys. Fewest cache misses per search at large sizes.
+    enum class SortedLayout { sorted, eytzinger, btree };
+
+    // Immutable set of unique keys, built once from a Vector taken by move (sorted and deduplicated in its own
+    // buffer) and searched many times. Results are ranks, i.e. positions in the sorted keys, whatever the layout.
+    // Move-only like Vector: clone() is the explicit deep copy. Searches never write and can run on any number of
+    // threads.
+    template<typename K, typename Compare = std::less<K>>
+    struct SortedSet
+    {
+        // keys per B+ tree node: a cache line of them, and at least 4 for large keys
+        static constexpr size_t node_keys = std::max<size_t>(64 / sizeof(K), 4);
+
+        Vector<const K> keys_;
+        Vector<const K> index_; // eytzinger: 1-based complete tree; btree: inner levels, root first
+        Vector<size_t> level_begin_; // btree: offset of each inner level in index_, root first
+        size_t height_ = 0; // eytzinger: levels of the complete tree; btree: inner levels
+        SortedLayout layout_ = SortedLayout::sorted;
+        [[no_unique_address]] Compare comp_{};
+
+        SortedSet() noexcept = default;
+
+        explicit SortedSet(Vector<K>&& keys, SortedLayout layout = SortedLayout::sorted, Compare comp = Compare{}) :
+            comp_{ std::move(comp) }
+        {
+            std::sort(keys.begin(), keys.end(), comp_);
+            const K* last = std::unique(keys.begin(), keys.end(), [this](const K& a, const K& b) { return !comp_(a, b); });
+            keys.resize(static_cast<size_t>(last - keys.begin()));
+            keys_ = std::move(keys);
+            build(layout);
+        }
+
+        SortedSet(Vector<K>&& keys, sorted_unique_tag_t, SortedLayout layout = SortedLayout::sorted, Compare comp = Compare{}) :
+            keys_{ std::move(keys) }, comp_{ std::move(comp) }
+        {
+            build(layout);
+        }
+
+        // non-copyable, see clone()
+        SortedSet(const SortedSet&) = delete;
+        SortedSet& operator = (const SortedSet&) = delete;
+
+        SortedSet(SortedSet&& rhs) noexcept :
+            keys_{ std::move(rhs.keys_) }, index_{ std::move(rhs.index_) }, level_begin_{ std::move(rhs.level_begin_) },
+            height_{ std::exchange(rhs.height_, 0) }, layout_{ std::exchange(rhs.layout_, SortedLayout::sorted) }, comp_{ rhs.comp_ } {}
+
+        SortedSet& operator = (SortedSet&& rhs) & noexcept
+        {
+            if (this != &rhs) {
+                keys_ = std::move(rhs.keys_);
+                index_ = std::move(rhs.index_);
+                level_begin_ = std::move(rhs.level_begin_);
+                height_ = std::exchange(rhs.height_, 0);
+                layout_ = std::exchange(rhs.layout_, SortedLayout::sorted);
+                comp_ = rhs.comp_;
+            }
+            return *this;
+        }
+
+        ~SortedSet() noexcept = default;
+
+        SortedSet clone() const
+        {
+            Vector<K> keys(keys_.size(), uninitialized_tag);
+            std::copy(keys_.begin(), keys_.end(), keys.begin());
+            return SortedSet{ std::move(keys), sorted_unique_tag, layout_, comp_ };
+        }
+
+        size_t size() const noexcept { return keys_.size(); }
+        bool empty() const noexcept { return keys_.size() == 0; }
+        SortedLayout layout() const noexcept { return layout_; }
+
+        // the keys in sorted order, indexed by rank
+        const K* begin() const noexcept { return keys_.begin(); }
+        const K* end() const noexcept { return keys_.end(); }
+        const K& operator[](size_t rank) const { return keys_[rank]; }
+        VectorView<const K> keys() const noexcept { return { keys_.begin(), keys_.end() }; }
+
+        // rank of the first key not less than key, size() if there is none
+        size_t lower_bound(const K& key) const
+        {
+            size_t rank = 0;
+            lower_bound<1>(&key, &rank);
+            return rank;
+        }
+
+        // rank of key, size() if absent
+        size_t find(const K& key) const
+        {
+            const size_t rank = lower_bound(key);
+            return rank != size() && !comp_(key, keys_[rank]) ? rank : size();
+        }
+
+        bool contains(const K& key) const { return find(key) != size(); }
+
+        // out[i] = lower_bound(queries[i]): the queries go down the layout together in batches, with the next
+        // addresses of all of them prefetched before any is loaded, so that their cache misses overlap
+        void lower_bound(VectorView<const K> queries, VectorView<size_t> out) const
+        {
+            size_t first = 0;
+            for (; first + batch <= queries.size(); first += batch) {
+                lower_bound<batch>(queries.data() + first, out.data() + first);
+            }
+            for (; first < queries.size(); ++first) {
+                lower_bound<1>(queries.data() + first, out.data() + first);
+            }
+        }
+
+        // out[i] = find(queries[i])
+        void find(VectorView<const K> queries, VectorView<size_t> out) const
+        {
+            lower_bound(queries, out);
+            for (size_t i = 0; i < queries.size(); ++i) {
+                if (out[i] != size() && comp_(queries[i], keys_[out[i]])) {
+                    out[i] = size();
+                }
+            }
+        }
+
+    protected:
+        static constexpr size_t batch = 16;
+
+        // eytzinger: the descendants log2(prefetch_stride) levels down share a cache line
+        static constexpr size_t prefetch_stride = std::bit_floor(std::max<size_t>(64 / sizeof(K), 1));
+
+        void build(SortedLayout layout)
+        {
+            layout_ = layout;
+            const size_t n = keys_.size();
+            if (n == 0) {
+                return;
+            }
+            if (layout == SortedLayout::eytzinger) {
+                // a complete tree of 2^h - 1 nodes, in-order positions past the last key repeat it: searches for
+                // keys up to the largest one still end on a real key
+                height_ = static_cast<size_t>(std::bit_width(n));
+                const size_t nodes = (size_t{ 1 } << height_) - 1;
+                Vector<K> index(nodes + 1, uninitialized_tag);
+                index[0] = keys_[0];
+                for (size_t k = 1; k <= nodes; ++k) {
+                    const size_t rank = eytzinger_rank(k);
+                    index[k] = keys_[std::min(rank, n - 1)];
+                }
+                index_ = std::move(index);
+            }
+            else if (layout == SortedLayout::btree) {
+                // node counts from the leaves up: node_keys keys per leaf, node_keys + 1 children per inner node
+                size_t counts[64];
+                size_t levels = 0;
+                for (size_t count = (n + node_keys - 1) / node_keys; count > 1; ) {
+                    count = (count + node_keys) / (node_keys + 1);
+                    counts[levels++] = count;
+                }
+                height_ = levels;
+                level_begin_ = Vector<size_t>(levels, uninitialized_tag);
+                size_t total = 0;
+                for (size_t l = 0; l < levels; ++l) {
+                    level_begin_[l] = total;
+                    total += counts[levels - 1 - l] * node_keys;
+                }
+                // separator j of a node: the first key of its child j + 1, the largest key for missing children
+                Vector<K> index(total, uninitialized_tag);
+                size_t leaves_per_child = 1;
+                for (size_t l = levels; l-- > 0; ) {
+                    K* level = index.data() + level_begin_[l];
+                    for (size_t node = 0; node < counts[levels - 1 - l]; ++node) {
+                        for (size_t j = 0; j < node_keys; ++j) {
+                            const size_t first = (node * (node_keys + 1) + j + 1) * leaves_per_child * node_keys;
+                            level[node * node_keys + j] = keys_[std::min(first, n - 1)];
+                        }
+                    }
+                    leaves_per_child *= node_keys + 1;
+                }
+                index_ = std::move(index);
+            }
+        }
+
+        // in-order position of node k (1-based, breadth-first) of the complete tree of height_ levels
+        size_t eytzinger_rank(size_t k) const noexcept
+        {
+            const size_t depth = static_cast<size_t>(std::bit_width(k)) - 1;
+            return ((2 * (k - (size_t{ 1 } << depth)) + 1) << (height_ - 1 - depth)) - 1;
+        }
+
+        // Count queries in lock step: a constant count keeps a single search in registers and lets the compiler unroll
+        // the batches
+        template<size_t Count>
+        void lower_bound(const K* queries, size_t* out) const
+        {
+            const size_t n = size();
+            if (n == 0) {
+                std::fill(out, out + Count, 0);
+                return;
+            }
+            switch (layout_) {
+            case SortedLayout::sorted: {
+                // every search takes the same number of halvings: the batch moves in lock step
+                const K* base[Count];
+                std::fill(base, base + Count, keys_.begin());
+                for (size_t length = n; length > 1; ) {
+                    const size_t half = length / 2;
+                    for (size_t i = 0; i < Count; ++i) {
+                        detail::prefetch(base[i] + half / 2);
+                        detail::prefetch(base[i] + half + half / 2);
+                    }
+                    for (size_t i = 0; i < Count; ++i) {
+                        base[i] += static_cast<size_t>(comp_(base[i][half - 1], queries[i])) * half;
+                    }
+                    length -= half;
+                }
+                for (size_t i = 0; i < Count; ++i) {
+                    out[i] = static_cast<size_t>(base[i] - keys_.begin()) + comp_(*base[i], queries[i]);
+                }
+                break;
+            }
+            case SortedLayout::eytzinger: {
+                const K* index = index_.begin();
+                const size_t nodes = index_.size() - 1;
+                size_t k[Count];
+                std::fill(k, k + Count, 1);
+                for (size_t level = 0; level < height_; ++level) {
+                    for (size_t i = 0; i < Count; ++i) {
+                        detail::prefetch(index + std::min(k[i] * prefetch_stride, nodes));
+                    }
+                    for (size_t i = 0; i < Count; ++i) {
+                        k[i] = 2 * k[i] + comp_(index[k[i]], queries[i]);
+                    }
+                }
+                // the last left turn is the lower bound, none means every key is less
+                for (size_t i = 0; i < Count; ++i) {
+                    const size_t node = k[i] >> (std::countr_one(k[i]) + 1);
+                    out[i] = node == 0 ? n : eytzinger_rank(node);
+                }
+                break;
+            }
+            case SortedLayout::btree: {
+                // queries past the largest key search for it instead, the separators of missing children are never
+                // less than a searched key then
+                const K& largest = keys_[n - 1];
+                const K* searched[Count];
+                size_t node[Count];
+                for (size_t i = 0; i < Count; ++i) {
+                    searched[i] = comp_(largest, queries[i]) ? &largest : &queries[i];
+                    node[i] = 0;
+                }
+                for (size_t level = 0; level < height_; ++level) {
+                    const K* keys = index_.begin() + level_begin_[level];
+                    for (size_t i = 0; i < Count; ++i) {
+                        detail::prefetch(keys + node[i] * node_keys);
+                    }
+                    for (size_t i = 0; i < Count; ++i) {
+                        const K* separators = keys + node[i] * node_keys;
+                        size_t child = 0;
+                        for (size_t j = 0; j < node_keys; ++j) {
+                            child += comp_(separators[j], *searched[i]);
+                        }
+                        node[i] = node[i] * (node_keys + 1) + child;
+                    }
+                }
+                for (size_t i = 0; i < Count; ++i) {
+                    detail::prefetch(keys_.begin() + node[i] * node_keys);
+                }
+                for (size_t i = 0; i < Count; ++i) {
+                    const size_t first = node[i] * node_keys;
+                    const size_t last = std::min(first + node_keys, n);
+                    size_t rank = first;
+                    for (size_t j = first; j < last; ++j) {
+                        rank += comp_(keys_[j], *searched[i]);
+                    }
+                    out[i] = searched[i] != &queries[i] ? n : rank;
+                }
+                break;
+            }
+            }
+        }
+    };
+
+    // Immutable map on a SortedSet of its keys: the values are stored by rank, in the order of the sorted keys.
+    template<typename K, typename V, typename Compare = std::less<K>>
+    struct SortedMap
+    {
+        SortedSet<K, Compare> keys_;
+        Vector<const V> values_;
+
+        SortedMap() noexcept = default;
+
+        // values[i] belongs to keys[i]; of equivalent keys the first one wins
+        SortedMap(Vector<K>&& keys, Vector<V>&& values, SortedLayout layout = SortedLayout::sorted, Compare comp = Compare{})
+        {
+            check_sizes(keys, values);
+            const size_t n = keys.size();
+            Vector<size_t> order(n, uninitialized_tag);
+            for (size_t i = 0; i < n; ++i) {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return comp(keys[a], keys[b]); });
+            const size_t* last = std::unique(order.begin(), order.end(), [&](size_t a, size_t b) { return !comp(keys[a], keys[b]); });
+            const size_t unique = static_cast<size_t>(last - order.begin());
+            Vector<K> sorted_keys(unique, uninitialized_tag);
+            Vector<V> sorted_values(unique, uninitialized_tag);
+            for (size_t i = 0; i < unique; ++i) {
+                sorted_keys[i] = std::move(keys[order[i]]);
+                sorted_values[i] = std::move(values[order[i]]);
+            }
+            keys = Vector<K>{};
+            values = Vector<V>{};
+            keys_ = SortedSet<K, Compare>{ std::move(sorted_keys), sorted_unique_tag, layout, std::move(comp) };
+            values_ = std::move(sorted_values);
+        }
+
+        SortedMap(Vector<K>&& keys, Vector<V>&& values, sorted_unique_tag_t, SortedLayout layout = SortedLayout::sorted, Compare comp = Compare{})
+        {
+            check_sizes(keys, values);
+            keys_ = SortedSet<K, Compare>{ std::move(keys), sorted_unique_tag, layout, std::move(comp) };
+            values_ = std::move(values);
+        }
+
+        // non-copyable, see clone()
+        SortedMap(const SortedMap&) = delete;
+        SortedMap& operator = (const SortedMap&) = delete;
+
+        SortedMap(SortedMap&&) noexcept = default;
+        SortedMap& operator = (SortedMap&&) & noexcept = default;
+
+        ~SortedMap() noexcept = default;
+
+        SortedMap clone() const
+        {
+            SortedMap copy;
+            copy.keys_ = keys_.clone();
+            Vector<V> values(values_.size(), uninitialized_tag);
+            std::copy(values_.begin(), values_.end(), values.begin());
+            copy.values_ = std::move(values);
+            return copy;
+        }
+
+        size_t size() const noexcept { return keys_.size(); }
+        bool empty() const noexcept { return keys_.empty(); }
+        SortedLayout layout() const noexcept { return keys_.layout(); }
+
+        // indexed by rank
+        VectorView<const K> keys() const noexcept { return keys_.keys(); }
+        VectorView<const V> values() const noexcept { return { values_.begin(), values_.end() }; }
+
+        const V* find(const K& key) const
+        {
+            const size_t rank = keys_.find(key);
+            return rank != size() ? &values_[rank] : nullptr;
+        }
+
+        bool contains(const K& key) const { return keys_.contains(key); }
+
+        size_t lower_bound(const K& key) const { return keys_.lower_bound(key); }
+
+        // out[i] = find(queries[i]), searched in batches like SortedSet::lower_bound
+        void find(VectorView<const K> queries, VectorView<const V*> out) const
+        {
+            constexpr size_t batch = 16;
+            size_t ranks[batch];
+            for (size_t first = 0; first < queries.size(); first += batch) {
+                const size_t count = std::min(batch, queries.size() - first);
+                keys_.find(VectorView<const K>{ queries.data() + first, queries.data() + first + count }, VectorView<size_t>{ ranks, ranks + count });
+                for (size_t i = 0; i < count; ++i) {
+                    out[first + i] = ranks[i] != size() ? &values_[ranks[i]] : nullptr;
+                }
+            }
+        }
+
+    private:
+        static void check_sizes(const Vector<K>& keys, const Vector<V>& values)
+        {
+            if (keys.size() != values.size()) {
+                throw std::invalid_argument("SortedMap: keys and values have different sizes");
+            }
+        }
+    };
+
+    template<typename K, typename Compare>
+    inline constexpr bool is_owning_container_v<SortedSet<K, Compare>> = true;
+
+    template<typename K, typename V, typename Compare>
+    inline constexpr bool is_owning_container_v<SortedMap<K, V, Compare>> = true;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <Containers2/containers2.hpp>
+#include <Containers2/parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace containers2 {
+
+    // Jagged array in compressed sparse row layout: the elements of all the rows back to back in one Vector<T>, and
+    // size() + 1 offsets, row r being values_[offsets_[r], offsets_[r + 1]). Rows are VectorViews; the whole array
+    // costs two allocations instead of one per row, and scanning every row reads memory sequentially.
+    // Rows are appended at the end, either copied or filled in place, and the last row can grow one element at a time;
+    // like Vector's, these appends grow geometrically and invalidate the row views. Grouping (row, value) pairs uses a
+    // counting sort: one pass counts the rows, one pass scatters the values.
+    // Move-only like Vector: clone() is the explicit deep copy. VectorOfVectors<const T> is built by moving a
+    // VectorOfVectors<T>, once its rows are final.
+    template<typename T>
+    struct VectorOfVectors
+    {
+        Vector<T> values_;
+        Vector<size_t> offsets_; // empty when there are no rows
+
+        VectorOfVectors() noexcept = default;
+
+        // adopts the buffers: offsets must start at 0, never decrease and end at values.size()
+        VectorOfVectors(Vector<T>&& values, Vector<size_t>&& offsets)
+        {
+            if (offsets.size() == 0 ? values.size() != 0 : offsets[0] != 0 || offsets[offsets.size() - 1] != values.size() || !std::is_sorted(offsets.begin(), offsets.end())) {
+                throw std::invalid_argument("VectorOfVectors: offsets do not partition the values");
+            }
+            values_ = std::move(values);
+            offsets_ = std::move(offsets);
+        }
+
+        // groups values[i] into row rows_of[i], keeping their order within each row; every row index must be below rows
+        VectorOfVectors(size_t rows, VectorView<const size_t> rows_of, VectorView<const std::remove_const_t<T>> values)
+        {
+            if (rows_of.size() != values.size()) {
+                throw std::invalid_argument("VectorOfVectors: as many row indices as values are needed");
+            }
+            group(rows, values.size(), [&](size_t i) { return rows_of[i]; }, [&](size_t i) -> const auto& { return values[i]; });
+        }
+
+        // same grouping, from (row, value) pairs
+        VectorOfVectors(size_t rows, VectorView<const std::pair<size_t, std::remove_const_t<T>>> pairs)
+        {
+            group(rows, pairs.size(), [&](size_t i) { return pairs[i].first; }, [&](size_t i) -> const auto& { return pairs[i].second; });
+        }
+
+        // non-copyable, see clone()
+        VectorOfVectors(const VectorOfVectors&) = delete;
+        VectorOfVectors& operator = (const VectorOfVectors&) = delete;
+
+        VectorOfVectors(VectorOfVectors&&) noexcept = default;
+        VectorOfVectors& operator = (VectorOfVectors&&) & noexcept = default;
+
+        VectorOfVectors(VectorOfVectors<std::remove_const_t<T>>&& rhs) noexcept requires(std::is_const_v<T>) :
+            values_{ std::move(rhs.values_) }, offsets_{ std::move(rhs.offsets_) } {}
+
+        ~VectorOfVectors() noexcept = default;
+
+        VectorOfVectors clone() const
+        {
+            VectorOfVectors copy;
+            copy.values_ = values_.clone();
+            copy.offsets_ = offsets_.clone();
+            return copy;
+        }
+
+        // rows
+        size_t size() const noexcept { return offsets_.size() == 0 ? 0 : offsets_.size() - 1; }
+        bool empty() const noexcept { return size() == 0; }
+
+        // elements of all the rows
+        size_t element_count() const noexcept { return values_.size(); }
+
+        VectorView<T> operator[](size_t row) const { return { values_.data() + offsets_[row], values_.data() + offsets_[row + 1] }; }
+        size_t row_size(size_t row) const { return offsets_[row + 1] - offsets_[row]; }
+
+        // the rows concatenated, and where each starts (size() + 1 entries, or none)
+        VectorView<T> values() const noexcept { return values_; }
+        VectorView<const size_t> offsets() const noexcept { return offsets_; }
+
+        void reserve(size_t rows, size_t elements) requires(!std::is_const_v<T>)
+        {
+            offsets_.reserve(rows + 1);
+            values_.reserve(elements);
+        }
+
+        void clear() noexcept requires(!std::is_const_v<T>)
+        {
+            offsets_.resize(0, non_preserving_uninitialized_tag);
+            values_.resize(0, non_preserving_uninitialized_tag);
+        }
+
+        // appends a copy of row, which must not be a row of this container
+        void push_back(VectorView<const T> row) requires(!std::is_const_v<T>)
+        {
+            const VectorView<T> added = push_back(row.size(), uninitialized_tag);
+            std::copy(row.begin(), row.end(), added.begin());
+        }
+
+        // appends a row of n elements and returns it to be filled in place
+        VectorView<T> push_back(size_t n, uninitialized_tag_t) requires(!std::is_const_v<T>)
+        {
+            if (offsets_.size() == 0) {
+                offsets_.resize(1, size_t{ 0 });
+            }
+            const size_t begin = values_.size();
+            values_.resize(begin + n);
+            offsets_.resize(offsets_.size() + 1, begin + n);
+            return { values_.data() + begin, values_.data() + begin + n };
+        }
+
+        // appends value to the last row, std::out_of_range without rows
+        void push_back_to_last(T value) requires(!std::is_const_v<T>)
+        {
+            if (size() == 0) {
+                throw std::out_of_range("VectorOfVectors: push_back_to_last without rows");
+            }
+            values_.resize(values_.size() + 1);
+            values_[values_.size() - 1] = std::move(value);
+            ++offsets_[offsets_.size() - 1];
+        }
+
+    private:
+        template<typename Row, typename Value>
+        void group(size_t rows, size_t n, Row row_of, Value value)
+        {
+            // counts in offsets_[r + 1], then their prefix sums
+            Vector<size_t> offsets(rows + 1, size_t{ 0 });
+            for (size_t i = 0; i < n; ++i) {
+                const size_t r = row_of(i);
+                if (r >= rows) {
+                    throw std::out_of_range("VectorOfVectors: row index out of range");
+                }
+                ++offsets[r + 1];
+            }
+            for (size_t r = 0; r < rows; ++r) {
+                offsets[r + 1] += offsets[r];
+            }
+            Vector<size_t> next = offsets.clone();
+            Vector<std::remove_const_t<T>> values(n, uninitialized_tag);
+            for (size_t i = 0; i < n; ++i) {
+                values[next[row_of(i)]++] = value(i);
+            }
+            values_ = std::move(values);
+            offsets_ = std::move(offsets);
+        }
+    };
+
+    namespace parallel {
+
+        // f(r, rows[r]) for every row; chunks of consecutive rows hold about the same number of elements (an empty row
+        // counting as one), so that a few long rows do not leave the other threads idle. Rows are never split.
+        template<typename T, typename F>
+        void for_each_row(const VectorOfVectors<T>& rows, F f, ThreadPool& pool = ThreadPool::default_pool())
+        {
+            const size_t n = rows.size();
+            const VectorView<const size_t> offsets = rows.offsets();
+            const size_t work = rows.element_count() + n;
+            const size_t chunks = detail::chunk_count(work, pool);
+            // the first row whose work before it reaches the share of chunk i; offsets[r] + r strictly increases
+            const auto boundary = [&](size_t i) {
+                const size_t target = work / chunks * i + work % chunks * i / chunks;
+                size_t low = 0;
+                size_t high = n;
+                while (low < high) {
+                    const size_t middle = low + (high - low) / 2;
+                    if (offsets[middle] + middle < target) {
+                        low = middle + 1;
+                    }
+                    else {
+                        high = middle;
+                    }
+                }
+                return low;
+            };
+            pool.run(chunks, [&](size_t i) {
+                const size_t end = boundary(i + 1);
+                for (size_t r = boundary(i); r < end; ++r) {
+                    f(r, rows[r]);
+                }
+            });
+        }
+    }
+}
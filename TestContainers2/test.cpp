@@ -3,6 +3,10 @@
 #include <type_traits>
 #include <Containers2/containers2.hpp>
 #include <ranges>
+#include <memory_resource>
+#include <algorithm>
+#include <cstdint>
+#include <string>
 
 using namespace containers2;
 
@@ -29,6 +33,14 @@ static_assert(std::is_trivially_constructible_v<VectorView<int>, const VectorVie
 static_assert(!std::is_constructible_v<VectorView<int>, const Vector<const int>&>);
 static_assert(std::is_trivially_constructible_v<VectorView<int>, const Vector<int>&>);
 
+// views stay plain pointer pairs: the memory resource lives only in the owning Vector
+static_assert(std::is_trivially_copyable_v<VectorView<const int>>);
+static_assert(std::is_trivially_copyable_v<VectorView<int>>);
+static_assert(sizeof(VectorView<int>) == 2 * sizeof(int*));
+
+// instrumentation is opt-in (test_instrumentation.cpp is built separately with it): the default build has none
+static_assert(!instrumentation::enabled);
+
 // Vector<T> copy constructors: cannot assign from anything
 static_assert(!std::is_assignable_v<Vector<const int>&, const VectorView<const int>&>);
 static_assert(!std::is_assignable_v<Vector<const int>&, const VectorView<int>&>);
@@ -250,6 +262,68 @@ TEST(Containers2, VectorVectorCopy) {
     ASSERT_EQ(vector_source[2], vector_target[2]);
 }
 
+TEST(Containers2, VectorClone) {
+    const Vector<int> source{ 5, 7, 12 };
+    const Vector<int> copy = source.clone();
+    ASSERT_NE(copy.data(), source.data());
+    ASSERT_EQ(copy.size(), 3);
+    ASSERT_EQ(copy.capacity(), 3);
+    ASSERT_TRUE(std::equal(copy.begin(), copy.end(), source.begin(), source.end()));
+    ASSERT_EQ(copy.resource(), source.resource());
+
+    // const elements, elements that are not trivially copyable, and the memory resource
+    const Vector<const int> constant{ Vector<int>{ 1, 2 } };
+    const Vector<const int> constant_copy = constant.clone();
+    ASSERT_EQ(constant_copy[1], 2);
+    const Vector<std::string> strings{ std::string{ "a" }, std::string{ "string long enough to be allocated on the heap" } };
+    const Vector<std::string> strings_copy = strings.clone();
+    ASSERT_EQ(strings_copy[1], strings[1]);
+    ASSERT_NE(strings_copy[1].data(), strings[1].data());
+    const Vector<int> aligned(100, 3, initialized_tag, aligned_memory_resource<cache_line_size>());
+    const Vector<int> aligned_copy = aligned.clone(CopyMode::streaming);
+    ASSERT_EQ(aligned_copy.resource(), aligned_memory_resource<cache_line_size>());
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned_copy.data()) % cache_line_size, 0);
+    ASSERT_TRUE(std::all_of(aligned_copy.begin(), aligned_copy.end(), [](int x) { return x == 3; }));
+    ASSERT_EQ(Vector<int>{}.clone().size(), 0);
+}
+
+TEST(Containers2, VectorCopyFrom) {
+    const Vector<int> source{ 5, 7, 12, 24 };
+    Vector<int> target{ 1, 2, 3, 4, 5, 6 };
+    const int* buffer = target.data();
+    target.copy_from(source);
+    ASSERT_EQ(target.data(), buffer); // the capacity is reused
+    ASSERT_EQ(target.size(), 4);
+    ASSERT_TRUE(std::equal(target.begin(), target.end(), source.begin(), source.end()));
+    target.copy_from(VectorView<const int>{ source.begin() + 1, source.begin() + 3 }, CopyMode::cached);
+    ASSERT_EQ(target.size(), 2);
+    ASSERT_EQ(target[0], 7);
+    ASSERT_EQ(target[1], 12);
+    const Vector<int> longer(1000, 9);
+    target.copy_from(longer);
+    ASSERT_EQ(target.size(), 1000);
+    ASSERT_EQ(target[999], 9);
+}
+
+// streaming stores for every head and tail around the 16-byte alignment and the 64-byte loop
+TEST(Containers2, CopyElementsStreaming) {
+    Vector<std::uint8_t> source(600, uninitialized_tag);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+    for (size_t offset = 0; offset < 17; ++offset) {
+        for (size_t n : { 0, 1, 15, 16, 63, 64, 65, 127, 128, 300, 583 }) {
+            for (CopyMode mode : { CopyMode::automatic, CopyMode::cached, CopyMode::streaming }) {
+                Vector<std::uint8_t> destination(600, 0, initialized_tag);
+                copy_elements<std::uint8_t>(VectorView<const std::uint8_t>{ source.begin() + 3, source.begin() + 3 + n }, VectorView<std::uint8_t>{ destination.begin() + offset, destination.begin() + offset + n }, mode);
+                ASSERT_TRUE(std::equal(destination.begin() + offset, destination.begin() + offset + n, source.begin() + 3)) << "offset " << offset << " size " << n;
+                ASSERT_TRUE(std::all_of(destination.begin(), destination.begin() + offset, [](std::uint8_t x) { return x == 0; }));
+                ASSERT_TRUE(std::all_of(destination.begin() + offset + n, destination.end(), [](std::uint8_t x) { return x == 0; }));
+            }
+        }
+    }
+}
+
 TEST(Containers2, VectorResize) {
     Vector<int> vector{ 5, 7, 12 };
     vector.resize(5, 24); // grow initialized
@@ -286,6 +360,103 @@ TEST(Containers2, VectorResize) {
     ASSERT_EQ(vector.size(), 76);
 }
 
+TEST(Containers2, VectorResizeCapacity) {
+    Vector<int> vector{ 5, 7, 12, 24, 24, 36 };
+    ASSERT_EQ(vector.capacity(), 6);
+    const int* buffer = vector.data();
+
+    vector.resize(4); // shrink never reallocates
+    ASSERT_EQ(vector.data(), buffer);
+    ASSERT_EQ(vector.size(), 4);
+    ASSERT_EQ(vector.capacity(), 6);
+
+    vector.resize(6, 48); // regrow within capacity, initializing only the new elements
+    ASSERT_EQ(vector.data(), buffer);
+    ASSERT_EQ(vector[3], 24);
+    ASSERT_EQ(vector[4], 48);
+    ASSERT_EQ(vector[5], 48);
+
+    vector.resize(7); // geometric growth
+    ASSERT_EQ(vector.capacity(), 12);
+    ASSERT_EQ(vector[0], 5);
+    ASSERT_EQ(vector[5], 48);
+
+    vector.resize(3, non_preserving_uninitialized_tag); // non preserving shrink reuses the buffer as well
+    buffer = vector.data();
+    vector.resize(10, 1, non_preserving_initialized_tag);
+    ASSERT_EQ(vector.data(), buffer);
+    ASSERT_EQ(vector.capacity(), 12);
+    ASSERT_EQ(vector[9], 1);
+
+    vector.resize(2);
+    vector.shrink_to_fit();
+    ASSERT_EQ(vector.capacity(), 2);
+    ASSERT_EQ(vector[0], 1);
+    ASSERT_EQ(vector[1], 1);
+
+    vector.reserve(100);
+    ASSERT_EQ(vector.capacity(), 100);
+    ASSERT_EQ(vector.size(), 2);
+    ASSERT_EQ(vector[1], 1);
+
+    vector.resize(0);
+    vector.shrink_to_fit();
+    ASSERT_EQ(vector.capacity(), 0);
+}
+
+TEST(Containers2, VectorResizeCapacityNonTrivial) {
+    Vector<std::string> vector{ 2, std::string{ "a string long enough not to fit in the small string buffer" } };
+    ASSERT_EQ(vector.resource(), nullptr);
+    vector.resize(3, std::string{ "x" });
+    ASSERT_EQ(vector.capacity(), 4);
+    ASSERT_EQ(vector[0], vector[1]);
+    ASSERT_EQ(vector[2], "x");
+    vector.resize(1);
+    vector.shrink_to_fit();
+    ASSERT_EQ(vector.capacity(), 1);
+    ASSERT_EQ(vector[0], "a string long enough not to fit in the small string buffer");
+}
+
+// counts reallocations to check that growth of trivially copyable elements never goes through allocate+copy
+struct CountingReallocatingMemoryResource : ReallocatingMemoryResource
+{
+    size_t allocations = 0;
+    size_t reallocations = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return malloc_memory_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        malloc_memory_resource()->deallocate(p, bytes, alignment);
+    }
+
+    void* do_reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t alignment) override
+    {
+        ++reallocations;
+        return static_cast<ReallocatingMemoryResource*>(malloc_memory_resource())->reallocate(p, old_bytes, new_bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST(Containers2, VectorResizeRealloc) {
+    CountingReallocatingMemoryResource resource;
+    Vector<int> vector{ 4, 3, initialized_tag, &resource };
+    vector.resize(1000, 5);
+    vector.resize(100000);
+    vector.resize(50000);
+    vector.shrink_to_fit();
+    ASSERT_EQ(resource.allocations, 1);
+    ASSERT_EQ(resource.reallocations, 3);
+    ASSERT_EQ(vector[3], 3);
+    ASSERT_EQ(vector[999], 5);
+    ASSERT_EQ(vector.capacity(), 50000);
+}
+
 TEST(Containers2, VectorUninitializedConstruction) {
     const Vector<int> vector_uninitialized{ 42, uninitialized_tag };
     ASSERT_EQ(vector_uninitialized.size(), 42);
@@ -319,6 +490,126 @@ TEST(Containers2, VectorMoveAssignment) {
     ASSERT_EQ(vector_moved_to_const[1], 42);
 }
 
+// upstream resource that keeps track of what is still outstanding
+struct CountingMemoryResource : std::pmr::memory_resource
+{
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytes_live = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        bytes_live += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        ++deallocations;
+        bytes_live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST(Containers2, VectorMemoryResourceConstruction) {
+    CountingMemoryResource resource;
+    {
+        const Vector<int> vector_uninitialized{ 42, uninitialized_tag, &resource };
+        ASSERT_EQ(vector_uninitialized.size(), 42);
+        ASSERT_EQ(vector_uninitialized.resource(), &resource);
+
+        const Vector<int> vector_initialized{ 2, 42, initialized_tag, &resource };
+        ASSERT_EQ(vector_initialized[0], 42);
+        ASSERT_EQ(vector_initialized[1], 42);
+
+        const Vector<int> vector_list{ { 5, 7, 12 }, &resource };
+        ASSERT_EQ(vector_list.size(), 3);
+        ASSERT_EQ(vector_list[2], 12);
+
+        ASSERT_EQ(resource.allocations, 3);
+        ASSERT_EQ(resource.bytes_live, (42 + 2 + 3) * sizeof(int));
+    }
+    ASSERT_EQ(resource.deallocations, 3);
+    ASSERT_EQ(resource.bytes_live, 0);
+}
+
+TEST(Containers2, VectorMemoryResourceResize) {
+    CountingMemoryResource resource;
+    {
+        Vector<int> vector{ { 5, 7, 12 }, &resource };
+        vector.resize(5, 24);
+        ASSERT_EQ(vector.size(), 5);
+        ASSERT_EQ(vector[2], 12);
+        ASSERT_EQ(vector[4], 24);
+        vector.resize(2);
+        ASSERT_EQ(vector[1], 7);
+        vector.resize(4, 87, non_preserving_initialized_tag);
+        ASSERT_EQ(vector[3], 87);
+        vector.resize(76, non_preserving_uninitialized_tag);
+        ASSERT_EQ(vector.size(), 76);
+        ASSERT_EQ(vector.resource(), &resource);
+        ASSERT_EQ(resource.bytes_live, 76 * sizeof(int));
+    }
+    ASSERT_EQ(resource.allocations, resource.deallocations);
+    ASSERT_EQ(resource.bytes_live, 0);
+}
+
+TEST(Containers2, VectorMemoryResourceMove) {
+    CountingMemoryResource resource_a;
+    CountingMemoryResource resource_b;
+    {
+        Vector<int> vector_a{ 2, 42, initialized_tag, &resource_a };
+        Vector<int> vector_b{ 3, 24, initialized_tag, &resource_b };
+        const int* buffer_a = vector_a.data();
+
+        // the moved-to Vector releases its own buffer to its own resource and adopts the other one
+        vector_b = std::move(vector_a);
+        ASSERT_EQ(vector_b.data(), buffer_a);
+        ASSERT_EQ(vector_b.resource(), &resource_a);
+        ASSERT_EQ(vector_a.data(), nullptr);
+        ASSERT_EQ(resource_b.bytes_live, 0);
+        ASSERT_EQ(resource_a.bytes_live, 2 * sizeof(int));
+
+        Vector<const int> vector_const{ std::move(vector_b) };
+        ASSERT_EQ(vector_const.data(), buffer_a);
+        ASSERT_EQ(vector_const.resource(), &resource_a);
+        ASSERT_EQ(vector_const[1], 42);
+
+        // a default-allocated Vector can adopt a resource-allocated buffer and vice versa
+        Vector<int> vector_default{ 4, 1, initialized_tag };
+        Vector<int> vector_c{ 5, 2, initialized_tag, &resource_b };
+        vector_c = std::move(vector_default);
+        ASSERT_EQ(vector_c.resource(), default_memory_resource<int>());
+        ASSERT_EQ(vector_c.size(), 4);
+        ASSERT_EQ(resource_b.bytes_live, 0);
+    }
+    ASSERT_EQ(resource_a.bytes_live, 0);
+    ASSERT_EQ(resource_b.bytes_live, 0);
+    ASSERT_EQ(resource_a.allocations, resource_a.deallocations);
+    ASSERT_EQ(resource_b.allocations, resource_b.deallocations);
+}
+
+TEST(Containers2, VectorMemoryResourceArena) {
+    std::array<std::byte, 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena{ buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+    {
+        Vector<int> vector{ 16, 3, initialized_tag, &arena };
+        vector.resize(32, 5);
+        ASSERT_EQ(vector[15], 3);
+        ASSERT_EQ(vector[31], 5);
+        ASSERT_GE(static_cast<const void*>(vector.data()), static_cast<const void*>(buffer.data()));
+        ASSERT_LT(static_cast<const void*>(vector.data()), static_cast<const void*>(buffer.data() + buffer.size()));
+    }
+
+    Vector<std::string> strings{ 3, std::string{ "a string long enough not to fit in the small string buffer" }, initialized_tag, thread_local_memory_resource() };
+    strings.resize(4, std::string{ "x" });
+    ASSERT_EQ(strings[0], strings[2]);
+    ASSERT_EQ(strings[3], "x");
+}
+
 TEST(Containers2, VectorViewCopyConstruction) {
     int array[]{ 5, 7, 12 };
 
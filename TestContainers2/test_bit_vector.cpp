@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <Containers2/bit_vector.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace containers2;
+
+// BitVector: same copy/move rules as Vector
+static_assert(!std::is_copy_constructible_v<BitVector<>>);
+static_assert(!std::is_copy_assignable_v<BitVector<>>);
+static_assert(std::is_nothrow_move_constructible_v<BitVector<>>);
+static_assert(std::is_nothrow_move_assignable_v<BitVector<>>);
+static_assert(std::is_constructible_v<BitVector<const bool>, BitVector<bool>&&>);
+static_assert(!std::is_constructible_v<BitVector<bool>, BitVector<const bool>&&>);
+
+// views: trivially copyable, mutable to const only, never from a temporary container
+static_assert(std::is_trivially_copyable_v<BitVectorView<const bool>>);
+static_assert(std::is_trivially_copyable_v<BitVectorView<bool>>);
+static_assert(sizeof(BitVectorView<bool>) == 2 * sizeof(void*));
+static_assert(std::is_constructible_v<BitVectorView<const bool>, const BitVectorView<bool>&>);
+static_assert(!std::is_constructible_v<BitVectorView<bool>, const BitVectorView<const bool>&>);
+static_assert(std::is_constructible_v<BitVectorView<const bool>, const BitVector<bool>&>);
+static_assert(std::is_constructible_v<BitVectorView<const bool>, const BitVector<const bool>&>);
+static_assert(!std::is_constructible_v<BitVectorView<bool>, const BitVector<const bool>&>);
+static_assert(!std::is_constructible_v<BitVectorView<const bool>, BitVector<bool>&&>);
+static_assert(!std::is_constructible_v<BitVectorView<bool>, BitVector<bool>&&>);
+
+namespace {
+    constexpr simd::Isa isas[]{ simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512 };
+
+    BitVector<> random_bits(size_t s, double density, unsigned seed)
+    {
+        std::mt19937 random{ seed };
+        std::bernoulli_distribution bit{ density };
+        BitVector<> bits(s);
+        for (size_t i = 0; i < s; ++i) {
+            bits.set(i, bit(random));
+        }
+        return bits;
+    }
+}
+
+TEST(Containers2, BitVectorAccess) {
+    BitVector<> bits(130, false);
+    ASSERT_EQ(bits.size(), 130);
+    ASSERT_EQ(bits.word_count(), 3);
+    ASSERT_EQ(popcount(bits), 0);
+
+    bits.set(0);
+    bits.set(64);
+    bits.set(129);
+    bits.flip(3);
+    bits.flip(64);
+    ASSERT_TRUE(bits[0]);
+    ASSERT_TRUE(bits.test(3));
+    ASSERT_FALSE(bits[64]);
+    ASSERT_TRUE(bits[129]);
+    ASSERT_EQ(bits.words()[0], 0b1001);
+    ASSERT_EQ(bits.words()[2], 0b10);
+    bits.reset(0);
+    ASSERT_FALSE(bits[0]);
+
+    // bits past size() stay clear
+    bits.fill(true);
+    ASSERT_EQ(bits.words()[2], 0b11);
+    ASSERT_EQ(popcount(bits), 130);
+
+    const BitVectorView<const bool> view = bits;
+    ASSERT_EQ(view.data(), bits.data());
+    ASSERT_EQ(view.size(), 130);
+    ASSERT_TRUE(view[100]);
+}
+
+TEST(Containers2, BitVectorResize) {
+    BitVector<> bits;
+    ASSERT_TRUE(bits.empty());
+    for (size_t i = 0; i < 200; ++i) {
+        bits.push_back(i % 3 == 0);
+    }
+    ASSERT_EQ(bits.size(), 200);
+    ASSERT_EQ(popcount(bits), 67);
+    ASSERT_GE(bits.capacity(), 200);
+
+    bits.resize(70); // clears the tail of the new last word
+    ASSERT_EQ(bits.words()[1], 0b10'0100); // 66 and 69
+    bits.resize(140, true); // sets the rest of the old last word as well
+    ASSERT_EQ(popcount(bits), 24 + 70);
+    ASSERT_TRUE(bits[70]);
+    ASSERT_TRUE(bits[139]);
+    ASSERT_FALSE(bits[68]);
+    ASSERT_TRUE(bits[69]);
+
+    bits.shrink_to_fit();
+    ASSERT_EQ(bits.capacity(), 192);
+    bits.clear();
+    ASSERT_EQ(bits.size(), 0);
+
+    BitVector<> moved{ random_bits(1000, 0.5, 1) };
+    const size_t ones = popcount(moved);
+    const BitWord* words = moved.data();
+    const BitVector<const bool> frozen{ std::move(moved) };
+    ASSERT_EQ(moved.size(), 0);
+    ASSERT_EQ(frozen.data(), words);
+    ASSERT_EQ(popcount(frozen), ones);
+}
+
+TEST(Containers2, BitVectorBitwise) {
+    for (size_t s : { 0, 1, 63, 64, 65, 1000, 4099 }) {
+        const BitVector<> a = random_bits(s, 0.5, 2);
+        const BitVector<> b = random_bits(s, 0.3, 3);
+        for (simd::Isa isa : isas) {
+            BitVector<> out(s);
+            bit_and(out, a, b, isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(out[i], a[i] && b[i]);
+            }
+            bit_or(out, a, b, isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(out[i], a[i] || b[i]);
+            }
+            bit_xor(out, a, b, isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(out[i], a[i] != b[i]);
+            }
+            bit_andnot(out, a, b, isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(out[i], a[i] && !b[i]);
+            }
+
+            // in place
+            BitVector<> c = random_bits(s, 0.5, 2);
+            bit_and(c, c, b, isa);
+            bit_and(out, a, b, isa);
+            ASSERT_TRUE(std::equal(c.words().begin(), c.words().end(), out.words().begin()));
+        }
+    }
+}
+
+TEST(Containers2, BitVectorPopcount) {
+    for (size_t s : { 0, 1, 100, 2047, 2048, 100000 }) {
+        for (double density : { 0.0, 0.01, 0.5, 1.0 }) {
+            const BitVector<> bits = random_bits(s, density, 4);
+            size_t expected = 0;
+            for (size_t i = 0; i < s; ++i) {
+                expected += bits[i];
+            }
+            for (simd::Isa isa : isas) {
+                ASSERT_EQ(popcount(bits, isa), expected);
+            }
+        }
+    }
+}
+
+TEST(Containers2, BitVectorFindSet) {
+    BitVector<> bits(300, false);
+    ASSERT_EQ(find_first_set(bits), 300);
+    const std::vector<size_t> set{ 5, 63, 64, 200, 299 };
+    for (size_t i : set) {
+        bits.set(i);
+    }
+    ASSERT_EQ(find_first_set(bits), 5);
+    ASSERT_EQ(find_next_set(bits, 5), 5);
+    ASSERT_EQ(find_next_set(bits, 6), 63);
+    ASSERT_EQ(find_next_set(bits, 65), 200);
+    ASSERT_EQ(find_next_set(bits, 300), 300);
+
+    std::vector<size_t> seen;
+    for (size_t i = find_first_set(bits); i != bits.size(); i = find_next_set(bits, i + 1)) {
+        seen.push_back(i);
+    }
+    ASSERT_EQ(seen, set);
+    seen.clear();
+    for_each_set(bits, [&](size_t i) { seen.push_back(i); });
+    ASSERT_EQ(seen, set);
+}
+
+TEST(Containers2, BitVectorRankSelect) {
+    for (size_t s : { 0, 1, 511, 512, 513, 100000 }) {
+        for (double density : { 0.001, 0.1, 0.9 }) {
+            const BitVector<> bits = random_bits(s, density, 5);
+            const RankSelect index{ bits };
+            ASSERT_EQ(index.ones(), popcount(bits));
+            size_t rank = 0;
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(index.rank(i), rank);
+                ASSERT_EQ(index.rank0(i), i - rank);
+                if (bits[i]) {
+                    ASSERT_EQ(index.select(rank), i);
+                    ++rank;
+                }
+            }
+            ASSERT_EQ(index.rank(s), rank);
+        }
+    }
+
+    // sparse bits far apart: selects that cross many empty blocks
+    BitVector<> sparse(1 << 20, false);
+    for (size_t i = 0; i < sparse.size(); i += 70001) {
+        sparse.set(i);
+    }
+    const RankSelect index{ sparse };
+    for (size_t k = 0; k < index.ones(); ++k) {
+        ASSERT_EQ(index.select(k), k * 70001);
+    }
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <Containers2/chunked_vector.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace containers2;
+
+// ChunkedVector: same copy/move rules as Vector
+static_assert(!std::is_copy_constructible_v<ChunkedVector<int>>);
+static_assert(!std::is_copy_assignable_v<ChunkedVector<int>>);
+static_assert(std::is_nothrow_move_constructible_v<ChunkedVector<int>>);
+static_assert(std::is_nothrow_move_assignable_v<ChunkedVector<int>>);
+
+TEST(Containers2, ChunkedVectorAppend) {
+    ChunkedVector<int> v{ 3 };
+    ASSERT_EQ(v.first_chunk(), 4);
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(v.chunk_count(), 0);
+
+    ASSERT_EQ(v.push_back(0), 0);
+    const int* first = &v[0];
+    // chunks of 4, 4, 8, 16: index 5 is in chunk 1, index 8 starts chunk 2
+    ASSERT_EQ(v.grow_by(4, 1), 1);
+    const int values[]{ 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    ASSERT_EQ(v.grow_by(VectorView<const int>{ std::begin(values), std::end(values) }), 5);
+    ASSERT_EQ(v.size(), 15);
+    ASSERT_EQ(v.chunk_count(), 3);
+    ASSERT_EQ(v[4], 1);
+    ASSERT_EQ(v[5], 2);
+    ASSERT_EQ(v[14], 11);
+
+    ASSERT_EQ(v.chunk_view(0).size(), 4);
+    ASSERT_EQ(v.chunk_view(1).size(), 4);
+    ASSERT_EQ(v.chunk_view(2).size(), 7);
+    ASSERT_EQ(v.chunk_view(3).size(), 0);
+    ASSERT_EQ(v.chunk_view(2)[0], 5);
+
+    // elements never move
+    const VectorView<int> chunk0 = v.chunk_view(0);
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    ASSERT_EQ(&v[0], first);
+    ASSERT_EQ(chunk0.data(), first);
+    ASSERT_EQ(v.size(), 1015);
+
+    size_t seen = 0;
+    v.for_each_chunk([&](VectorView<int> view) {
+        ASSERT_EQ(view.data(), &v[seen]);
+        seen += view.size();
+    });
+    ASSERT_EQ(seen, 1015);
+
+    const Vector<int> copy = v.consolidate();
+    ASSERT_EQ(copy.size(), 1015);
+    ASSERT_EQ(copy[14], 11);
+    ASSERT_EQ(copy[1014], 999);
+    ASSERT_EQ(v.size(), 1015);
+
+    ChunkedVector<int> moved{ std::move(v) };
+    ASSERT_EQ(v.size(), 0);
+    ASSERT_EQ(&moved[0], first);
+}
+
+TEST(Containers2, ChunkedVectorConsolidateMove) {
+    ChunkedVector<std::string> v{ 2 };
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(std::string(40, static_cast<char>('a' + i)));
+    }
+    const Vector<std::string> strings = std::move(v).consolidate();
+    ASSERT_EQ(strings.size(), 10);
+    ASSERT_EQ(strings[9], std::string(40, 'j'));
+    ASSERT_TRUE(v.empty());
+    v.push_back("reusable");
+    ASSERT_EQ(v[0], "reusable");
+}
+
+TEST(Containers2, ChunkedVectorConcurrentAppend) {
+    constexpr size_t producers = 4;
+    constexpr std::uint64_t per_producer = 20000;
+    ChunkedVector<std::uint64_t> v{ 64 };
+
+    std::atomic<bool> done{ false };
+    // the reader only ever sees fully written elements (never the default-constructed 0) and a growing prefix
+    std::thread reader{ [&] {
+        size_t last = 0;
+        while (!done.load()) {
+            const size_t s = v.size();
+            ASSERT_GE(s, last);
+            size_t counted = 0;
+            v.for_each_chunk([&](VectorView<std::uint64_t> view) {
+                for (auto x : view) {
+                    ASSERT_NE(x, 0);
+                }
+                counted += view.size();
+            });
+            ASSERT_GE(counted, s);
+            last = s;
+            std::this_thread::yield();
+        }
+    } };
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            const std::uint64_t tag = (p + 1) << 32;
+            for (std::uint64_t i = 0; i < per_producer;) {
+                if (i % 10 == 0) {
+                    const std::uint64_t batch[]{ tag | i, tag | (i + 1), tag | (i + 2) };
+                    v.grow_by(VectorView<const std::uint64_t>{ std::begin(batch), std::end(batch) });
+                    i += 3;
+                }
+                else {
+                    v.push_back(tag | i);
+                    ++i;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(v.size(), producers * per_producer);
+    std::vector<std::vector<int>> seen(producers, std::vector<int>(per_producer));
+    v.for_each_chunk([&](VectorView<std::uint64_t> view) {
+        for (auto x : view) {
+            ++seen[(x >> 32) - 1][x & 0xffffffff];
+        }
+    });
+    for (auto& producer : seen) {
+        ASSERT_EQ(std::count(producer.begin(), producer.end(), 1), static_cast<std::ptrdiff_t>(per_producer));
+    }
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <Containers2/compressed_vector.hpp>
+#include <cstdint>
+#include <random>
+
+using namespace containers2;
+
+// CompressedVector: same copy/move rules as Vector, clone() is the copy
+static_assert(!std::is_copy_constructible_v<CompressedVector<std::uint32_t>>);
+static_assert(!std::is_copy_assignable_v<CompressedVector<std::uint32_t>>);
+static_assert(std::is_nothrow_move_constructible_v<CompressedVector<std::uint64_t>>);
+static_assert(std::is_nothrow_move_assignable_v<CompressedVector<std::uint64_t>>);
+
+// 32 and 64-bit unsigned integers only
+static_assert(CompressibleInteger<std::uint32_t> && CompressibleInteger<std::uint64_t>);
+static_assert(!CompressibleInteger<std::uint16_t> && !CompressibleInteger<std::int32_t> && !CompressibleInteger<double>);
+
+namespace {
+    constexpr simd::Isa isas[]{ simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512 };
+
+    enum class Pattern { sorted, small, constant, random };
+
+    template<typename T>
+    Vector<T> values(size_t n, Pattern pattern, unsigned seed)
+    {
+        std::mt19937_64 random{ seed };
+        Vector<T> result(n, uninitialized_tag);
+        T previous = static_cast<T>(random());
+        for (size_t i = 0; i < n; ++i) {
+            switch (pattern) {
+            case Pattern::sorted:
+                previous += static_cast<T>(random() % 20);
+                result[i] = previous;
+                break;
+            case Pattern::small:
+                result[i] = static_cast<T>(1000 + random() % 300);
+                break;
+            case Pattern::constant:
+                result[i] = previous;
+                break;
+            case Pattern::random:
+                result[i] = static_cast<T>(random());
+                break;
+            }
+        }
+        return result;
+    }
+
+    template<typename T>
+    void round_trip()
+    {
+        for (size_t n : { 0, 1, 7, 255, 256, 257, 1000, 20000 }) {
+            for (Pattern pattern : { Pattern::sorted, Pattern::small, Pattern::constant, Pattern::random }) {
+                const Vector<T> expected = values<T>(n, pattern, static_cast<unsigned>(n));
+                const CompressedVector<T> compressed{ VectorView<const T>{ expected } };
+                ASSERT_EQ(compressed.size(), n);
+                for (size_t i = 0; i < n; ++i) {
+                    ASSERT_EQ(compressed[i], expected[i]) << "n " << n << " pattern " << static_cast<int>(pattern) << " at " << i;
+                }
+                for (simd::Isa isa : isas) {
+                    Vector<T> out(n, uninitialized_tag);
+                    compressed.decode(out, isa);
+                    ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+
+                    // unaligned ranges, within a block and across several
+                    for (size_t first : { size_t{ 0 }, size_t{ 3 }, n / 3, n - std::min<size_t>(n, 5) }) {
+                        for (size_t count : { size_t{ 1 }, size_t{ 300 }, size_t{ 600 } }) {
+                            first = std::min(first, n);
+                            count = std::min(count, n - first);
+                            Vector<T> range(count, uninitialized_tag);
+                            compressed.decode(first, range, isa);
+                            ASSERT_TRUE(std::equal(range.begin(), range.end(), expected.begin() + first));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(Containers2, CompressedVectorRoundTrip32) {
+    round_trip<std::uint32_t>();
+}
+
+TEST(Containers2, CompressedVectorRoundTrip64) {
+    round_trip<std::uint64_t>();
+}
+
+TEST(Containers2, CompressedVectorRatio) {
+    // consecutive ids: differences of 1 across a lane, 4 bits per value with delta
+    Vector<std::uint32_t> ids(1 << 16, uninitialized_tag);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = static_cast<std::uint32_t>(1'000'000 + i);
+    }
+    const CompressedVector<std::uint32_t> packed{ std::move(ids) };
+    ASSERT_EQ(ids.size(), 0);
+    ASSERT_EQ(packed.size(), 1 << 16);
+    ASSERT_EQ(packed.block_count(), 256);
+    ASSERT_EQ(packed.words_.size(), (1 << 16) * 4 / 32);
+    ASSERT_LT(packed.compressed_bytes(), (1 << 16) * sizeof(std::uint32_t) / 6);
+    ASSERT_EQ(packed[12345], 1'012'345);
+
+    // identical values need no words at all
+    const CompressedVector<std::uint64_t> constant{ Vector<std::uint64_t>(1000, 42) };
+    ASSERT_EQ(constant.words_.size(), 0);
+    ASSERT_EQ(constant[999], 42);
+
+    // random 64-bit values are stored at full width, never wider
+    const CompressedVector<std::uint64_t> random{ values<std::uint64_t>(512, Pattern::random, 1) };
+    ASSERT_EQ(random.words_.size(), 512);
+
+    CompressedVector<std::uint32_t> copy = packed.clone();
+    ASSERT_NE(copy.words_.data(), packed.words_.data());
+    ASSERT_EQ(copy[65535], packed[65535]);
+    CompressedVector<std::uint32_t> moved{ std::move(copy) };
+    ASSERT_TRUE(copy.empty());
+    ASSERT_EQ(moved[7], 1'000'007);
+}
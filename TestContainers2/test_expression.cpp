@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <Containers2/expression.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace containers2;
+
+// expressions are small values over views, never over temporaries
+static_assert(std::is_trivially_copyable_v<decltype(expr::lazy(std::declval<const Vector<float>&>()) * 2.0f + 1.0f)>);
+static_assert(std::is_same_v<decltype(expr::lazy(std::declval<Vector<int>&>())), expr::Leaf<int>>);
+static_assert(std::is_same_v<decltype(expr::lazy(std::declval<const VectorView<const int>&>())), expr::Leaf<int>>);
+template<typename V>
+concept Lazy = requires(V&& v) { expr::lazy(std::forward<V>(v)); };
+static_assert(Lazy<const Vector<int>&> && !Lazy<Vector<int>&&>);
+// element types do not mix without a cast, comparisons give bool
+static_assert(std::is_same_v<expr::value_t<decltype(expr::lazy(std::declval<Vector<float>&>()) < 1.0f)>, bool>);
+static_assert(!std::is_invocable_v<std::plus<>, expr::Leaf<float>, expr::Leaf<double>>);
+static_assert(std::is_invocable_v<std::plus<>, expr::Leaf<float>, int>);
+static_assert(!std::is_invocable_v<std::plus<>, expr::Leaf<bool>, expr::Leaf<bool>>);
+static_assert(!std::is_invocable_v<std::logical_and<>, expr::Leaf<int>, expr::Leaf<int>>);
+
+template<typename T>
+struct Containers2Expression : testing::Test
+{
+    // every instruction set up to the one of the running CPU
+    static std::vector<simd::Isa> isas()
+    {
+        std::vector<simd::Isa> result;
+        for (auto isa : { simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512 }) {
+            if (isa <= simd::detected_isa()) {
+                result.push_back(isa);
+            }
+        }
+        return result;
+    }
+
+    // small values keep every result exact and in range, so every instruction set must match the scalar loop
+    static Vector<T> make(size_t s, size_t seed)
+    {
+        Vector<T> vector(s, uninitialized_tag);
+        for (size_t i = 0; i < vector.size(); ++i) {
+            vector[i] = static_cast<T>((i * 7 + seed) % 11);
+        }
+        return vector;
+    }
+
+    // sizes around every vector width
+    static constexpr size_t sizes[]{ 0, 1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 300, 1000 };
+};
+
+using ExpressionTypes = testing::Types<std::int8_t, std::uint8_t, std::int16_t, std::int32_t, std::uint32_t, std::int64_t, float, double>;
+TYPED_TEST_SUITE(Containers2Expression, ExpressionTypes);
+
+TYPED_TEST(Containers2Expression, Arithmetic) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            const Vector<T> a = TestFixture::make(s, 1);
+            const Vector<T> b = TestFixture::make(s, 2);
+            const Vector<T> c = TestFixture::make(s, 3);
+            const auto x = expr::lazy(a);
+            const auto y = expr::lazy(b);
+            const auto z = expr::lazy(c);
+
+            Vector<T> out(s, uninitialized_tag);
+            expr::assign(out, x + y * z - 2, isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(out[i], static_cast<T>(a[i] + b[i] * c[i] - 2)) << "size " << s << " at " << i;
+            }
+
+            const Vector<T> quotient = expr::to_vector(expr::maximum(-x, 3 - y) / (z + 1), isa);
+            ASSERT_EQ(quotient.size(), s);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(quotient[i], static_cast<T>(std::max(static_cast<T>(-a[i]), static_cast<T>(3 - b[i])) / (c[i] + 1))) << "size " << s << " at " << i;
+            }
+
+            // in place: out is read and written at the same positions
+            expr::assign(out, expr::minimum(expr::lazy(out), z), isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(out[i], std::min(static_cast<T>(a[i] + b[i] * c[i] - 2), c[i]));
+            }
+        }
+    }
+}
+
+TYPED_TEST(Containers2Expression, CompareAndSelect) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            const Vector<T> a = TestFixture::make(s, 1);
+            const Vector<T> b = TestFixture::make(s, 5);
+            const auto x = expr::lazy(a);
+            const auto y = expr::lazy(b);
+
+            Vector<bool> mask(s, uninitialized_tag);
+            expr::assign(mask, (x < y && x != 3) || !(y <= 8), isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(mask[i], (a[i] < b[i] && a[i] != 3) || !(b[i] <= 8)) << "size " << s << " at " << i;
+            }
+
+            const Vector<T> selected = expr::to_vector(expr::select(x >= y, x * 2, 7), isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(selected[i], a[i] >= b[i] ? static_cast<T>(a[i] * 2) : T{ 7 });
+            }
+
+            // a mask of bool from memory, and masks of another width than the selected values
+            const auto lazy_mask = expr::lazy(mask);
+            const Vector<double> wide = expr::to_vector(expr::select(lazy_mask && expr::cast<double>(x) > 2.0, 1.5, expr::cast<double>(y)), isa);
+            for (size_t i = 0; i < s; ++i) {
+                ASSERT_EQ(wide[i], mask[i] && a[i] > 2 ? 1.5 : static_cast<double>(b[i]));
+            }
+
+            ASSERT_EQ(expr::count(lazy_mask, isa), static_cast<size_t>(std::count(mask.begin(), mask.end(), true)));
+            size_t greater_equal = 0;
+            for (size_t i = 0; i < s; ++i) {
+                greater_equal += a[i] >= b[i];
+            }
+            ASSERT_EQ(expr::count(x == y || x > y, isa), greater_equal);
+        }
+    }
+}
+
+TYPED_TEST(Containers2Expression, Reductions) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            const Vector<T> a = TestFixture::make(s, 1);
+            const Vector<T> b = TestFixture::make(s, 4);
+            const auto x = expr::lazy(a);
+            const auto y = expr::lazy(b);
+
+            // summed in T, products of small values below 8-bit limits
+            T sum{};
+            T minimum = std::numeric_limits<T>::max();
+            T maximum = std::numeric_limits<T>::lowest();
+            for (size_t i = 0; i < s; ++i) {
+                const T v = static_cast<T>(a[i] * b[i] - b[i]);
+                sum = static_cast<T>(sum + v);
+                minimum = std::min(minimum, v);
+                maximum = std::max(maximum, v);
+            }
+            ASSERT_EQ(expr::sum(x * y - y, isa), sum) << "size " << s;
+            ASSERT_EQ(expr::min(x * y - y, isa), minimum) << "size " << s;
+            ASSERT_EQ(expr::max(x * y - y, isa), maximum) << "size " << s;
+
+            // through a cast: no overflow in 64 bits
+            std::int64_t wide_sum = 0;
+            for (size_t i = 0; i < s; ++i) {
+                wide_sum += static_cast<std::int64_t>(a[i]) * 1000;
+            }
+            ASSERT_EQ(expr::sum(expr::cast<std::int64_t>(x) * 1000, isa), wide_sum);
+        }
+    }
+}
+
+TEST(Containers2, ExpressionViews) {
+    Vector<int> values(100, uninitialized_tag);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+    // into a part of a Vector, from a part of another
+    const VectorView<const int> tail{ values.begin() + 50, values.end() };
+    Vector<int> out(100, 0);
+    expr::assign(VectorView<int>{ out.begin() + 10, out.begin() + 60 }, expr::lazy(tail) * expr::lazy(tail));
+    ASSERT_EQ(out[9], 0);
+    ASSERT_EQ(out[10], 2500);
+    ASSERT_EQ(out[59], 99 * 99);
+    ASSERT_EQ(out[60], 0);
+
+    // expressions are reusable values and compute nothing until evaluated
+    const auto squares = expr::lazy(values) * expr::lazy(values);
+    values[3] = 10;
+    ASSERT_EQ(squares[3], 100);
+    ASSERT_EQ(expr::to_vector(squares)[3], 100);
+    ASSERT_EQ(squares.size(), 100);
+    ASSERT_EQ((squares + 1).size(), 100);
+
+    // the output must match the expression
+    Vector<int> longer(101, 0);
+    ASSERT_THROW(expr::assign(longer, squares), std::invalid_argument);
+    ASSERT_THROW(expr::assign(VectorView<int>{ out.begin(), out.begin() + 49 }, expr::lazy(tail) * 2), std::invalid_argument);
+    ASSERT_EQ(longer[100], 0);
+    const VectorView<const int> head{ values.begin(), values.begin() + 50 };
+    expr::assign(VectorView<int>{ out.begin(), out.begin() + 50 }, expr::lazy(head) + expr::lazy(tail));
+    ASSERT_EQ(out[49], 49 + 99);
+
+    // and the operands one another, but for scalars
+    const auto lazy_values = expr::lazy(values);
+    const auto lazy_tail = expr::lazy(tail);
+    ASSERT_THROW(lazy_values + lazy_tail, std::invalid_argument);
+    ASSERT_THROW(expr::maximum(lazy_tail, lazy_values), std::invalid_argument);
+    ASSERT_THROW(lazy_values < lazy_tail, std::invalid_argument);
+    ASSERT_THROW((lazy_values < 5) && (lazy_tail < 5), std::invalid_argument);
+    ASSERT_THROW((lazy_values < 5) || (lazy_tail < 5), std::invalid_argument);
+    ASSERT_THROW(expr::select(lazy_tail < 5, lazy_values, 0), std::invalid_argument);
+    ASSERT_THROW(expr::select(lazy_values < 5, lazy_values, lazy_tail), std::invalid_argument);
+    ASSERT_EQ(expr::select(lazy_values < 5, lazy_values, 0).size(), 100);
+    ASSERT_EQ((2 * lazy_tail + 1).size(), 50);
+}
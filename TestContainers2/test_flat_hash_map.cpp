@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <Containers2/flat_hash_map.hpp>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace containers2;
+
+// FlatHashMap: same copy/move rules as Vector, clone() is the copy
+static_assert(!std::is_copy_constructible_v<FlatHashMap<int, int>>);
+static_assert(!std::is_copy_assignable_v<FlatHashMap<int, int>>);
+static_assert(std::is_nothrow_move_constructible_v<FlatHashMap<int, int>>);
+static_assert(std::is_nothrow_move_assignable_v<FlatHashMap<int, int>>);
+
+// the view: trivially copyable with stateless functors, read-only, never from a temporary map
+static_assert(std::is_trivially_copyable_v<FlatHashMapView<int, int>>);
+static_assert(sizeof(FlatHashMapView<int, int>) == 4 * sizeof(void*));
+static_assert(std::is_constructible_v<FlatHashMapView<int, int>, const FlatHashMap<int, int>&>);
+static_assert(!std::is_constructible_v<FlatHashMapView<int, int>, FlatHashMap<int, int>&&>);
+static_assert(std::is_same_v<decltype(std::declval<const FlatHashMapView<int, int>&>().find(0)), const int*>);
+
+namespace {
+    // every key collides: probing has to go through the equality test alone
+    struct ConstantHash
+    {
+        size_t operator()(int) const noexcept { return 42; }
+    };
+}
+
+TEST(Containers2, FlatHashMapInsertFind) {
+    FlatHashMap<int, std::string> map;
+    ASSERT_EQ(map.capacity(), 0);
+    ASSERT_EQ(map.find(1), nullptr);
+    ASSERT_FALSE(map.erase(1));
+
+    auto [value, inserted] = map.insert(1, "one");
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(*value, "one");
+    ASSERT_EQ(map.capacity(), (FlatHashMap<int, std::string>::min_capacity));
+    ASSERT_FALSE(map.insert(1, "uno").second);
+    ASSERT_EQ(*map.find(1), "one");
+    ASSERT_FALSE(map.insert_or_assign(1, "uno").second);
+    ASSERT_EQ(*map.find(1), "uno");
+    map[2] = "two";
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_TRUE(map.contains(2));
+    ASSERT_FALSE(map.contains(3));
+
+    ASSERT_TRUE(map.erase(1));
+    ASSERT_FALSE(map.contains(1));
+    ASSERT_EQ(map.size(), 1);
+
+    std::map<int, std::string> seen;
+    map.for_each([&](const int& k, std::string& v) { seen[k] = v; });
+    ASSERT_EQ(seen, (std::map<int, std::string>{ { 2, "two" } }));
+}
+
+TEST(Containers2, FlatHashMapGrowth) {
+    FlatHashMap<std::uint64_t, std::uint64_t> map;
+    std::mt19937_64 random{ 1 };
+    std::vector<std::uint64_t> keys(100000);
+    for (auto& key : keys) {
+        key = random();
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        map.insert(keys[i], i);
+        ASSERT_LE(map.load_factor(), 0.875);
+    }
+    ASSERT_EQ(map.size(), keys.size());
+    ASSERT_EQ(map.capacity(), 131072);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(*map.find(keys[i]), i);
+        ASSERT_EQ(map.find(keys[i] + 1), nullptr);
+    }
+
+    // erase half, the tombstones are reused or cleaned up by a rehash at the same capacity
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        ASSERT_TRUE(map.erase(keys[i]));
+    }
+    for (int round = 0; round < 4; ++round) {
+        for (size_t i = 0; i < keys.size(); i += 2) {
+            map.insert(keys[i] ^ round, i);
+            ASSERT_TRUE(map.erase(keys[i] ^ round));
+        }
+    }
+    ASSERT_EQ(map.size(), keys.size() / 2);
+    ASSERT_EQ(map.capacity(), 131072);
+    for (size_t i = 1; i < keys.size(); i += 2) {
+        ASSERT_EQ(*map.find(keys[i]), i);
+    }
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.find(keys[1]), nullptr);
+    ASSERT_EQ(map.capacity(), 131072);
+}
+
+TEST(Containers2, FlatHashMapCollisions) {
+    FlatHashMap<int, int, ConstantHash> map;
+    for (int i = 0; i < 100; ++i) {
+        map.insert(i, -i);
+    }
+    for (int i = 0; i < 100; i += 3) {
+        map.erase(i);
+    }
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            ASSERT_EQ(map.find(i), nullptr);
+        }
+        else {
+            ASSERT_EQ(*map.find(i), -i);
+        }
+    }
+}
+
+TEST(Containers2, FlatHashMapReserveBulk) {
+    FlatHashMap<int, int> map;
+    map.reserve(1000);
+    const size_t capacity = map.capacity();
+    ASSERT_GE(capacity * 7 / 8, 1000);
+
+    Vector<int> keys(1000, uninitialized_tag);
+    Vector<int> values(1000, uninitialized_tag);
+    for (int i = 0; i < 1000; ++i) {
+        keys[i] = i % 900; // the last 100 repeat: the first occurrence wins
+        values[i] = i;
+    }
+    map.insert(keys, values);
+    ASSERT_EQ(map.capacity(), capacity);
+    ASSERT_EQ(map.size(), 900);
+    ASSERT_EQ(*map.find(5), 5);
+
+    Vector<int> lookups(2000, uninitialized_tag);
+    Vector<const int*> found(2000, uninitialized_tag);
+    for (int i = 0; i < 2000; ++i) {
+        lookups[i] = i;
+    }
+    map.find(lookups, found);
+    for (int i = 0; i < 2000; ++i) {
+        if (i < 900) {
+            ASSERT_EQ(*found[i], i);
+        }
+        else {
+            ASSERT_EQ(found[i], nullptr);
+        }
+    }
+}
+
+TEST(Containers2, FlatHashMapCloneMove) {
+    FlatHashMap<std::string, int> map;
+    for (int i = 0; i < 50; ++i) {
+        map.insert(std::to_string(i), i);
+    }
+    FlatHashMap<std::string, int> copy = map.clone();
+    *copy.find("7") = 70;
+    copy.erase("8");
+    ASSERT_EQ(*map.find("7"), 7);
+    ASSERT_TRUE(map.contains("8"));
+    ASSERT_EQ(copy.size(), 49);
+
+    const int* seven = map.find("7");
+    FlatHashMap<std::string, int> moved{ std::move(map) };
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.find("7"), nullptr);
+    ASSERT_EQ(moved.find("7"), seven);
+    map.insert("reusable", 1);
+    ASSERT_EQ(*map.find("reusable"), 1);
+}
+
+TEST(Containers2, FlatHashMapSharedView) {
+    FlatHashMap<std::uint32_t, std::uint32_t> map;
+    for (std::uint32_t i = 0; i < 50000; ++i) {
+        map.insert(i * 7, i);
+    }
+    const FlatHashMapView<std::uint32_t, std::uint32_t> view = map;
+    std::vector<std::thread> readers;
+    std::vector<size_t> hits(4);
+    for (size_t t = 0; t < hits.size(); ++t) {
+        readers.emplace_back([view, &hits, t] {
+            for (std::uint32_t i = 0; i < 7 * 50000; ++i) {
+                const std::uint32_t* v = view.find(i);
+                if (v != nullptr) {
+                    ASSERT_EQ(*v * 7, i);
+                    ++hits[t];
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (size_t h : hits) {
+        ASSERT_EQ(h, 50000);
+    }
+}
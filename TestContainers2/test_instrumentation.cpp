@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include <Containers2/containers2.hpp>
+#include <string>
+#include <vector>
+
+using namespace containers2;
+
+// built into its own executable with CONTAINERS2_INSTRUMENTATION=1
+static_assert(instrumentation::enabled);
+
+// instrumentation lives in global counters: the containers keep their layout
+static_assert(std::is_trivially_copyable_v<VectorView<const int>>);
+static_assert(std::is_trivially_copyable_v<VectorView<int>>);
+static_assert(sizeof(VectorView<int>) == 2 * sizeof(int*));
+static_assert(sizeof(Vector<int>) == 4 * sizeof(int*));
+
+namespace {
+    using instrumentation::Operation;
+
+    constexpr Operation operations[]{ Operation::other, Operation::resize_uninitialized, Operation::resize_initialized,
+        Operation::resize_non_preserving_uninitialized, Operation::resize_non_preserving_initialized, Operation::reserve, Operation::shrink_to_fit,
+        Operation::clone, Operation::copy_from };
+
+    void reset()
+    {
+        instrumentation::totals().reset();
+        instrumentation::by_type<int>().reset();
+        instrumentation::by_type<std::string>().reset();
+        for (Operation operation : operations) {
+            instrumentation::by_operation(operation).reset();
+        }
+    }
+
+    instrumentation::Statistics total_statistics() { return instrumentation::totals().snapshot(); }
+    instrumentation::Statistics operation_statistics(Operation operation) { return instrumentation::by_operation(operation).snapshot(); }
+}
+
+// the sequence of VectorResize, through new[] so that every reallocation copies
+TEST(Containers2, InstrumentationVectorResize) {
+    reset();
+    {
+        Vector<int> vector{ { 5, 7, 12 }, nullptr };
+        vector.resize(5, 24); // reallocates to 6 elements, copying 3
+        vector.resize(6);
+        vector.resize(4);
+        vector.resize(2, 127);
+        vector.resize(4, 87, non_preserving_initialized_tag);
+        vector.resize(76, non_preserving_uninitialized_tag); // allocates, copies nothing
+
+        const auto s = total_statistics();
+        ASSERT_EQ(s.allocations, 3);
+        ASSERT_EQ(s.deallocations, 2);
+        ASSERT_EQ(s.reallocations, 1);
+        ASSERT_EQ(s.bytes_allocated, (3 + 6 + 76) * sizeof(int));
+        ASSERT_EQ(s.bytes_copied, 3 * sizeof(int));
+        ASSERT_EQ(s.bytes_live, 76 * sizeof(int));
+        ASSERT_EQ(s.bytes_live_high_water, (6 + 76) * sizeof(int));
+
+        const auto initialized = operation_statistics(Operation::resize_initialized);
+        ASSERT_EQ(initialized.allocations, 1);
+        ASSERT_EQ(initialized.deallocations, 1);
+        ASSERT_EQ(initialized.reallocations, 1);
+        ASSERT_EQ(initialized.bytes_copied, 3 * sizeof(int));
+
+        const auto non_preserving = operation_statistics(Operation::resize_non_preserving_uninitialized);
+        ASSERT_EQ(non_preserving.allocations, 1);
+        ASSERT_EQ(non_preserving.deallocations, 1);
+        ASSERT_EQ(non_preserving.reallocations, 0);
+
+        ASSERT_EQ(operation_statistics(Operation::resize_uninitialized).allocations, 0);
+        ASSERT_EQ(operation_statistics(Operation::resize_non_preserving_initialized).allocations, 0);
+        ASSERT_EQ(operation_statistics(Operation::other).allocations, 1);
+    }
+    const auto s = total_statistics();
+    ASSERT_EQ(s.deallocations, 3);
+    ASSERT_EQ(s.bytes_deallocated, s.bytes_allocated);
+    ASSERT_EQ(s.bytes_live, 0);
+    ASSERT_EQ(operation_statistics(Operation::other).deallocations, 1);
+}
+
+// the sequence of VectorResizeCapacity: geometric growth, shrink_to_fit and reserve
+TEST(Containers2, InstrumentationVectorResizeCapacity) {
+    reset();
+    {
+        Vector<int> vector{ { 5, 7, 12, 24, 24, 36 }, nullptr };
+        vector.resize(4);
+        vector.resize(6, 48);
+        ASSERT_EQ(total_statistics().reallocations, 0);
+
+        vector.resize(7); // 6 -> 12 elements
+        ASSERT_EQ(total_statistics().reallocations, 1);
+        ASSERT_EQ(total_statistics().bytes_copied, 6 * sizeof(int));
+
+        vector.resize(3, non_preserving_uninitialized_tag);
+        vector.resize(10, 1, non_preserving_initialized_tag);
+        ASSERT_EQ(total_statistics().allocations, 2);
+
+        vector.resize(2);
+        vector.shrink_to_fit(); // 12 -> 2 elements
+        vector.reserve(100); // 2 -> 100 elements
+        vector.resize(0);
+        vector.shrink_to_fit(); // 100 -> 0 elements
+
+        const auto s = total_statistics();
+        ASSERT_EQ(s.allocations, 5);
+        ASSERT_EQ(s.deallocations, 4);
+        ASSERT_EQ(s.reallocations, 4);
+        ASSERT_EQ(s.bytes_allocated, (6 + 12 + 2 + 100) * sizeof(int));
+        ASSERT_EQ(s.bytes_copied, (6 + 2 + 2) * sizeof(int));
+        ASSERT_EQ(s.bytes_live, 0);
+        ASSERT_EQ(s.bytes_live_high_water, (2 + 100) * sizeof(int));
+
+        ASSERT_EQ(operation_statistics(Operation::resize_uninitialized).reallocations, 1);
+        ASSERT_EQ(operation_statistics(Operation::shrink_to_fit).reallocations, 2);
+        ASSERT_EQ(operation_statistics(Operation::shrink_to_fit).bytes_copied, 2 * sizeof(int));
+        ASSERT_EQ(operation_statistics(Operation::reserve).reallocations, 1);
+        ASSERT_EQ(operation_statistics(Operation::reserve).bytes_allocated, 100 * sizeof(int));
+        ASSERT_EQ(operation_statistics(Operation::resize_non_preserving_uninitialized).allocations, 0);
+        ASSERT_EQ(operation_statistics(Operation::resize_non_preserving_initialized).allocations, 0);
+    }
+    ASSERT_EQ(total_statistics().deallocations, 5);
+}
+
+// explicit copies: clone allocates exactly the size, copy_from only beyond the capacity
+TEST(Containers2, InstrumentationVectorCopy) {
+    reset();
+    {
+        const Vector<int> source{ { 1, 2, 3, 4, 5 }, nullptr };
+        Vector<int> copy = source.clone();
+        copy.copy_from(VectorView<const int>{ source.begin(), source.begin() + 2 });
+        copy.copy_from(source);
+        ASSERT_EQ(total_statistics().allocations, 2);
+        const Vector<int> longer(8, 7);
+        copy.copy_from(longer);
+        ASSERT_EQ(copy.size(), 8);
+
+        ASSERT_EQ(operation_statistics(Operation::clone).allocations, 1);
+        ASSERT_EQ(operation_statistics(Operation::clone).bytes_allocated, 5 * sizeof(int));
+        // the non preserving resize inside copy_from counts as copy_from
+        ASSERT_EQ(operation_statistics(Operation::copy_from).allocations, 1);
+        ASSERT_EQ(operation_statistics(Operation::copy_from).deallocations, 1);
+        ASSERT_EQ(operation_statistics(Operation::resize_non_preserving_uninitialized).allocations, 0);
+        ASSERT_EQ(total_statistics().bytes_copied, 0);
+    }
+    ASSERT_EQ(total_statistics().bytes_live, 0);
+}
+
+// per-type counters: Vector<const T> counts as T
+TEST(Containers2, InstrumentationByType) {
+    reset();
+    {
+        Vector<std::string> strings{ 2, std::string{ "a string long enough not to fit in the small string buffer" } };
+        strings.resize(3, std::string{ "x" }); // 2 -> 4 elements
+        Vector<int> ints{ 4, 1, initialized_tag };
+        Vector<const int> const_ints{ std::move(ints) };
+
+        const auto s = instrumentation::by_type<std::string>().snapshot();
+        ASSERT_EQ(s.allocations, 2);
+        ASSERT_EQ(s.reallocations, 1);
+        ASSERT_EQ(s.bytes_copied, 2 * sizeof(std::string));
+        ASSERT_EQ(s.bytes_live, 4 * sizeof(std::string));
+
+        const auto i = instrumentation::by_type<int>().snapshot();
+        ASSERT_EQ(i.allocations, 1);
+        ASSERT_EQ(i.reallocations, 0);
+        ASSERT_EQ(i.bytes_live, 4 * sizeof(int));
+
+        ASSERT_EQ(total_statistics().bytes_live, 4 * sizeof(std::string) + 4 * sizeof(int));
+    }
+    ASSERT_EQ(instrumentation::by_type<int>().snapshot().deallocations, 1);
+    ASSERT_EQ(instrumentation::by_type<std::string>().snapshot().bytes_live, 0);
+}
+
+// counts reallocations to check that growth of trivially copyable elements never goes through allocate+copy
+struct CountingReallocatingMemoryResource : ReallocatingMemoryResource
+{
+    size_t allocations = 0;
+    size_t reallocations = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return malloc_memory_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        malloc_memory_resource()->deallocate(p, bytes, alignment);
+    }
+
+    void* do_reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t alignment) override
+    {
+        ++reallocations;
+        return static_cast<ReallocatingMemoryResource*>(malloc_memory_resource())->reallocate(p, old_bytes, new_bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// the sequence of VectorResizeRealloc, observed through the callback: realloc reports the old buffer released and
+// the new one obtained, and copies nothing when it resizes in place
+TEST(Containers2, InstrumentationVectorResizeRealloc) {
+    reset();
+    std::vector<instrumentation::Event> events;
+    instrumentation::set_callback([](const instrumentation::Event& event, void* context) {
+        static_cast<std::vector<instrumentation::Event>*>(context)->push_back(event);
+    }, &events);
+    {
+        CountingReallocatingMemoryResource resource;
+        Vector<int> vector{ 4, 3, initialized_tag, &resource };
+        vector.resize(1000, 5);
+        vector.resize(100000);
+        vector.resize(50000);
+        vector.shrink_to_fit();
+        instrumentation::set_callback(nullptr);
+
+        const auto s = total_statistics();
+        ASSERT_EQ(s.reallocations, resource.reallocations);
+        ASSERT_EQ(s.allocations, resource.allocations + resource.reallocations);
+        ASSERT_EQ(s.deallocations, resource.reallocations);
+        ASSERT_EQ(s.bytes_live, 50000 * sizeof(int));
+        ASSERT_EQ(s.bytes_live_high_water, 100000 * sizeof(int));
+        ASSERT_LE(s.bytes_copied, (4 + 1000 + 50000) * sizeof(int));
+    }
+
+    using instrumentation::EventKind;
+    std::vector<instrumentation::Event> reallocations;
+    for (const auto& event : events) {
+        ASSERT_EQ(*event.type, typeid(int));
+        if (event.kind == EventKind::reallocate) {
+            reallocations.push_back(event);
+        }
+    }
+    ASSERT_EQ(events.size(), 1 + 3 * 3);
+    ASSERT_EQ(events[0].kind, EventKind::allocate);
+    ASSERT_EQ(events[0].operation, Operation::other);
+    ASSERT_EQ(events[1].kind, EventKind::deallocate);
+    ASSERT_EQ(events[1].bytes, 4 * sizeof(int));
+    ASSERT_EQ(events[2].kind, EventKind::allocate);
+    ASSERT_EQ(events[2].bytes, 1000 * sizeof(int));
+    ASSERT_EQ(reallocations.size(), 3);
+    ASSERT_EQ(reallocations[0].operation, Operation::resize_initialized);
+    ASSERT_EQ(reallocations[0].old_bytes, 4 * sizeof(int));
+    ASSERT_EQ(reallocations[0].bytes, 1000 * sizeof(int));
+    ASSERT_EQ(reallocations[1].operation, Operation::resize_uninitialized);
+    ASSERT_EQ(reallocations[1].bytes, 100000 * sizeof(int));
+    ASSERT_EQ(reallocations[2].operation, Operation::shrink_to_fit);
+    ASSERT_EQ(reallocations[2].old_bytes, 100000 * sizeof(int));
+    ASSERT_EQ(reallocations[2].bytes, 50000 * sizeof(int));
+    ASSERT_EQ(total_statistics().bytes_live, 0);
+}
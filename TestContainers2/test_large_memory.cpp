@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <Containers2/large_memory.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+using namespace containers2;
+
+static_assert(std::is_base_of_v<ReallocatingMemoryResource, LargePageMemoryResource>);
+static_assert(LargePageMemoryResource::mapped_bytes(1) == huge_page_size);
+static_assert(LargePageMemoryResource::mapped_bytes(huge_page_size) == huge_page_size);
+static_assert(LargePageMemoryResource::mapped_bytes(huge_page_size + 1) == 2 * huge_page_size);
+
+namespace {
+    bool huge_page_aligned(const void* p)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % huge_page_size == 0;
+    }
+}
+
+TEST(Containers2, LargePageMemoryResourceAllocate) {
+    ASSERT_GE(numa_node_count(), 1);
+    LargePageMemoryResource resource;
+    ASSERT_TRUE(resource.is_equal(*large_page_memory_resource()));
+    ASSERT_FALSE(resource.is_equal(LargePageMemoryResource{ NumaPolicy::interleave }));
+    ASSERT_FALSE(resource.is_equal(*malloc_memory_resource()));
+
+    // small blocks come from malloc
+    ASSERT_FALSE(resource.maps(100, alignof(int)));
+    Vector<int> small(100, 3, initialized_tag, &resource);
+    ASSERT_EQ(std::count(small.begin(), small.end(), 3), 100);
+
+#if defined(__linux__)
+    ASSERT_TRUE(resource.maps(huge_page_size, alignof(int)));
+    const size_t n = 3 * huge_page_size / sizeof(int) + 5;
+    Vector<int> large(n, 7, initialized_tag, &resource);
+    ASSERT_TRUE(huge_page_aligned(large.data()));
+    ASSERT_EQ(std::count(large.begin(), large.end(), 7), static_cast<std::ptrdiff_t>(n));
+#endif
+}
+
+// growth and shrinking keep the elements, across the threshold in both directions
+TEST(Containers2, LargePageMemoryResourceReallocate) {
+    LargePageMemoryResource resource{ NumaPolicy::local, 0, 1 << 16 };
+    Vector<std::uint32_t> v(1000, uninitialized_tag, &resource);
+    std::iota(v.begin(), v.end(), 0u);
+    for (size_t s : { size_t{ 100000 }, size_t{ 3000000 }, size_t{ 5000000 }, size_t{ 200000 }, size_t{ 10 } }) {
+        const size_t old_size = v.size();
+        v.resize(s);
+        std::iota(v.begin() + std::min(old_size, s), v.end(), static_cast<std::uint32_t>(std::min(old_size, s)));
+        v.shrink_to_fit();
+        ASSERT_EQ(v.size(), s);
+        for (size_t i = 0; i < s; ++i) {
+            ASSERT_EQ(v[i], i) << "size " << s;
+        }
+    }
+}
+
+// the policies cannot be observed here, only that they never fail: one node, or a node that does not exist
+TEST(Containers2, LargePageMemoryResourceNumaPolicies) {
+    const size_t n = 2 * huge_page_size / sizeof(double);
+    LargePageMemoryResource resources[]{ LargePageMemoryResource{ NumaPolicy::interleave }, LargePageMemoryResource{ NumaPolicy::bind, 0 }, LargePageMemoryResource{ NumaPolicy::bind, 100000 } };
+    for (auto& resource : resources) {
+        Vector<double> v(n, 1.5, initialized_tag, &resource);
+        ASSERT_EQ(std::count(v.begin(), v.end(), 1.5), static_cast<std::ptrdiff_t>(n));
+        v.resize(2 * n, 2.5);
+        ASSERT_EQ(v[n - 1], 1.5);
+        ASSERT_EQ(v[2 * n - 1], 2.5);
+    }
+}
+
+TEST(Containers2, ParallelMakeVector) {
+    ThreadPool pool{ 4 };
+    for (size_t n : { size_t{ 0 }, size_t{ 1 }, size_t{ 1000 }, 5 * huge_page_size / sizeof(std::int64_t) + 3 }) {
+        const Vector<std::int64_t> made = parallel::make_vector(n, std::int64_t{ -4 }, large_page_memory_resource(), pool);
+        ASSERT_EQ(made.size(), n);
+        ASSERT_EQ(made.resource(), large_page_memory_resource());
+        ASSERT_EQ(std::count(made.begin(), made.end(), -4), static_cast<std::ptrdiff_t>(n)) << "size " << n;
+    }
+    const Vector<float> default_resource = parallel::make_vector(100, 0.5f);
+    ASSERT_EQ(default_resource[99], 0.5f);
+}
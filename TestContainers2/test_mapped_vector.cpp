@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <Containers2/mapped_vector.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+using namespace containers2;
+
+// MappedVector owns its mapping like Vector owns its buffer
+static_assert(!std::is_copy_constructible_v<MappedVector<const int>>);
+static_assert(!std::is_copy_assignable_v<MappedVector<const int>>);
+static_assert(!std::is_constructible_v<MappedVector<const int>, const VectorView<const int>&>);
+static_assert(!std::is_constructible_v<MappedVector<int>, const VectorView<int>&>);
+static_assert(std::is_nothrow_move_constructible_v<MappedVector<const int>>);
+static_assert(std::is_constructible_v<MappedVector<const int>, MappedVector<int>&&>);
+static_assert(!std::is_constructible_v<MappedVector<int>, MappedVector<const int>&&>);
+// views can borrow from it but not from its temporaries
+static_assert(std::is_trivially_constructible_v<VectorView<const int>, const MappedVector<const int>&>);
+static_assert(std::is_trivially_constructible_v<VectorView<int>, const MappedVector<int>&>);
+static_assert(!std::is_constructible_v<VectorView<int>, const MappedVector<const int>&>);
+static_assert(!std::is_constructible_v<VectorView<const int>, MappedVector<const int>&&>);
+static_assert(!std::is_constructible_v<VectorView<const int>, MappedVector<int>&&>);
+static_assert(!std::is_assignable_v<VectorView<const int>&, MappedVector<int>&&>);
+static_assert(std::is_trivially_copyable_v<VectorView<const int>>);
+
+struct MappedFile
+{
+    std::filesystem::path path;
+
+    MappedFile(const char* name, size_t count) : path{ std::filesystem::temp_directory_path() / name }
+    {
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        for (std::uint32_t i = 0; i < count; ++i) {
+            file.write(reinterpret_cast<const char*>(&i), sizeof(i));
+        }
+    }
+
+    ~MappedFile() { std::filesystem::remove(path); }
+
+    std::uint32_t read(size_t index) const
+    {
+        std::ifstream file{ path, std::ios::binary };
+        file.seekg(index * sizeof(std::uint32_t));
+        std::uint32_t value = 0;
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+};
+
+TEST(Containers2, MappedVectorReadOnly) {
+    const MappedFile file{ "containers2_mapped_read_only.bin", 100000 };
+    for (auto options : { MapOptions{}, MapOptions{ true, MapAdvice::sequential }, MapOptions{ false, MapAdvice::random }, MapOptions{ false, MapAdvice::will_need } }) {
+        const MappedVector<const std::uint32_t> mapped{ file.path, MapMode::read_only, options };
+        ASSERT_EQ(mapped.size(), 100000);
+        const VectorView<const std::uint32_t> view{ mapped };
+        for (std::uint32_t i = 0; i < view.size(); ++i) {
+            ASSERT_EQ(view[i], i);
+        }
+    }
+}
+
+TEST(Containers2, MappedVectorTrailingBytes) {
+    const MappedFile file{ "containers2_mapped_trailing.bin", 3 };
+    std::ofstream{ file.path, std::ios::binary | std::ios::app }.put('x');
+    const MappedVector<const std::uint64_t> mapped{ file.path };
+    ASSERT_EQ(mapped.size(), 1); // 13 bytes
+}
+
+TEST(Containers2, MappedVectorEmpty) {
+    const MappedFile file{ "containers2_mapped_empty.bin", 0 };
+    const MappedVector<const std::uint32_t> mapped{ file.path };
+    ASSERT_EQ(mapped.size(), 0);
+    ASSERT_EQ(mapped.data(), nullptr);
+}
+
+TEST(Containers2, MappedVectorMissingFile) {
+    ASSERT_THROW(MappedVector<const int>{ std::filesystem::temp_directory_path() / "containers2_mapped_missing.bin" }, std::system_error);
+    const MappedFile file{ "containers2_mapped_mode.bin", 4 };
+    ASSERT_THROW((MappedVector<std::uint32_t>{ file.path, MapMode::read_only }), std::invalid_argument);
+}
+
+TEST(Containers2, MappedVectorCopyOnWrite) {
+    const MappedFile file{ "containers2_mapped_copy_on_write.bin", 16 };
+    {
+        MappedVector<std::uint32_t> mapped{ file.path, MapMode::copy_on_write };
+        VectorView<std::uint32_t> view{ mapped };
+        view[3] = 42;
+        ASSERT_EQ(mapped[3], 42);
+    }
+    ASSERT_EQ(file.read(3), 3);
+}
+
+TEST(Containers2, MappedVectorShared) {
+    const MappedFile file{ "containers2_mapped_shared.bin", 16 };
+    {
+        MappedVector<std::uint32_t> mapped{ file.path, MapMode::shared };
+        mapped[5] = 42;
+        mapped.sync();
+        ASSERT_EQ(file.read(5), 42);
+
+        // moving into a read-only owner keeps the same mapping
+        MappedVector<const std::uint32_t> read_only{ std::move(mapped) };
+        ASSERT_EQ(mapped.data(), nullptr);
+        ASSERT_EQ(read_only[5], 42);
+        ASSERT_EQ(read_only[6], 6);
+    }
+    ASSERT_EQ(file.read(5), 42);
+}
+
+TEST(Containers2, MappedVectorCreate) {
+    const MappedFile file{ "containers2_mapped_create.bin", 1 };
+    {
+        MappedVector<std::uint32_t> mapped{ file.path, 1000 };
+        ASSERT_EQ(mapped.size(), 1000);
+        ASSERT_EQ(mapped[0], 0);
+        for (std::uint32_t i = 0; i < mapped.size(); ++i) {
+            mapped[i] = 2 * i;
+        }
+    }
+    ASSERT_EQ(std::filesystem::file_size(file.path), 1000 * sizeof(std::uint32_t));
+    MappedVector<const std::uint32_t> mapped{ file.path };
+    ASSERT_EQ(mapped[999], 1998);
+
+    MappedVector<const std::uint32_t> other{};
+    other = std::move(mapped);
+    ASSERT_EQ(other[10], 20);
+    ASSERT_EQ(mapped.size(), 0);
+}
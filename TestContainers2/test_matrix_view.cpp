@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <Containers2/matrix_view.hpp>
+#include <numeric>
+#include <stdexcept>
+
+using namespace containers2;
+
+// strided and matrix views are trivially copyable, with the same decoupled constness as VectorView
+static_assert(std::is_trivially_copyable_v<StridedView<const int>>);
+static_assert(std::is_trivially_copyable_v<StridedView<int, 3>>);
+static_assert(std::is_trivially_copyable_v<MatrixView<const int>>);
+static_assert(std::is_trivially_copyable_v<MatrixView<int>>);
+static_assert(std::is_trivially_constructible_v<MatrixView<const int>, const MatrixView<int>&>);
+static_assert(!std::is_constructible_v<MatrixView<int>, const MatrixView<const int>&>);
+static_assert(std::is_trivially_constructible_v<StridedView<const int, 2>, const StridedView<int, 2>&>);
+static_assert(!std::is_constructible_v<StridedView<int, 2>, const StridedView<const int, 2>&>);
+// views cannot be built from temporary owners
+static_assert(!std::is_constructible_v<MatrixView<int>, Vector<int>&&, size_t, size_t>);
+static_assert(std::is_constructible_v<MatrixView<int>, Vector<int>&, size_t, size_t>);
+static_assert(!std::is_constructible_v<StridedView<int>, Vector<int>&&>);
+
+static Vector<int> iota(size_t s)
+{
+    Vector<int> vector{ s, uninitialized_tag };
+    std::iota(vector.begin(), vector.end(), 0);
+    return vector;
+}
+
+TEST(Containers2, MatrixViewAccess) {
+    Vector<int> vector = iota(12);
+    const MatrixView<int> matrix{ vector, 3, 4 };
+    ASSERT_EQ(matrix.rows(), 3);
+    ASSERT_EQ(matrix.columns(), 4);
+    ASSERT_EQ(matrix(1, 2), 6);
+
+    VectorView<int> row = matrix.row(2);
+    ASSERT_EQ(row.size(), 4);
+    ASSERT_EQ(row[0], 8);
+    row[1] = 42;
+    ASSERT_EQ(vector[9], 42);
+
+    const StridedView<int> column = matrix.column(1);
+    ASSERT_EQ(column.size(), 3);
+    ASSERT_EQ(column[0], 1);
+    ASSERT_EQ(column[1], 5);
+    ASSERT_EQ(column[2], 42);
+    column[0] = 24;
+    ASSERT_EQ(vector[1], 24);
+
+    const MatrixView<const int> const_matrix{ matrix };
+    const VectorView<const int> const_row = const_matrix.row(0);
+    ASSERT_EQ(const_row[1], 24);
+}
+
+TEST(Containers2, MatrixViewBlock) {
+    Vector<int> vector = iota(30);
+    const MatrixView<int> matrix{ vector, 5, 6 };
+    const MatrixView<int> block = matrix.block(1, 2, 3, 2);
+    ASSERT_EQ(block.rows(), 3);
+    ASSERT_EQ(block.columns(), 2);
+    ASSERT_EQ(block.row_stride(), 6);
+    ASSERT_EQ(block(0, 0), 8);
+    ASSERT_EQ(block(2, 1), 21);
+    ASSERT_EQ(block.row(1).size(), 2);
+    ASSERT_EQ(block.row(1)[1], 15);
+    ASSERT_EQ(block.column(1)[2], 21);
+    block(1, 0) = -1;
+    ASSERT_EQ(vector[14], -1);
+
+    const MatrixView<int> inner = block.block(1, 1, 2, 1);
+    ASSERT_EQ(inner(0, 0), 15);
+    ASSERT_EQ(inner(1, 0), 21);
+}
+
+TEST(Containers2, StridedViewSlicing) {
+    Vector<int> vector = iota(24);
+    const StridedView<int, 3> tensor{ vector.data(), { 2, 3, 4 }, { 12, 4, 1 } };
+    ASSERT_EQ(tensor.size(), 24);
+    ASSERT_TRUE(tensor.is_contiguous());
+    ASSERT_EQ(tensor(1, 2, 3), 23);
+    ASSERT_EQ(tensor(0, 1, 2), 6);
+
+    const StridedView<int, 2> plane = tensor.at(0, 1);
+    ASSERT_EQ(plane.extent(0), 3);
+    ASSERT_EQ(plane.extent(1), 4);
+    ASSERT_EQ(plane(0, 0), 12);
+    ASSERT_EQ(plane(2, 1), 21);
+
+    const StridedView<int, 2> transposed = plane.transposed();
+    ASSERT_FALSE(transposed.is_contiguous());
+    ASSERT_EQ(transposed(1, 2), 21);
+
+    const StridedView<int, 3> sliced = tensor.slice(2, 1, 3);
+    ASSERT_EQ(sliced.extent(2), 2);
+    ASSERT_FALSE(sliced.is_contiguous());
+    ASSERT_EQ(sliced(0, 0, 0), 1);
+    ASSERT_EQ(sliced(1, 2, 1), 22);
+
+    const StridedView<int, 3> stepped = tensor.step(2, 3);
+    ASSERT_EQ(stepped.extent(2), 2);
+    ASSERT_EQ(stepped(0, 0, 1), 3);
+    stepped(1, 1, 1) = -5;
+    ASSERT_EQ(vector[19], -5);
+    ASSERT_THROW(tensor.step(2, 0), std::invalid_argument);
+
+    const StridedView<int> reversed{ vector.data() + 23, { 24 }, { -1 } };
+    ASSERT_EQ(reversed[0], 23);
+    ASSERT_EQ(reversed[23], 0);
+
+    const StridedView<const int> from_view{ VectorView<const int>{ vector } };
+    ASSERT_TRUE(from_view.is_contiguous());
+    ASSERT_EQ(from_view[5], 5);
+}
+
+TEST(Containers2, MatrixViewTiles) {
+    Vector<int> vector{ 7 * 10, 0, initialized_tag };
+    const MatrixView<int> matrix{ vector, 7, 10 };
+    size_t tiles = 0;
+    for_each_tile(matrix, 3, 4, [&](size_t row, size_t column, MatrixView<int> tile) {
+        ASSERT_EQ(tile.rows(), std::min<size_t>(3, 7 - row));
+        ASSERT_EQ(tile.columns(), std::min<size_t>(4, 10 - column));
+        for (size_t r = 0; r < tile.rows(); ++r) {
+            for (size_t c = 0; c < tile.columns(); ++c) {
+                tile(r, c) += 1;
+            }
+        }
+        ++tiles;
+    });
+    ASSERT_EQ(tiles, 9);
+    ASSERT_TRUE(std::all_of(vector.begin(), vector.end(), [](int x) { return x == 1; }));
+
+    // tiles of no rows or no columns would never advance
+    ASSERT_THROW(for_each_tile(matrix, 0, 4, [](size_t, size_t, MatrixView<int>) {}), std::invalid_argument);
+    ASSERT_THROW(for_each_tile(matrix, 3, 0, [](size_t, size_t, MatrixView<int>) {}), std::invalid_argument);
+}
+
+TEST(Containers2, MatrixViewTranspose) {
+    for (size_t tile : { 1, 3, 64 }) {
+        const Vector<int> source = iota(37 * 53);
+        Vector<int> target{ 37 * 53, -1, initialized_tag };
+        const MatrixView<const int> src{ source, 37, 53 };
+        const MatrixView<int> dst{ target, 53, 37 };
+        transpose(src, dst, tile);
+        for (size_t r = 0; r < src.rows(); ++r) {
+            for (size_t c = 0; c < src.columns(); ++c) {
+                ASSERT_EQ(dst(c, r), src(r, c));
+            }
+        }
+
+        Vector<int> square = iota(45 * 45);
+        const MatrixView<int> matrix{ square, 45, 45 };
+        transpose_in_place(matrix, tile);
+        for (size_t r = 0; r < 45; ++r) {
+            for (size_t c = 0; c < 45; ++c) {
+                ASSERT_EQ(matrix(r, c), static_cast<int>(c * 45 + r));
+            }
+        }
+    }
+}
+
+TEST(Containers2, MatrixViewTransposeInvalid) {
+    Vector<int> vector = iota(6 * 4);
+    const Vector<int> untouched = iota(6 * 4);
+    // not square: the swaps would leave the block
+    ASSERT_THROW(transpose_in_place(MatrixView<int>{ vector, 6, 4 }, 2), std::invalid_argument);
+    ASSERT_THROW(transpose_in_place(MatrixView<int>{ vector, 4, 6 }), std::invalid_argument);
+    ASSERT_THROW(transpose_in_place(MatrixView<int>{ vector, 4, 4 }, 0), std::invalid_argument);
+    ASSERT_TRUE(std::equal(vector.begin(), vector.end(), untouched.begin(), untouched.end()));
+
+    Vector<int> target{ 6 * 4, 0, initialized_tag };
+    ASSERT_THROW(transpose(MatrixView<const int>{ vector, 6, 4 }, MatrixView<int>{ target, 6, 4 }), std::invalid_argument);
+    ASSERT_THROW(transpose(MatrixView<const int>{ vector, 6, 4 }, MatrixView<int>{ target, 4, 6 }, 0), std::invalid_argument);
+}
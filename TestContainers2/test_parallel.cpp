@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <Containers2/parallel.hpp>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+using namespace containers2;
+
+// chunks are handed around by value, like the views they cut
+static_assert(std::is_trivially_copyable_v<Chunks<int>>);
+static_assert(std::is_trivially_copyable_v<Chunks<const double>>);
+
+TEST(Containers2, SplitBalanced) {
+    Vector<int> v(10, 0);
+    const auto chunks = split(VectorView<int>{ v }, 3);
+    ASSERT_EQ(chunks.size(), 3);
+    ASSERT_EQ(chunks[0].size(), 3);
+    ASSERT_EQ(chunks[1].size(), 3);
+    ASSERT_EQ(chunks[2].size(), 4);
+    ASSERT_EQ(chunks[0].begin(), v.begin());
+    ASSERT_EQ(chunks[2].end(), v.end());
+
+    // more chunks than elements: some are empty, together they still cover the view
+    const auto tiny = split(VectorView<int>{ v.begin(), v.begin() + 2 }, 5);
+    size_t total = 0;
+    for (size_t i = 0; i < tiny.size(); ++i) {
+        ASSERT_EQ(tiny[i].begin(), v.begin() + tiny.boundary(i));
+        total += tiny[i].size();
+    }
+    ASSERT_EQ(total, 2);
+}
+
+TEST(Containers2, SplitAligned) {
+    Vector<std::int32_t> v(10000, 0);
+    // start the view off a cache line
+    const VectorView<std::int32_t> view{ v.begin() + 3, v.end() };
+    const auto chunks = split_aligned(view, 7);
+    size_t total = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (i != 0) {
+            ASSERT_EQ(reinterpret_cast<std::uintptr_t>(chunks[i].data()) % cache_line_size, 0);
+            ASSERT_EQ(chunks[i].begin(), chunks[i - 1].end());
+        }
+        total += chunks[i].size();
+    }
+    ASSERT_EQ(total, view.size());
+}
+
+TEST(Containers2, ThreadPoolRun) {
+    ThreadPool pool{ 4 };
+    ASSERT_EQ(pool.concurrency(), 4);
+
+    std::atomic<size_t> sum{ 0 };
+    pool.run(1000, [&](size_t i) { sum += i; });
+    ASSERT_EQ(sum, 999 * 1000 / 2);
+
+    // nested runs are executed by the waiting threads instead of deadlocking
+    std::atomic<size_t> count{ 0 };
+    pool.run(8, [&](size_t) {
+        pool.run(8, [&](size_t) { ++count; });
+    });
+    ASSERT_EQ(count, 64);
+
+    ASSERT_THROW(pool.run(16, [](size_t i) { if (i == 5) throw std::runtime_error("task"); }), std::runtime_error);
+
+    // a pool without workers runs everything on the calling thread
+    ThreadPool single{ 1 };
+    ASSERT_EQ(single.concurrency(), 1);
+    size_t calls = 0;
+    single.run(10, [&](size_t) { ++calls; });
+    ASSERT_EQ(calls, 10);
+}
+
+TEST(Containers2, ParallelForEachTransform) {
+    ThreadPool pool{ 4 };
+    Vector<int> v(100000, 1);
+    parallel::for_each(VectorView<int>{ v }, [](int& x) { x *= 3; }, pool);
+    ASSERT_EQ(std::count(v.begin(), v.end(), 3), 100000);
+
+    Vector<double> out(100000, 0.0);
+    parallel::transform(VectorView<const int>{ v }, VectorView<double>{ out }, [](int x) { return x * 0.5; }, pool);
+    ASSERT_EQ(std::count(out.begin(), out.end(), 1.5), 100000);
+
+    // in place
+    parallel::transform(VectorView<const int>{ v }, VectorView<int>{ v }, [](int x) { return x + 1; }, pool);
+    ASSERT_EQ(std::count(v.begin(), v.end(), 4), 100000);
+}
+
+// chunks on huge pages, at any offset
+TEST(Containers2, ParallelFill) {
+    ThreadPool pool{ 4 };
+    for (size_t n : { size_t{ 0 }, size_t{ 1 }, size_t{ 1000 }, 5 * huge_page_size / sizeof(std::int64_t) + 3 }) {
+        Vector<std::int64_t> v(n, std::int64_t{ 0 });
+        const size_t first = std::min<size_t>(n, 1);
+        parallel::fill(VectorView<std::int64_t>{ v.begin() + first, v.end() }, std::int64_t{ 9 }, pool);
+        ASSERT_EQ(std::count(v.begin(), v.end(), 9), static_cast<std::ptrdiff_t>(n - first)) << "size " << n;
+        ASSERT_TRUE(n == 0 || v[0] == 0);
+    }
+}
+
+TEST(Containers2, ParallelCopy) {
+    ThreadPool pool{ 4 };
+    Vector<std::int64_t> in{ 300001, uninitialized_tag };
+    std::iota(in.begin(), in.end(), std::int64_t{ -5 });
+    for (CopyMode mode : { CopyMode::automatic, CopyMode::cached, CopyMode::streaming }) {
+        Vector<std::int64_t> out(in.size(), 0);
+        parallel::copy(VectorView<const std::int64_t>{ in }, VectorView<std::int64_t>{ out }, mode, pool);
+        ASSERT_TRUE(std::equal(in.begin(), in.end(), out.begin(), out.end()));
+    }
+    // smaller than a chunk, and empty
+    Vector<std::int64_t> few(3, 0);
+    parallel::copy(VectorView<const std::int64_t>{ in.begin(), in.begin() + 3 }, VectorView<std::int64_t>{ few }, CopyMode::streaming, pool);
+    ASSERT_EQ(few[2], -3);
+    parallel::copy(VectorView<const std::int64_t>{}, VectorView<std::int64_t>{}, CopyMode::automatic, pool);
+}
+
+TEST(Containers2, ParallelReduce) {
+    Vector<std::int64_t> v{ 1000000, uninitialized_tag };
+    std::iota(v.begin(), v.end(), 0);
+    ThreadPool pool{ 4 };
+    ASSERT_EQ(parallel::reduce(VectorView<const std::int64_t>{ v }, std::int64_t{ 0 }, std::plus<>{}, pool), 999999ll * 1000000 / 2);
+    ASSERT_EQ(parallel::reduce(VectorView<const std::int64_t>{ v }, std::int64_t{ 5 }, [](auto a, auto b) { return std::max(a, b); }, pool), 999999);
+    ASSERT_EQ(parallel::reduce(VectorView<const std::int64_t>{}, std::int64_t{ 7 }, std::plus<>{}, pool), 7);
+
+    // floating point sums: bit-identical whatever the number of threads
+    Vector<double> d{ 1000000, uninitialized_tag };
+    std::mt19937_64 random{ 42 };
+    std::uniform_real_distribution<double> distribution{ -1e6, 1e6 };
+    for (auto& x : d) {
+        x = distribution(random);
+    }
+    ThreadPool one{ 1 };
+    ThreadPool three{ 3 };
+    const double reference = parallel::reduce(VectorView<const double>{ d }, 0.0, std::plus<>{}, deterministic_tag, one);
+    ASSERT_EQ(parallel::reduce(VectorView<const double>{ d }, 0.0, std::plus<>{}, deterministic_tag, pool), reference);
+    ASSERT_EQ(parallel::reduce(VectorView<const double>{ d }, 0.0, std::plus<>{}, deterministic_tag, three), reference);
+}
+
+TEST(Containers2, ParallelInclusiveScan) {
+    ThreadPool pool{ 4 };
+    Vector<std::int64_t> v{ 300001, uninitialized_tag };
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = static_cast<std::int64_t>(i % 7);
+    }
+    Vector<std::int64_t> expected{ v.size(), uninitialized_tag };
+    std::inclusive_scan(v.begin(), v.end(), expected.begin());
+
+    Vector<std::int64_t> out(v.size(), std::int64_t{ 0 });
+    parallel::inclusive_scan(VectorView<const std::int64_t>{ v }, VectorView<std::int64_t>{ out }, std::plus<>{}, pool);
+    ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+
+    // in place
+    parallel::inclusive_scan(VectorView<const std::int64_t>{ v }, VectorView<std::int64_t>{ v }, std::plus<>{}, pool);
+    ASSERT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+
+    // fewer elements than chunks
+    Vector<int> small{ 1, 2, 3 };
+    parallel::inclusive_scan(VectorView<const int>{ small }, VectorView<int>{ small }, std::plus<>{}, pool);
+    ASSERT_EQ(small[2], 6);
+}
+
+TEST(Containers2, ParallelSort) {
+    ThreadPool pool{ 4 };
+    Vector<std::uint32_t> v{ 500000, uninitialized_tag };
+    std::mt19937 random{ 7 };
+    for (auto& x : v) {
+        x = random();
+    }
+    parallel::sort(VectorView<std::uint32_t>{ v }, std::less<>{}, pool);
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+
+    parallel::sort(VectorView<std::uint32_t>{ v }, std::greater<>{}, pool);
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end(), std::greater<>{}));
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <Containers2/ring_buffer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace containers2;
+
+// ring buffers: same copy/move rules as Vector
+static_assert(!std::is_copy_constructible_v<SpscRingBuffer<int>>);
+static_assert(!std::is_copy_assignable_v<SpscRingBuffer<int>>);
+static_assert(std::is_nothrow_move_constructible_v<SpscRingBuffer<int>>);
+static_assert(std::is_nothrow_move_assignable_v<SpscRingBuffer<int>>);
+static_assert(!std::is_copy_constructible_v<MpmcRingBuffer<int>>);
+static_assert(!std::is_copy_assignable_v<MpmcRingBuffer<int>>);
+static_assert(std::is_nothrow_move_constructible_v<MpmcRingBuffer<int>>);
+static_assert(std::is_nothrow_move_assignable_v<MpmcRingBuffer<int>>);
+
+template<typename Queue>
+void single_thread_checks()
+{
+    Queue q{ 5 };
+    ASSERT_EQ(q.capacity(), 8);
+    // head and tail never share a cache line
+    ASSERT_GE(static_cast<size_t>(reinterpret_cast<const char*>(&q.tail_) - reinterpret_cast<const char*>(&q.head_)), cache_line_size);
+    ASSERT_TRUE(q.empty());
+    ASSERT_FALSE(q.try_pop().has_value());
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(q.try_push(i));
+    }
+    ASSERT_FALSE(q.try_push(8));
+    ASSERT_EQ(q.size(), 8);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(q.try_pop(), i);
+    }
+
+    // 5 free slots starting at index 0 + 8 = 0: contiguous
+    auto push = q.reserve_push(100);
+    ASSERT_EQ(push.size(), 5);
+    ASSERT_EQ(push.first.size(), 5);
+    ASSERT_EQ(push.second.size(), 0);
+    for (size_t i = 0; i < push.size(); ++i) {
+        push.first[i] = static_cast<int>(8 + i);
+    }
+    q.commit_push(push);
+    ASSERT_EQ(q.size(), 8);
+
+    // 8 filled slots starting at index 5: they wrap around
+    auto pop = q.reserve_pop(100);
+    ASSERT_EQ(pop.size(), 8);
+    ASSERT_EQ(pop.first.size(), 3);
+    ASSERT_EQ(pop.second.size(), 5);
+    ASSERT_EQ(pop.first[0], 5);
+    ASSERT_EQ(pop.second[0], 8);
+    ASSERT_EQ(pop.second[4], 12);
+    ASSERT_EQ(pop.second.data(), pop.first.data() - 5);
+    q.commit_pop(pop);
+    ASSERT_TRUE(q.empty());
+
+    Queue moved{ std::move(q) };
+    ASSERT_EQ(q.capacity(), 0);
+    ASSERT_FALSE(q.try_push(1));
+    ASSERT_TRUE(moved.try_push(1));
+    ASSERT_EQ(moved.try_pop(), 1);
+}
+
+TEST(Containers2, SpscRingBuffer) {
+    single_thread_checks<SpscRingBuffer<int>>();
+
+    SpscRingBuffer<std::string> strings{ 2 };
+    ASSERT_TRUE(strings.try_push("a long string that does not fit the small string buffer"));
+    ASSERT_EQ(strings.try_pop(), "a long string that does not fit the small string buffer");
+}
+
+TEST(Containers2, MpmcRingBuffer) {
+    single_thread_checks<MpmcRingBuffer<int>>();
+}
+
+TEST(Containers2, SpscRingBufferStress) {
+    constexpr std::uint64_t count = 200000;
+    SpscRingBuffer<std::uint64_t> q{ 64 };
+    std::thread producer{ [&] {
+        std::uint64_t next = 0;
+        while (next < count) {
+            // alternate single pushes and batches
+            if (next % 2 == 0) {
+                if (q.try_push(next)) {
+                    ++next;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            auto reservation = q.reserve_push(std::min<std::uint64_t>(17, count - next));
+            for (auto* span : { &reservation.first, &reservation.second }) {
+                for (auto& slot : *span) {
+                    slot = next++;
+                }
+            }
+            q.commit_push(reservation);
+            if (reservation.size() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    } };
+    std::uint64_t expected = 0;
+    while (expected < count) {
+        auto reservation = q.reserve_pop(13);
+        for (auto* span : { &reservation.first, &reservation.second }) {
+            for (auto value : *span) {
+                ASSERT_EQ(value, expected++);
+            }
+        }
+        q.commit_pop(reservation);
+        if (auto value = q.try_pop()) {
+            ASSERT_EQ(*value, expected++);
+        }
+        else if (reservation.size() == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(Containers2, MpmcRingBufferStress) {
+    constexpr size_t producers = 4;
+    constexpr size_t consumers = 4;
+    constexpr size_t per_producer = 50000;
+    MpmcRingBuffer<std::uint32_t> q{ 128 };
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    std::atomic<size_t> consumed{ 0 };
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            size_t next = p * per_producer;
+            const size_t end = next + per_producer;
+            while (next < end) {
+                if (next % 3 == 0) {
+                    if (q.try_push(static_cast<std::uint32_t>(next))) {
+                        ++next;
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                    continue;
+                }
+                auto reservation = q.reserve_push(std::min<size_t>(7, end - next));
+                for (auto* span : { &reservation.first, &reservation.second }) {
+                    for (auto& slot : *span) {
+                        slot = static_cast<std::uint32_t>(next++);
+                    }
+                }
+                q.commit_push(reservation);
+                if (reservation.size() == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            while (consumed.load() < producers * per_producer) {
+                if (c % 2 == 0) {
+                    if (auto value = q.try_pop()) {
+                        seen[*value].fetch_add(1);
+                        consumed.fetch_add(1);
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                    continue;
+                }
+                auto reservation = q.reserve_pop(5);
+                for (auto* span : { &reservation.first, &reservation.second }) {
+                    for (auto value : *span) {
+                        seen[value].fetch_add(1);
+                    }
+                }
+                q.commit_pop(reservation);
+                consumed.fetch_add(reservation.size());
+                if (reservation.size() == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(q.empty());
+    for (auto& s : seen) {
+        ASSERT_EQ(s.load(), 1);
+    }
+}
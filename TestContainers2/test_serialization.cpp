@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include <Containers2/serialization.hpp>
+#include <Containers2/mapped_vector.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+using namespace containers2;
+
+// serialized arrays are only read in place, at their address in the buffer
+static_assert(!std::is_copy_constructible_v<SerializedVector<int>>);
+static_assert(!std::is_copy_assignable_v<SerializedVector<int>>);
+static_assert(sizeof(SerializedVector<SerializedVector<double>>) == 16);
+static_assert(!std::is_copy_constructible_v<SerialWriter>);
+
+// leaves are trivially copyable, handles only nest
+static_assert(Serializable<int> && Serializable<double> && Serializable<std::byte>);
+static_assert(!Serializable<SerialHandle<int>> && !Serializable<Vector<int>>);
+
+namespace {
+    Vector<std::byte> bytes(const std::string& s)
+    {
+        Vector<std::byte> result(s.size(), uninitialized_tag);
+        std::memcpy(result.data(), s.data(), s.size());
+        return result;
+    }
+
+    // rows of i + 1 values i * 1000 + j
+    std::string matrix(size_t rows)
+    {
+        std::ostringstream out;
+        SerialWriter writer{ out };
+        Vector<SerialHandle<std::uint32_t>> handles(rows, uninitialized_tag);
+        for (size_t i = 0; i < rows; ++i) {
+            Vector<std::uint32_t> row(i + 1, uninitialized_tag);
+            for (size_t j = 0; j <= i; ++j) {
+                row[j] = static_cast<std::uint32_t>(i * 1000 + j);
+            }
+            handles[i] = writer.write<std::uint32_t>(row);
+        }
+        writer.finish(writer.write<std::uint32_t>(handles));
+        return out.str();
+    }
+
+    template<typename T>
+    void assert_invalid(const Vector<std::byte>& buffer)
+    {
+        ASSERT_THROW(open_serialized<T>(buffer), SerializationError);
+    }
+}
+
+TEST(Containers2, SerializationRoundTrip) {
+    std::ostringstream out;
+    SerialWriter writer{ out };
+    const double values[]{ 1.5, -2.25, 3.0 };
+    writer.finish(writer.write<double>(values));
+    ASSERT_EQ(writer.bytes_written(), out.str().size());
+    ASSERT_EQ(out.str().size() % serial_alignment, 0);
+
+    const Vector<std::byte> buffer = bytes(out.str());
+    const SerializedVector<double>& root = open_serialized<double>(buffer);
+    ASSERT_EQ(root.size(), 3);
+    ASSERT_EQ(root[1], -2.25);
+    // read in place
+    ASSERT_GE(reinterpret_cast<const std::byte*>(root.data()), buffer.data());
+    ASSERT_LT(reinterpret_cast<const std::byte*>(root.data()), buffer.data() + buffer.size());
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(root.data()) % serial_alignment, 0);
+    const VectorView<const double> view = root.view();
+    ASSERT_TRUE(std::equal(view.begin(), view.end(), std::begin(values), std::end(values)));
+
+    // relative offsets: a copy of the buffer opens the same, at its own address
+    Vector<std::byte> copy(buffer.size(), uninitialized_tag);
+    std::copy(buffer.begin(), buffer.end(), copy.begin());
+    const SerializedVector<double>& copied = open_serialized_trusted<double>(copy);
+    ASSERT_EQ(copied[2], 3.0);
+    ASSERT_GE(reinterpret_cast<const std::byte*>(copied.data()), copy.data());
+
+    // empty arrays
+    std::ostringstream empty_out;
+    SerialWriter empty_writer{ empty_out };
+    empty_writer.finish(empty_writer.write<int>(VectorView<const int>{}));
+    const Vector<std::byte> empty = bytes(empty_out.str());
+    ASSERT_TRUE(open_serialized<int>(empty).empty());
+}
+
+TEST(Containers2, SerializationNested) {
+    const Vector<std::byte> buffer = bytes(matrix(100));
+    const SerializedVector<SerializedVector<std::uint32_t>>& rows = open_serialized<SerializedVector<std::uint32_t>>(buffer);
+    ASSERT_EQ(rows.size(), 100);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const VectorView<const std::uint32_t> row = rows[i].view();
+        ASSERT_EQ(row.size(), i + 1);
+        for (size_t j = 0; j <= i; ++j) {
+            ASSERT_EQ(row[j], i * 1000 + j);
+        }
+    }
+
+    // three levels, a shared child, and an array streamed in chunks
+    std::ostringstream out;
+    SerialWriter writer{ out };
+    const char hello[]{ 'h', 'e', 'l', 'l', 'o' };
+    const char world[]{ 'w', 'o', 'r', 'l', 'd' };
+    const SerialHandle<char> words[]{ writer.write<char>(hello), writer.write<char>(world) };
+    const SerialHandle<SerializedVector<char>> sentence = writer.write<char>(words);
+    writer.begin_array();
+    for (int chunk = 0; chunk < 4; ++chunk) {
+        const SerialHandle<SerializedVector<char>> chunk_handles[]{ sentence, sentence, sentence };
+        writer.append<SerializedVector<char>>(chunk_handles);
+    }
+    writer.finish(writer.end_array<SerializedVector<SerializedVector<char>>>());
+    const Vector<std::byte> nested = bytes(out.str());
+
+    // 12 references to the sentence and 24 to the words: more than the 16 references the buffer can hold, only the
+    // trusted open accepts them
+    ASSERT_THROW(open_serialized<SerializedVector<SerializedVector<char>>>(nested), SerializationError);
+    const auto& sentences = open_serialized_trusted<SerializedVector<SerializedVector<char>>>(nested);
+    ASSERT_EQ(sentences.size(), 12);
+    for (const auto& s : sentences) {
+        ASSERT_EQ(s.size(), 2);
+        ASSERT_EQ(std::string(s[0].begin(), s[0].end()), "hello");
+        ASSERT_EQ(std::string(s[1].begin(), s[1].end()), "world");
+    }
+}
+
+// every level references the level below n times: the references to walk grow as n^depth, the buffer as n * depth
+TEST(Containers2, SerializationSharedArrays) {
+    for (size_t n : { 1, 2, 40000 }) {
+        std::ostringstream out;
+        SerialWriter writer{ out };
+        const std::uint32_t leaf_values[]{ 1, 2, 3 };
+        const SerialHandle<std::uint32_t> leaf = writer.write<std::uint32_t>(leaf_values);
+        const Vector<SerialHandle<std::uint32_t>> leaves(n, leaf, initialized_tag);
+        const SerialHandle<SerializedVector<std::uint32_t>> middle = writer.write<std::uint32_t>(leaves);
+        const Vector<SerialHandle<SerializedVector<std::uint32_t>>> middles(n, middle, initialized_tag);
+        writer.finish(writer.write<SerializedVector<std::uint32_t>>(middles));
+        const Vector<std::byte> buffer = bytes(out.str());
+
+        using Root = SerializedVector<SerializedVector<std::uint32_t>>;
+        if (n * n + n <= (buffer.size() - 64) / 16) {
+            ASSERT_EQ(open_serialized<Root>(buffer)[n - 1][n - 1][2], 3u);
+        }
+        else {
+            assert_invalid<Root>(buffer);
+        }
+        ASSERT_EQ(open_serialized_trusted<Root>(buffer)[n - 1][n - 1][2], 3u);
+    }
+}
+
+TEST(Containers2, SerializationWriterMisuse) {
+    std::ostringstream out;
+    SerialWriter writer{ out };
+    const int values[]{ 1, 2 };
+    ASSERT_THROW(writer.append<int>(values), std::logic_error);
+    ASSERT_THROW(writer.end_array<int>(), std::logic_error);
+    writer.begin_array();
+    ASSERT_THROW(writer.begin_array(), std::logic_error);
+    ASSERT_THROW(writer.finish(SerialHandle<int>{}), std::logic_error);
+    writer.append<int>(values);
+    const SerialHandle<int> handle = writer.end_array<int>();
+    ASSERT_EQ(handle.size, 2);
+    writer.finish(handle);
+    ASSERT_THROW(writer.write<int>(values), std::logic_error);
+
+    // stream failures
+    std::ostringstream failed;
+    failed.setstate(std::ios::badbit);
+    ASSERT_THROW(SerialWriter{ failed }, SerializationError);
+}
+
+TEST(Containers2, SerializationValidation) {
+    using Rows = SerializedVector<std::uint32_t>;
+    const Vector<std::byte> valid = bytes(matrix(10));
+    ASSERT_NO_THROW(open_serialized<Rows>(valid));
+
+    auto corrupt = [&](size_t offset, auto value) {
+        Vector<std::byte> buffer(valid.size(), uninitialized_tag);
+        std::copy(valid.begin(), valid.end(), buffer.begin());
+        std::memcpy(buffer.data() + offset, &value, sizeof(value));
+        return buffer;
+    };
+    const size_t footer = valid.size() - 48;
+
+    // header and footer
+    assert_invalid<Rows>(corrupt(0, 'X'));
+    assert_invalid<Rows>(corrupt(8, std::uint32_t{ serial_version + 1 }));
+    assert_invalid<Rows>(corrupt(valid.size() - 1, 'X'));
+    assert_invalid<Rows>(corrupt(footer + 16, std::uint64_t{ valid.size() + 16 }));
+    // another root type
+    assert_invalid<std::uint32_t>(valid);
+    assert_invalid<SerializedVector<std::uint64_t>>(valid);
+    assert_invalid<SerializedVector<Rows>>(valid);
+
+    // truncated
+    Vector<std::byte> truncated(valid.size() - 16, uninitialized_tag);
+    std::copy(valid.begin(), valid.begin() + truncated.size(), truncated.begin());
+    assert_invalid<Rows>(truncated);
+    assert_invalid<Rows>(Vector<std::byte>(8, std::byte{ 0 }));
+
+    // misaligned buffer
+    Vector<std::byte> shifted(valid.size() + 1, uninitialized_tag);
+    std::copy(valid.begin(), valid.end(), shifted.begin() + 1);
+    ASSERT_THROW(open_serialized<Rows>(VectorView<const std::byte>{ shifted.data() + 1, shifted.data() + shifted.size() }), SerializationError);
+
+    // the root array: out of the buffer, into the header, too long, or misaligned
+    assert_invalid<Rows>(corrupt(footer, std::int64_t{ 16 }));
+    assert_invalid<Rows>(corrupt(footer, -static_cast<std::int64_t>(footer)));
+    assert_invalid<Rows>(corrupt(footer, std::numeric_limits<std::int64_t>::min()));
+    assert_invalid<Rows>(corrupt(footer + 8, std::uint64_t{ 1000 }));
+    assert_invalid<Rows>(corrupt(footer + 8, std::numeric_limits<std::uint64_t>::max()));
+    {
+        std::int64_t root = 0;
+        std::memcpy(&root, valid.data() + footer, sizeof(root));
+        assert_invalid<Rows>(corrupt(footer, root + 4));
+
+        // a nested array: its first row
+        const size_t row = static_cast<size_t>(static_cast<std::int64_t>(footer) + root);
+        std::int64_t offset = 0;
+        std::memcpy(&offset, valid.data() + row, sizeof(offset));
+        const Vector<std::byte> shifted_row = corrupt(row, offset + 4);
+        ASSERT_NO_THROW(open_serialized<Rows>(shifted_row));
+        assert_invalid<Rows>(corrupt(row, offset + 2));
+        assert_invalid<Rows>(corrupt(row, std::int64_t{ 1 } << 40));
+        assert_invalid<Rows>(corrupt(row + 8, std::uint64_t{ 1 } << 62));
+        // the trusted open does not look at the arrays
+        const Vector<std::byte> long_row = corrupt(row + 8, std::uint64_t{ 1 } << 62);
+        ASSERT_NO_THROW(open_serialized_trusted<Rows>(long_row));
+    }
+}
+
+TEST(Containers2, SerializationMapped) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "containers2_serialized.bin";
+    {
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        SerialWriter writer{ file };
+        Vector<SerialHandle<std::uint64_t>> handles(50, uninitialized_tag);
+        for (size_t i = 0; i < handles.size(); ++i) {
+            const Vector<std::uint64_t> row(i * 100, i);
+            handles[i] = writer.write<std::uint64_t>(row);
+        }
+        writer.finish(writer.write<std::uint64_t>(handles));
+    }
+    {
+        const MappedVector<const std::byte> mapped{ path };
+        const auto& rows = open_serialized<SerializedVector<std::uint64_t>>(mapped);
+        ASSERT_EQ(rows.size(), 50);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            ASSERT_EQ(rows[i].size(), i * 100);
+            ASSERT_TRUE(std::all_of(rows[i].begin(), rows[i].end(), [i](std::uint64_t v) { return v == i; }));
+        }
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <Containers2/simd.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace containers2;
+
+template<typename T>
+struct Containers2Simd : testing::Test
+{
+    // every instruction set up to the one of the running CPU
+    static std::vector<simd::Isa> isas()
+    {
+        std::vector<simd::Isa> result;
+        for (auto isa : { simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512 }) {
+            if (isa <= simd::detected_isa()) {
+                result.push_back(isa);
+            }
+        }
+        return result;
+    }
+
+    // small values keep floating point sums exact, so every instruction set must match the reference bit for bit
+    static Vector<T> make(size_t s, size_t seed)
+    {
+        Vector<T> vector{ s + 1, uninitialized_tag, aligned_memory_resource<64>() };
+        for (size_t i = 0; i < vector.size(); ++i) {
+            vector[i] = static_cast<T>((i * 7 + seed) % 13);
+        }
+        return vector;
+    }
+
+    // sizes around every vector width, views starting at an unaligned offset
+    static constexpr size_t sizes[]{ 0, 1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 300, 1000, 8200 };
+};
+
+using SimdTypes = testing::Types<std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t, std::uint32_t, std::int64_t, std::uint64_t, float, double>;
+TYPED_TEST_SUITE(Containers2Simd, SimdTypes);
+
+TYPED_TEST(Containers2Simd, Fill) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            Vector<T> vector = TestFixture::make(s, 0);
+            VectorView<T> view{ vector.begin() + 1, vector.end() };
+            simd::fill(view, T{ 9 }, isa);
+            ASSERT_EQ(vector[0], T{ 0 });
+            ASSERT_TRUE(std::all_of(view.begin(), view.end(), [](T x) { return x == T{ 9 }; })) << "size " << s;
+        }
+    }
+}
+
+TYPED_TEST(Containers2Simd, Sum) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            const Vector<T> vector = TestFixture::make(s, 1);
+            const VectorView<const T> view{ vector.begin() + 1, vector.end() };
+            const T expected = std::accumulate(view.begin(), view.end(), T{}, [](T a, T b) { return static_cast<T>(a + b); });
+            ASSERT_EQ(simd::sum(view, isa), expected) << "size " << s;
+        }
+    }
+}
+
+TYPED_TEST(Containers2Simd, MinMax) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            Vector<T> vector = TestFixture::make(s, 2);
+            if (s > 2) {
+                vector[s / 2] = T{ 100 };
+                vector[s - 1] = T{ 0 };
+            }
+            const VectorView<const T> view{ vector.begin() + 1, vector.end() };
+            if (s == 0) {
+                ASSERT_EQ(simd::min(view, isa), std::numeric_limits<T>::max());
+                ASSERT_EQ(simd::max(view, isa), std::numeric_limits<T>::lowest());
+                continue;
+            }
+            ASSERT_EQ(simd::min(view, isa), *std::min_element(view.begin(), view.end())) << "size " << s;
+            ASSERT_EQ(simd::max(view, isa), *std::max_element(view.begin(), view.end())) << "size " << s;
+        }
+    }
+}
+
+TYPED_TEST(Containers2Simd, Dot) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            const Vector<T> a = TestFixture::make(s, 3);
+            const Vector<T> b = TestFixture::make(s, 4);
+            const VectorView<const T> view_a{ a.begin() + 1, a.end() };
+            const VectorView<const T> view_b{ b.begin(), b.end() - 1 };
+            T expected{};
+            for (size_t i = 0; i < s; ++i) {
+                expected = static_cast<T>(expected + static_cast<T>(view_a[i] * view_b[i]));
+            }
+            ASSERT_EQ(simd::dot(view_a, view_b, isa), expected) << "size " << s;
+        }
+    }
+}
+
+TYPED_TEST(Containers2Simd, CountFind) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            const Vector<T> vector = TestFixture::make(s, 5);
+            const VectorView<const T> view{ vector.begin() + 1, vector.end() };
+            for (T value : { T{ 0 }, T{ 5 }, T{ 12 }, T{ 42 } }) {
+                ASSERT_EQ(simd::count(view, value, isa), static_cast<size_t>(std::count(view.begin(), view.end(), value))) << "size " << s;
+                ASSERT_EQ(simd::find(view, value, isa), static_cast<size_t>(std::find(view.begin(), view.end(), value) - view.begin())) << "size " << s;
+            }
+        }
+    }
+}
+
+TYPED_TEST(Containers2Simd, Compare) {
+    using T = TypeParam;
+    for (auto isa : TestFixture::isas()) {
+        for (size_t s : TestFixture::sizes) {
+            const Vector<T> a = TestFixture::make(s, 6);
+            const Vector<T> b = TestFixture::make(s, 7);
+            const VectorView<const T> view_a{ a.begin() + 1, a.end() };
+            const VectorView<const T> view_b{ b.begin(), b.end() - 1 };
+            Vector<bool> out(s, true);
+            auto check = [&](auto compare) {
+                simd::compare(view_a, view_b, out, compare, isa);
+                for (size_t i = 0; i < s; ++i) {
+                    ASSERT_EQ(out[i], compare(view_a[i], view_b[i])) << "size " << s << " index " << i;
+                }
+            };
+            check(std::equal_to<>{});
+            check(std::not_equal_to<>{});
+            check(std::less<>{});
+            check(std::less_equal<>{});
+            check(std::greater<>{});
+            check(std::greater_equal<>{});
+        }
+    }
+}
+
+TEST(Containers2, VectorAlignedMemoryResource) {
+    for (size_t s : { 1, 3, 17, 100 }) {
+        Vector<float> vector{ s, 1.0f, initialized_tag, aligned_memory_resource<cache_line_size>() };
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vector.data()) % cache_line_size, 0);
+        vector.resize(4 * s, 2.0f);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vector.data()) % cache_line_size, 0);
+        ASSERT_EQ(vector[s - 1], 1.0f);
+        ASSERT_EQ(vector[s], 2.0f);
+    }
+    static_assert(AlignedMemoryResource<64>::padded(1) == 64);
+    static_assert(AlignedMemoryResource<64>::padded(64) == 64);
+    static_assert(AlignedMemoryResource<64>::padded(65) == 128);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <Containers2/small_vector.hpp>
+#include <string>
+
+using namespace containers2;
+
+// InlineVector and SmallVector: same copy/move rules as Vector
+static_assert(!std::is_copy_constructible_v<InlineVector<int, 4>>);
+static_assert(!std::is_copy_assignable_v<InlineVector<int, 4>>);
+static_assert(!std::is_constructible_v<InlineVector<int, 4>, const VectorView<int>&>);
+static_assert(!std::is_assignable_v<InlineVector<int, 4>&, const VectorView<const int>&>);
+static_assert(std::is_nothrow_move_constructible_v<InlineVector<int, 4>>);
+static_assert(std::is_constructible_v<InlineVector<const int, 4>, InlineVector<int, 4>&&>);
+static_assert(!std::is_constructible_v<InlineVector<int, 4>, InlineVector<const int, 4>&&>);
+static_assert(!std::is_copy_constructible_v<SmallVector<int, 4>>);
+static_assert(!std::is_copy_assignable_v<SmallVector<int, 4>>);
+static_assert(!std::is_constructible_v<SmallVector<int, 4>, const VectorView<int>&>);
+static_assert(std::is_nothrow_move_constructible_v<SmallVector<int, 4>>);
+static_assert(std::is_constructible_v<SmallVector<const int, 4>, SmallVector<int, 4>&&>);
+static_assert(!std::is_constructible_v<SmallVector<int, 4>, SmallVector<const int, 4>&&>);
+static_assert(std::is_constructible_v<SmallVector<int, 4>, Vector<int>&&>);
+// both are views; views cannot be built from their temporaries
+static_assert(std::is_trivially_constructible_v<VectorView<const int>, const InlineVector<int, 4>&>);
+static_assert(std::is_trivially_constructible_v<VectorView<int>, const SmallVector<int, 4>&>);
+static_assert(!std::is_constructible_v<VectorView<int>, const SmallVector<const int, 4>&>);
+static_assert(!std::is_constructible_v<VectorView<const int>, InlineVector<int, 4>&&>);
+static_assert(!std::is_constructible_v<VectorView<const int>, SmallVector<int, 4>&&>);
+
+static int sum(VectorView<const int> view)
+{
+    int result = 0;
+    for (int x : view) {
+        result += x;
+    }
+    return result;
+}
+
+TEST(Containers2, InlineVectorConstruction) {
+    const InlineVector<int, 8> list{ 5, 7, 12 };
+    ASSERT_EQ(list.size(), 3);
+    ASSERT_EQ(list.capacity(), 8);
+    ASSERT_EQ(list[2], 12);
+    ASSERT_EQ(sum(list), 24);
+    ASSERT_GE(static_cast<const void*>(list.data()), static_cast<const void*>(&list));
+    ASSERT_LT(static_cast<const void*>(list.data()), static_cast<const void*>(&list + 1));
+
+    const InlineVector<int, 8> initialized(4, 42, initialized_tag);
+    ASSERT_EQ(initialized.size(), 4);
+    ASSERT_EQ(initialized[3], 42);
+
+    ASSERT_THROW((InlineVector<int, 2>(3, uninitialized_tag)), std::length_error);
+}
+
+TEST(Containers2, InlineVectorResize) {
+    InlineVector<int, 8> vector{ 5, 7, 12 };
+    vector.resize(5, 24);
+    ASSERT_EQ(vector.size(), 5);
+    ASSERT_EQ(vector[2], 12);
+    ASSERT_EQ(vector[4], 24);
+    vector.resize(2);
+    ASSERT_EQ(vector.size(), 2);
+    ASSERT_EQ(vector[1], 7);
+    vector.resize(4, 87, non_preserving_initialized_tag);
+    ASSERT_EQ(vector[0], 87);
+    ASSERT_EQ(vector[3], 87);
+    vector.resize(8, non_preserving_uninitialized_tag);
+    ASSERT_EQ(vector.size(), 8);
+    ASSERT_THROW(vector.resize(9), std::length_error);
+    ASSERT_EQ(vector.size(), 8);
+}
+
+TEST(Containers2, InlineVectorMove) {
+    InlineVector<std::string, 4> moved_from{ "a", "b" };
+    InlineVector<std::string, 4> moved_to{ std::move(moved_from) };
+    ASSERT_EQ(moved_from.size(), 0);
+    ASSERT_EQ(moved_to.size(), 2);
+    ASSERT_EQ(moved_to[1], "b");
+    ASSERT_EQ(moved_to.data(), moved_to.storage_.data());
+
+    InlineVector<const std::string, 4> moved_to_const{};
+    moved_to_const = std::move(moved_to);
+    ASSERT_EQ(moved_to_const.size(), 2);
+    ASSERT_EQ(moved_to_const[0], "a");
+    ASSERT_EQ(moved_to.size(), 0);
+}
+
+TEST(Containers2, SmallVectorInline) {
+    SmallVector<int, 4> vector{ 5, 7, 12 };
+    ASSERT_TRUE(vector.is_inline());
+    ASSERT_EQ(vector.capacity(), 4);
+    ASSERT_EQ(sum(vector), 24);
+    vector.resize(4, 1);
+    ASSERT_TRUE(vector.is_inline());
+    ASSERT_EQ(vector[3], 1);
+    vector.resize(1);
+    ASSERT_EQ(vector.size(), 1);
+    ASSERT_EQ(vector[0], 5);
+}
+
+TEST(Containers2, SmallVectorSpill) {
+    SmallVector<int, 4> vector{ 5, 7, 12 };
+    vector.resize(6, 24); // spills, preserving
+    ASSERT_FALSE(vector.is_inline());
+    ASSERT_EQ(vector.size(), 6);
+    ASSERT_EQ(vector.capacity(), 8);
+    ASSERT_EQ(vector[2], 12);
+    ASSERT_EQ(vector[5], 24);
+    const int* heap = vector.data();
+    vector.resize(8, 36); // within the heap capacity
+    ASSERT_EQ(vector.data(), heap);
+    ASSERT_EQ(sum(vector), 5 + 7 + 12 + 3 * 24 + 2 * 36);
+
+    vector.resize(3);
+    vector.shrink_to_fit(); // back inline
+    ASSERT_TRUE(vector.is_inline());
+    ASSERT_EQ(vector.size(), 3);
+    ASSERT_EQ(vector[2], 12);
+
+    vector.resize(100, 9, non_preserving_initialized_tag);
+    ASSERT_FALSE(vector.is_inline());
+    ASSERT_EQ(vector.capacity(), 100);
+    ASSERT_EQ(vector[0], 9);
+    ASSERT_EQ(vector[99], 9);
+
+    SmallVector<std::string, 2> strings(3, std::string{ "a string long enough not to fit in the small string buffer" });
+    ASSERT_FALSE(strings.is_inline());
+    strings.resize(1);
+    strings.shrink_to_fit();
+    ASSERT_TRUE(strings.is_inline());
+    ASSERT_EQ(strings[0], "a string long enough not to fit in the small string buffer");
+}
+
+TEST(Containers2, SmallVectorMove) {
+    // inline -> inline relocates the elements
+    SmallVector<int, 4> inline_vector{ 1, 2 };
+    SmallVector<int, 4> moved_inline{ std::move(inline_vector) };
+    ASSERT_TRUE(moved_inline.is_inline());
+    ASSERT_EQ(moved_inline.data(), moved_inline.inline_.data());
+    ASSERT_EQ(moved_inline[1], 2);
+    ASSERT_EQ(inline_vector.size(), 0);
+
+    // heap -> heap hands the buffer over
+    SmallVector<int, 4> heap_vector(10, 3);
+    const int* heap = heap_vector.data();
+    SmallVector<const int, 4> moved_heap{};
+    moved_heap = std::move(heap_vector);
+    ASSERT_EQ(moved_heap.data(), heap);
+    ASSERT_EQ(moved_heap.size(), 10);
+    ASSERT_TRUE(heap_vector.is_inline());
+    ASSERT_EQ(heap_vector.size(), 0);
+
+    // heap -> inline destination drops back to inline when rhs is inline
+    SmallVector<int, 4> destination(10, 3);
+    destination = std::move(moved_inline);
+    ASSERT_TRUE(destination.is_inline());
+    ASSERT_EQ(destination[0], 1);
+
+    // Vector <-> SmallVector never reallocate heap buffers
+    Vector<int> vector{ 1, 2, 3, 4, 5 };
+    const int* buffer = vector.data();
+    SmallVector<int, 4> adopted{ std::move(vector) };
+    ASSERT_EQ(adopted.data(), buffer);
+    ASSERT_EQ(adopted.size(), 5);
+    Vector<int> released = std::move(adopted).release();
+    ASSERT_EQ(released.data(), buffer);
+    ASSERT_EQ(adopted.size(), 0);
+
+    SmallVector<int, 4> small_inline{ 4, 5 };
+    Vector<int> released_inline = std::move(small_inline).release();
+    ASSERT_EQ(released_inline.size(), 2);
+    ASSERT_EQ(released_inline[1], 5);
+}
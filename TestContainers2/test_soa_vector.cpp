@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <Containers2/soa_vector.hpp>
+#include <cstdint>
+#include <string>
+
+using namespace containers2;
+
+// SoAVector: same copy/move rules as Vector
+static_assert(!std::is_copy_constructible_v<SoAVector<float, int>>);
+static_assert(!std::is_copy_assignable_v<SoAVector<float, int>>);
+static_assert(std::is_nothrow_move_constructible_v<SoAVector<float, int>>);
+static_assert(std::is_nothrow_move_assignable_v<SoAVector<float, int>>);
+static_assert(std::is_constructible_v<SoAVector<const float, int>, SoAVector<float, int>&&>);
+static_assert(std::is_constructible_v<SoAVector<const float, const int>, SoAVector<float, int>&&>);
+static_assert(!std::is_constructible_v<SoAVector<float, int>, SoAVector<const float, int>&&>);
+// columns are views with the constness of their field
+static_assert(std::is_same_v<decltype(std::declval<const SoAVector<float, int>&>().column<0>()), VectorView<float>>);
+static_assert(std::is_same_v<decltype(std::declval<SoAVector<const float, int>&>().column<0>()), VectorView<const float>>);
+static_assert(std::is_same_v<decltype(std::declval<SoAVector<const float, int>&>().column<1>()), VectorView<int>>);
+
+TEST(Containers2, SoAVectorConstruction) {
+    SoAVector<float, std::int32_t, double> particles{ 100, std::tuple{ 1.0f, 2, 3.0 } };
+    ASSERT_EQ(particles.size(), 100);
+    ASSERT_EQ(particles.capacity(), 100);
+
+    const VectorView<float> x = particles.column<0>();
+    const VectorView<std::int32_t> id = particles.column<1>();
+    const VectorView<double> mass = particles.column<2>();
+    ASSERT_EQ(x.size(), 100);
+    ASSERT_EQ(x[99], 1.0f);
+    ASSERT_EQ(id[0], 2);
+    ASSERT_EQ(mass[50], 3.0);
+
+    // every column starts on its own cache line
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(x.data()) % cache_line_size, 0);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(id.data()) % cache_line_size, 0);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mass.data()) % cache_line_size, 0);
+    ASSERT_GE(reinterpret_cast<const std::byte*>(id.data()), reinterpret_cast<const std::byte*>(x.data() + 100));
+
+    auto [row_x, row_id, row_mass] = particles[7];
+    row_x = 5.0f;
+    row_id = 9;
+    ASSERT_EQ(x[7], 5.0f);
+    ASSERT_EQ(id[7], 9);
+    ASSERT_EQ(row_mass, 3.0);
+
+    auto [view_x, view_id, view_mass] = particles.columns();
+    ASSERT_EQ(view_x.data(), x.data());
+    ASSERT_EQ(view_mass.size(), 100);
+}
+
+TEST(Containers2, SoAVectorResize) {
+    SoAVector<int, std::string> records{ 3, std::tuple{ 5, std::string{ "a" } } };
+    records.resize(5, std::tuple{ 24, std::string{ "b" } }); // grow initialized
+    ASSERT_EQ(records.size(), 5);
+    ASSERT_EQ(records.capacity(), 6);
+    ASSERT_EQ(records.column<0>()[2], 5);
+    ASSERT_EQ(records.column<0>()[4], 24);
+    ASSERT_EQ(records.column<1>()[2], "a");
+    ASSERT_EQ(records.column<1>()[4], "b");
+
+    const int* keys = records.column<0>().data();
+    records.resize(2); // shrink never reallocates
+    ASSERT_EQ(records.size(), 2);
+    ASSERT_EQ(records.column<0>().data(), keys);
+    records.resize(6); // grow uninitialized within capacity
+    ASSERT_EQ(records.column<0>().data(), keys);
+    ASSERT_EQ(records.column<1>()[1], "a");
+
+    records.resize(4, std::tuple{ 87, std::string{ "c" } }, non_preserving_initialized_tag);
+    ASSERT_EQ(records.column<0>()[0], 87);
+    ASSERT_EQ(records.column<1>()[3], "c");
+    records.resize(76, non_preserving_uninitialized_tag);
+    ASSERT_EQ(records.size(), 76);
+    ASSERT_EQ(records.capacity(), 76);
+
+    records.resize(3);
+    records.shrink_to_fit();
+    ASSERT_EQ(records.capacity(), 3);
+    records.reserve(10);
+    ASSERT_EQ(records.capacity(), 10);
+    ASSERT_EQ(records.size(), 3);
+}
+
+TEST(Containers2, SoAVectorMove) {
+    SoAVector<float, int> moved_from{ 4, std::tuple{ 1.0f, 2 } };
+    const float* x = moved_from.column<0>().data();
+    SoAVector<float, int> moved_to{ std::move(moved_from) };
+    ASSERT_EQ(moved_from.size(), 0);
+    ASSERT_EQ(moved_to.column<0>().data(), x);
+
+    SoAVector<const float, int> moved_to_const{};
+    moved_to_const = std::move(moved_to);
+    ASSERT_EQ(moved_to_const.size(), 4);
+    const VectorView<const float> const_x = moved_to_const.column<0>();
+    ASSERT_EQ(const_x[3], 1.0f);
+    moved_to_const.column<1>()[3] = 7;
+    ASSERT_EQ(moved_to_const.column<1>()[3], 7);
+
+    SoAVector<const float, const int> all_const{ 2, std::tuple{ 3.0f, 4 } };
+    ASSERT_EQ(all_const.column<1>()[1], 4);
+}
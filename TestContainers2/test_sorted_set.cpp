@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <Containers2/sorted_set.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace containers2;
+
+// SortedSet and SortedMap: same copy/move rules as Vector, clone() is the copy
+static_assert(!std::is_copy_constructible_v<SortedSet<int>>);
+static_assert(!std::is_copy_assignable_v<SortedSet<int>>);
+static_assert(std::is_nothrow_move_constructible_v<SortedSet<int>>);
+static_assert(std::is_nothrow_move_assignable_v<SortedSet<int>>);
+static_assert(!std::is_copy_constructible_v<SortedMap<int, int>>);
+static_assert(std::is_nothrow_move_constructible_v<SortedMap<int, int>>);
+static_assert(std::is_nothrow_move_assignable_v<SortedMap<int, int>>);
+
+// built from a Vector by move only
+static_assert(std::is_constructible_v<SortedSet<int>, Vector<int>&&>);
+static_assert(!std::is_constructible_v<SortedSet<int>, Vector<int>&>);
+static_assert(!std::is_constructible_v<VectorView<const int>, SortedSet<int>&&>);
+
+// a B+ tree node fills a cache line
+static_assert(SortedSet<std::uint32_t>::node_keys == 16);
+static_assert(SortedSet<std::uint64_t>::node_keys == 8);
+static_assert(SortedSet<std::string>::node_keys == 4);
+
+namespace {
+    constexpr SortedLayout layouts[]{ SortedLayout::sorted, SortedLayout::eytzinger, SortedLayout::btree };
+
+    Vector<std::uint32_t> random_keys(size_t n, std::uint32_t bound, unsigned seed)
+    {
+        std::mt19937 random{ seed };
+        Vector<std::uint32_t> keys(n, uninitialized_tag);
+        for (auto& key : keys) {
+            key = random() % bound;
+        }
+        return keys;
+    }
+}
+
+TEST(Containers2, SortedSetBuild) {
+    Vector<int> keys{ 5, 3, 9, 3, 1, 9, 7 };
+    const int* buffer = keys.data();
+    const SortedSet<int> set{ std::move(keys) };
+    ASSERT_EQ(keys.size(), 0);
+    ASSERT_EQ(set.begin(), buffer); // sorted and deduplicated in place
+    ASSERT_EQ(set.size(), 5);
+    ASSERT_TRUE(std::equal(set.begin(), set.end(), std::begin({ 1, 3, 5, 7, 9 })));
+    ASSERT_EQ(set.layout(), SortedLayout::sorted);
+    ASSERT_EQ(set[2], 5);
+
+    const SortedSet<int> empty{ Vector<int>{}, SortedLayout::btree };
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.lower_bound(1), 0);
+    ASSERT_FALSE(empty.contains(1));
+
+    // descending order through the comparison
+    const SortedSet<int, std::greater<int>> descending{ Vector<int>{ 1, 4, 2, 4 }, SortedLayout::eytzinger };
+    ASSERT_TRUE(std::equal(descending.begin(), descending.end(), std::begin({ 4, 2, 1 })));
+    ASSERT_EQ(descending.lower_bound(3), 1);
+    ASSERT_EQ(descending.find(1), 2);
+    ASSERT_EQ(descending.find(3), 3);
+}
+
+TEST(Containers2, SortedSetLayouts) {
+    // sizes around the node and tree boundaries of every layout
+    for (size_t n : { 1, 2, 3, 7, 8, 15, 16, 17, 255, 256, 272, 273, 4913, 10000, 100000 }) {
+        const Vector<std::uint32_t> source = random_keys(n, 4 * static_cast<std::uint32_t>(n), static_cast<unsigned>(n));
+        std::vector<std::uint32_t> expected(source.begin(), source.end());
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+        for (SortedLayout layout : layouts) {
+            Vector<std::uint32_t> keys(n, uninitialized_tag);
+            std::copy(source.begin(), source.end(), keys.begin());
+            const SortedSet<std::uint32_t> set{ std::move(keys), layout };
+            ASSERT_EQ(set.size(), expected.size());
+            ASSERT_TRUE(std::equal(set.begin(), set.end(), expected.begin()));
+
+            // every value from below the smallest key to past the largest one
+            const std::uint32_t queries = 4 * static_cast<std::uint32_t>(n) + 2;
+            Vector<std::uint32_t> batch(queries, uninitialized_tag);
+            for (std::uint32_t q = 0; q < queries; ++q) {
+                batch[q] = q;
+                const size_t rank = static_cast<size_t>(std::lower_bound(expected.begin(), expected.end(), q) - expected.begin());
+                ASSERT_EQ(set.lower_bound(q), rank) << "n " << n << " layout " << static_cast<int>(layout) << " query " << q;
+                ASSERT_EQ(set.contains(q), rank != expected.size() && expected[rank] == q);
+            }
+            Vector<size_t> ranks(queries, uninitialized_tag);
+            set.lower_bound(batch, ranks);
+            Vector<size_t> found(queries, uninitialized_tag);
+            set.find(batch, found);
+            for (std::uint32_t q = 0; q < queries; ++q) {
+                ASSERT_EQ(ranks[q], set.lower_bound(q));
+                ASSERT_EQ(found[q], set.find(q));
+            }
+        }
+    }
+}
+
+TEST(Containers2, SortedSetStrings) {
+    Vector<std::string> words{ "pear", "apple", "fig", "kiwi", "apple", "plum", "date", "lime", "nut", "yuzu" };
+    for (SortedLayout layout : layouts) {
+        Vector<std::string> keys(words.size(), uninitialized_tag);
+        std::copy(words.begin(), words.end(), keys.begin());
+        const SortedSet<std::string> set{ std::move(keys), layout };
+        ASSERT_EQ(set.size(), 9);
+        ASSERT_EQ(set.find("apple"), 0);
+        ASSERT_EQ(set.find("yuzu"), 8);
+        ASSERT_EQ(set.lower_bound("b"), 1);
+        ASSERT_EQ(set.lower_bound("z"), 9);
+        ASSERT_FALSE(set.contains("grape"));
+
+        const SortedSet<std::string> copy = set.clone();
+        ASSERT_NE(copy.begin(), set.begin());
+        ASSERT_EQ(copy.layout(), layout);
+        ASSERT_EQ(copy.find("lime"), set.find("lime"));
+    }
+}
+
+TEST(Containers2, SortedMapFind) {
+    for (SortedLayout layout : layouts) {
+        Vector<int> keys{ 30, 10, 20, 10, 40 };
+        Vector<std::string> values{ "thirty", "ten", "twenty", "TEN", "forty" };
+        const SortedMap<int, std::string> map{ std::move(keys), std::move(values), layout };
+        ASSERT_EQ(map.size(), 4);
+        ASSERT_EQ(map.layout(), layout);
+        ASSERT_EQ(*map.find(10), "ten"); // the first of equal keys wins
+        ASSERT_EQ(*map.find(40), "forty");
+        ASSERT_EQ(map.find(25), nullptr);
+        ASSERT_EQ(map.lower_bound(25), 2);
+        ASSERT_EQ(map.values()[map.lower_bound(25)], "thirty");
+
+        Vector<int> queries{ 5, 10, 15, 20, 30, 40, 50 };
+        Vector<const std::string*> found(queries.size(), uninitialized_tag);
+        map.find(queries, found);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            ASSERT_EQ(found[i], map.find(queries[i]));
+        }
+
+        const SortedMap<int, std::string> copy = map.clone();
+        ASSERT_EQ(*copy.find(20), "twenty");
+        ASSERT_NE(copy.find(20), map.find(20));
+    }
+
+    // already sorted input is taken as is
+    Vector<std::uint64_t> keys{ 1, 2, 3 };
+    Vector<double> values{ 0.5, 1.5, 2.5 };
+    const double* buffer = values.data();
+    const SortedMap<std::uint64_t, double> sorted{ std::move(keys), std::move(values), sorted_unique_tag, SortedLayout::btree };
+    ASSERT_EQ(sorted.find(2), buffer + 1);
+
+    // a value for every key, no more, no less
+    for (size_t n : { size_t{ 2 }, size_t{ 4 } }) {
+        ASSERT_THROW((SortedMap<int, int>{ Vector<int>{ 3, 1, 2 }, Vector<int>(n, 0, initialized_tag) }), std::invalid_argument);
+        ASSERT_THROW((SortedMap<int, int>{ Vector<int>{ 1, 2, 3 }, Vector<int>(n, 0, initialized_tag), sorted_unique_tag }), std::invalid_argument);
+    }
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <Containers2/vector_of_vectors.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace containers2;
+
+// VectorOfVectors: same copy/move rules as Vector, clone() is the copy
+static_assert(!std::is_copy_constructible_v<VectorOfVectors<int>>);
+static_assert(!std::is_copy_assignable_v<VectorOfVectors<int>>);
+static_assert(std::is_nothrow_move_constructible_v<VectorOfVectors<int>>);
+static_assert(std::is_nothrow_move_assignable_v<VectorOfVectors<int>>);
+
+// rows are views with the constness of the elements
+static_assert(std::is_same_v<decltype(std::declval<const VectorOfVectors<int>&>()[0]), VectorView<int>>);
+static_assert(std::is_same_v<decltype(std::declval<const VectorOfVectors<const int>&>()[0]), VectorView<const int>>);
+static_assert(std::is_nothrow_constructible_v<VectorOfVectors<const int>, VectorOfVectors<int>&&>);
+static_assert(!std::is_constructible_v<VectorOfVectors<int>, VectorOfVectors<const int>&&>);
+
+namespace {
+    template<typename T>
+    void expect_rows(const VectorOfVectors<T>& jagged, const std::vector<std::vector<int>>& expected)
+    {
+        ASSERT_EQ(jagged.size(), expected.size());
+        size_t elements = 0;
+        for (size_t r = 0; r < expected.size(); ++r) {
+            ASSERT_EQ(jagged.row_size(r), expected[r].size()) << "row " << r;
+            ASSERT_TRUE(std::equal(jagged[r].begin(), jagged[r].end(), expected[r].begin(), expected[r].end())) << "row " << r;
+            elements += expected[r].size();
+        }
+        ASSERT_EQ(jagged.element_count(), elements);
+    }
+}
+
+TEST(Containers2, VectorOfVectorsAppend) {
+    VectorOfVectors<int> jagged;
+    ASSERT_TRUE(jagged.empty());
+    ASSERT_EQ(jagged.offsets().size(), 0);
+    ASSERT_THROW(jagged.push_back_to_last(0), std::out_of_range);
+    ASSERT_EQ(jagged.element_count(), 0);
+
+    const Vector<int> first{ 1, 2, 3 };
+    jagged.push_back(first);
+    jagged.push_back(VectorView<const int>{});
+    const VectorView<int> filled = jagged.push_back(2, uninitialized_tag);
+    filled[0] = 4;
+    filled[1] = 5;
+    jagged.push_back_to_last(6);
+    jagged.push_back(0, uninitialized_tag);
+    for (int i = 7; i < 1000; ++i) {
+        jagged.push_back_to_last(i);
+    }
+    std::vector<int> last(993);
+    std::iota(last.begin(), last.end(), 7);
+    expect_rows(jagged, { { 1, 2, 3 }, {}, { 4, 5, 6 }, last });
+
+    // one buffer: the rows follow each other
+    ASSERT_EQ(jagged[2].data(), jagged[0].data() + 3);
+    ASSERT_EQ(jagged.values()[3], 4);
+    ASSERT_EQ(jagged.offsets()[4], jagged.element_count());
+
+    jagged.clear();
+    ASSERT_TRUE(jagged.empty());
+    ASSERT_EQ(jagged.element_count(), 0);
+    ASSERT_THROW(jagged.push_back_to_last(0), std::out_of_range);
+    jagged.reserve(10, 100);
+    jagged.push_back(first);
+    expect_rows(jagged, { { 1, 2, 3 } });
+}
+
+TEST(Containers2, VectorOfVectorsCloneAndFreeze) {
+    VectorOfVectors<int> jagged;
+    const Vector<int> row{ 1, 2 };
+    jagged.push_back(row);
+    jagged.push_back(row);
+    VectorOfVectors<int> copy = jagged.clone();
+    copy[1][0] = 7;
+    expect_rows(jagged, { { 1, 2 }, { 1, 2 } });
+    expect_rows(copy, { { 1, 2 }, { 7, 2 } });
+
+    const VectorOfVectors<const int> frozen{ std::move(copy) };
+    ASSERT_TRUE(copy.empty());
+    expect_rows(frozen, { { 1, 2 }, { 7, 2 } });
+    const VectorOfVectors<const int> frozen_copy = frozen.clone();
+    ASSERT_NE(frozen_copy[0].data(), frozen[0].data());
+    expect_rows(frozen_copy, { { 1, 2 }, { 7, 2 } });
+}
+
+TEST(Containers2, VectorOfVectorsAdopt) {
+    expect_rows(VectorOfVectors<int>{ Vector<int>{ 1, 2, 3 }, Vector<size_t>{ 0, 2, 2, 3 } }, { { 1, 2 }, {}, { 3 } });
+    expect_rows(VectorOfVectors<int>{ Vector<int>{}, Vector<size_t>{} }, {});
+    expect_rows(VectorOfVectors<int>{ Vector<int>{}, Vector<size_t>{ 0, 0 } }, { {} });
+    ASSERT_THROW((VectorOfVectors<int>{ Vector<int>{ 1 }, Vector<size_t>{} }), std::invalid_argument);
+    ASSERT_THROW((VectorOfVectors<int>{ Vector<int>{ 1, 2 }, Vector<size_t>{ 1, 2 } }), std::invalid_argument);
+    ASSERT_THROW((VectorOfVectors<int>{ Vector<int>{ 1, 2 }, Vector<size_t>{ 0, 1 } }), std::invalid_argument);
+    ASSERT_THROW((VectorOfVectors<int>{ Vector<int>{ 1, 2 }, Vector<size_t>{ 0, 2, 1, 2 } }), std::invalid_argument);
+}
+
+// counting sort: stable within a row, empty rows included
+TEST(Containers2, VectorOfVectorsGroup) {
+    const Vector<size_t> rows_of{ 3, 0, 3, 1, 0, 3 };
+    const Vector<int> values{ 10, 11, 12, 13, 14, 15 };
+    expect_rows(VectorOfVectors<int>{ 5, rows_of, values }, { { 11, 14 }, { 13 }, {}, { 10, 12, 15 }, {} });
+
+    const Vector<std::pair<size_t, int>> pairs{ { 1, 5 }, { 1, 6 }, { 0, 7 } };
+    expect_rows(VectorOfVectors<const int>{ 2, pairs }, { { 7 }, { 5, 6 } });
+    expect_rows(VectorOfVectors<int>{ 3, VectorView<const std::pair<size_t, int>>{} }, { {}, {}, {} });
+
+    ASSERT_THROW((VectorOfVectors<int>{ 3, rows_of, values }), std::out_of_range);
+    const Vector<int> fewer{ 1, 2 };
+    ASSERT_THROW((VectorOfVectors<int>{ 5, rows_of, fewer }), std::invalid_argument);
+
+    // a random graph as an adjacency list
+    std::mt19937 random{ 42 };
+    constexpr size_t vertices = 1000;
+    Vector<std::pair<size_t, int>> edges(20000, uninitialized_tag);
+    std::vector<std::vector<int>> expected(vertices);
+    for (auto& [source, target] : edges) {
+        source = random() % vertices;
+        target = static_cast<int>(random() % vertices);
+        expected[source].push_back(target);
+    }
+    expect_rows(VectorOfVectors<int>{ vertices, edges }, expected);
+}
+
+// every row once, with skewed row sizes
+TEST(Containers2, VectorOfVectorsParallel) {
+    ThreadPool pool{ 4 };
+    VectorOfVectors<std::int64_t> jagged;
+    for (size_t r = 0; r < 5000; ++r) {
+        const VectorView<std::int64_t> row = jagged.push_back(r % 100 == 0 ? 10000 : r % 7, uninitialized_tag);
+        std::fill(row.begin(), row.end(), static_cast<std::int64_t>(r));
+    }
+    Vector<std::int64_t> sums(jagged.size(), std::int64_t{ -1 });
+    std::atomic<size_t> calls{ 0 };
+    parallel::for_each_row(jagged, [&](size_t r, VectorView<std::int64_t> row) {
+        sums[r] = std::accumulate(row.begin(), row.end(), std::int64_t{ 0 });
+        calls.fetch_add(1, std::memory_order_relaxed);
+    }, pool);
+    ASSERT_EQ(calls.load(), jagged.size());
+    for (size_t r = 0; r < jagged.size(); ++r) {
+        ASSERT_EQ(sums[r], static_cast<std::int64_t>(r * jagged.row_size(r))) << "row " << r;
+    }
+
+    // nothing to do, or one row only
+    parallel::for_each_row(VectorOfVectors<int>{}, [](size_t, VectorView<int>) { FAIL(); }, pool);
+    const VectorOfVectors<int> single{ Vector<int>{ 1, 2 }, Vector<size_t>{ 0, 2 } };
+    calls = 0;
+    parallel::for_each_row(single, [&](size_t r, VectorView<int> row) { ASSERT_EQ(r, 0); ASSERT_EQ(row.size(), 2); ++calls; }, pool);
+    ASSERT_EQ(calls.load(), 1);
+}